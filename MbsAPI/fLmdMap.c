@@ -0,0 +1,402 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "fLmd.h"
+#include "fLmdMap.h"
+#include "f_evt.h"
+
+uint32_t fLmdMapIndexFromTable(sLmdMapControl*);
+uint32_t fLmdMapIndexFromTagFile(sLmdMapControl*, char*);
+uint32_t fLmdMapIndexFromElements(sLmdMapControl*);
+uint32_t fLmdMapElementWords(sLmdMapControl*, lmdoff_t);
+void     fLmdMapCleanup(sLmdMapControl*);
+
+//===============================================================
+sLmdMapControl* fLmdMapAllocateControl()
+{
+  sLmdMapControl* x;
+  x=(sLmdMapControl*)malloc(sizeof(sLmdMapControl));
+  memset(x,0,sizeof(sLmdMapControl));
+  x->iFile=-1;
+  return(x);
+}
+//===============================================================
+uint32_t fLmdMapOpen(
+  sLmdMapControl* pMap,
+  char*    Filename,
+  char*    TagFile)          // NULL or tag file to take the index from
+{
+  struct stat fileStat;
+  uint32_t iReturn;
+  int prot;
+
+  fLmdMapClose(pMap);
+  strncpy(pMap->cFile,Filename,sizeof(pMap->cFile)-1);
+
+  if((pMap->iFile=open(Filename,O_RDONLY)) == -1) {
+    printf("fLmdMapOpen: File not found: %s\n",Filename);
+    return(GETLMD__NOFILE);
+  }
+  if((fstat(pMap->iFile,&fileStat) != 0) || (fileStat.st_size < (off_t)sizeof(sMbsFileHeader))) {
+    printf("fLmdMapOpen: LMD format error: no LMD file: %s\n",Filename);
+    fLmdMapClose(pMap);
+    return(GETLMD__NOLMDFILE);
+  }
+  pMap->iMapBytes=(lmdoff_t)fileStat.st_size;
+
+  // check type and endian on the header
+  if(pread(pMap->iFile,&pMap->sFileHeader,sizeof(sMbsFileHeader),0) != sizeof(sMbsFileHeader)) {
+    printf("fLmdMapOpen: LMD format error: no LMD file: %s\n",Filename);
+    fLmdMapClose(pMap);
+    return(GETLMD__NOLMDFILE);
+  }
+  if(pMap->sFileHeader.iEndian != 1) { pMap->iSwap=1; }
+  if(pMap->iSwap) {
+    fLmdSwap4((uint32_t*)&pMap->sFileHeader,sizeof(sMbsFileHeader)/4);
+    fLmdSwap8((uint64_t*)&pMap->sFileHeader.iTableOffset,1);
+  }
+  if(pMap->sFileHeader.iType != LMD__TYPE_FILE_HEADER_101_1) {
+    printf("fLmdMapOpen: LMD format error: no LMD file: %s, type is %0x\n",
+           Filename,pMap->sFileHeader.iType);
+    fLmdMapClose(pMap);
+    return(GETLMD__NOLMDFILE);
+  }
+
+  // swapped files are swapped in place in a private copy of the pages
+  prot = pMap->iSwap ? PROT_READ|PROT_WRITE : PROT_READ;
+  pMap->pMap=(char*)mmap(NULL,pMap->iMapBytes,prot,MAP_PRIVATE,pMap->iFile,0);
+  if(pMap->pMap == MAP_FAILED) {
+    printf("fLmdMapOpen: cannot map file: %s\n",Filename);
+    pMap->pMap=NULL;
+    fLmdMapClose(pMap);
+    return(LMD__FAILURE);
+  }
+  madvise(pMap->pMap,pMap->iMapBytes,MADV_SEQUENTIAL);
+
+  iReturn=GETLMD__NOFILE;
+  if((TagFile != NULL) && (*TagFile != 0)) { iReturn=fLmdMapIndexFromTagFile(pMap,TagFile); }
+  if((iReturn != LMD__SUCCESS) && (pMap->sFileHeader.iTableOffset > 0)) { iReturn=fLmdMapIndexFromTable(pMap); }
+  if(iReturn != LMD__SUCCESS) { iReturn=fLmdMapIndexFromElements(pMap); }
+  if(iReturn != LMD__SUCCESS) {
+    fLmdMapClose(pMap);
+    return(iReturn);
+  }
+
+  if(pMap->iSwap) {
+    pMap->pSwapped=(uint8_t*)malloc(pMap->iElements+1);
+    memset(pMap->pSwapped,0,pMap->iElements+1);
+  }
+  pMap->iCurrent=0;
+  pMap->iEnd=pMap->iElements;
+  if(pMap->iVerbose) { printf("fLmdMapOpen: %s elements %llu\n",Filename,(unsigned long long)pMap->iElements); }
+  return(LMD__SUCCESS);
+}
+//===============================================================
+// size in 16 bit words of the element at byte offset, 0 if it does not fit into the file
+uint32_t fLmdMapElementWords(sLmdMapControl* pMap, lmdoff_t offset)
+{
+  sMbsHeader header;
+  lmdoff_t bytes;
+
+  if(offset+sizeof(sMbsHeader) > pMap->iMapBytes) { return(0); }
+  memcpy(&header,pMap->pMap+offset,sizeof(sMbsHeader));
+  if(pMap->iSwap) { fLmdSwap4((uint32_t*)&header,2); }
+  if(header.iType == LMD__TYPE_FILE_INDEX_101_2) { return(0); }
+  bytes=((lmdoff_t)header.iWords+4)*2;
+  if(offset+bytes > pMap->iMapBytes) { return(0); }
+  return(header.iWords+4);
+}
+//===============================================================
+uint32_t fLmdMapIndexFromElements(sLmdMapControl* pMap)
+{
+  lmdoff_t offset;
+  uint64_t entries=0,maxElements;
+  uint32_t words;
+
+  maxElements=pMap->sFileHeader.iElements;
+  offset=sizeof(sMbsFileHeader)+(lmdoff_t)pMap->sFileHeader.iUsedWords*2;
+  while((maxElements == 0) || (pMap->iElements < maxElements)) {
+    words=fLmdMapElementWords(pMap,offset);
+    if(words == 0) { break; }
+    if(pMap->iElements+1 >= entries) {
+      entries=entries ? entries*2 : 65536;
+      pMap->pOffset=(lmdoff_t*)realloc(pMap->pOffset,entries*sizeof(lmdoff_t));
+    }
+    pMap->pOffset[pMap->iElements++]=offset;
+    offset+=(lmdoff_t)words*2;
+  }
+  if(pMap->pOffset == NULL) { pMap->pOffset=(lmdoff_t*)malloc(sizeof(lmdoff_t)); }
+  pMap->pOffset[pMap->iElements]=offset;
+  if((maxElements > 0) && (pMap->iElements < maxElements)) {
+    printf("fLmdMapOpen: %s truncated, %llu of %llu elements found\n",pMap->cFile,
+           (unsigned long long)pMap->iElements,(unsigned long long)maxElements);
+  }
+  return(LMD__SUCCESS);
+}
+//===============================================================
+uint32_t fLmdMapIndexFromTable(sLmdMapControl* pMap)
+{
+  sMbsHeader tableHead;
+  lmdoff_t tableOffset,tableBytes,value;
+  uint64_t i,entries;
+  uint32_t offsetSize,words;
+  uint32_t iReturn=LMD__SUCCESS;
+  char* table;
+
+  offsetSize=pMap->sFileHeader.iOffsetSize;
+  entries=(uint64_t)pMap->sFileHeader.iElements+1;
+  tableBytes=entries*offsetSize;
+  if(((offsetSize != 4) && (offsetSize != 8)) || (pMap->sFileHeader.iTableOffset > pMap->iMapBytes/4) ||
+     (pMap->sFileHeader.iTableOffset*4+16+tableBytes > pMap->iMapBytes)) {
+    printf("fLmdMapOpen: Index format error: %s\n",pMap->cFile);
+    return(GETLMD__NOLMDFILE);
+  }
+  tableOffset=pMap->sFileHeader.iTableOffset*4;
+  memcpy(&tableHead,pMap->pMap+tableOffset,sizeof(sMbsHeader));
+  if(pMap->iSwap) { fLmdSwap4((uint32_t*)&tableHead,2); }
+  if(tableHead.iType != LMD__TYPE_FILE_INDEX_101_2) {
+    printf("fLmdMapOpen: LMD format error: no index table: %s, type %0x\n",pMap->cFile,tableHead.iType);
+    return(GETLMD__NOLMDFILE);
+  }
+
+  // the table is copied, the swapped values must not end up in the mapping
+  table=(char*)malloc(tableBytes);
+  memcpy(table,pMap->pMap+tableOffset+16,tableBytes);
+  if(pMap->iSwap) {
+    fLmdSwap4((uint32_t*)table,tableBytes/4);
+    if(offsetSize == 8) { fLmdSwap8((uint64_t*)table,tableBytes/8); }
+  }
+  pMap->pOffset=(lmdoff_t*)malloc(entries*sizeof(lmdoff_t));
+  for(i=0; i<entries; i++) {
+    if(offsetSize == 4) { value=((uint32_t*)table)[i]; }
+    else { value=((lmdoff_t*)table)[i]; }
+    if(value > pMap->iMapBytes/4) { iReturn=GETLMD__NOLMDFILE; }
+    pMap->pOffset[i]=value*4;
+  }
+  free(table);
+
+  // every element must lie in the file before the next one
+  if(pMap->pOffset[0] < sizeof(sMbsFileHeader)) { iReturn=GETLMD__NOLMDFILE; }
+  for(i=0; (iReturn == LMD__SUCCESS) && (i<entries-1); i++) {
+    words=fLmdMapElementWords(pMap,pMap->pOffset[i]);
+    if((words == 0) || (pMap->pOffset[i]+(lmdoff_t)words*2 > pMap->pOffset[i+1])) { iReturn=GETLMD__NOLMDFILE; }
+  }
+  if(iReturn != LMD__SUCCESS) {
+    printf("fLmdMapOpen: Index format error: %s, element offsets out of the file\n",pMap->cFile);
+    free(pMap->pOffset);
+    pMap->pOffset=NULL;
+    return(iReturn);
+  }
+  pMap->iElements=entries-1;
+  return(LMD__SUCCESS);
+}
+//===============================================================
+uint32_t fLmdMapIndexFromTagFile(sLmdMapControl* pMap, char* TagFile)
+{
+  FILE* tagFile;
+  s_taghe taghe;
+  s_tag* tags;
+  uint64_t i;
+  uint32_t iReturn=LMD__SUCCESS;
+
+  if((tagFile=fopen(TagFile,"r")) == NULL) { return(GETLMD__NOFILE); }
+  if(fread(&taghe,sizeof(s_taghe),1,tagFile) != 1) {
+    fclose(tagFile);
+    return(GETLMD__NOLMDFILE);
+  }
+  if(taghe.l_endian != 1) { fLmdSwap4((uint32_t*)&taghe,sizeof(s_taghe)/4); }
+  if(taghe.l_events < 0) {
+    fclose(tagFile);
+    return(GETLMD__NOLMDFILE);
+  }
+  tags=(s_tag*)malloc(((uint64_t)taghe.l_events+1)*sizeof(s_tag));
+  if(fread(tags,sizeof(s_tag),taghe.l_events,tagFile) != (size_t)taghe.l_events) { iReturn=GETLMD__NOLMDFILE; }
+  fclose(tagFile);
+
+  pMap->pOffset=(lmdoff_t*)malloc(((uint64_t)taghe.l_events+1)*sizeof(lmdoff_t));
+  for(i=0; (iReturn == LMD__SUCCESS) && (i<(uint64_t)taghe.l_events); i++) {
+    if(taghe.l_endian != 1) { fLmdSwap4((uint32_t*)&tags[i],2); }
+    // negative offsets mark events spanning buffers of the old buffered format
+    if((tags[i].l_offset <= 0) || (fLmdMapElementWords(pMap,tags[i].l_offset) == 0)) { iReturn=GETLMD__SIZE_ERROR; }
+    else { pMap->pOffset[i]=tags[i].l_offset; }
+  }
+  free(tags);
+  if(iReturn != LMD__SUCCESS) {
+    printf("fLmdMapOpen: tag file %s does not match %s\n",TagFile,pMap->cFile);
+    free(pMap->pOffset);
+    pMap->pOffset=NULL;
+    return(iReturn);
+  }
+  pMap->iElements=taghe.l_events;
+  pMap->pOffset[pMap->iElements]=pMap->iElements ?
+                                 pMap->pOffset[pMap->iElements-1]+fLmdMapElementWords(pMap,pMap->pOffset[pMap->iElements-1])*2 :
+                                 sizeof(sMbsFileHeader);
+  return(LMD__SUCCESS);
+}
+//===============================================================
+uint32_t fLmdMapWriteTagFile(sLmdMapControl* pMap, char* TagFile)
+{
+  FILE* tagFile;
+  s_taghe taghe;
+  s_tag tag;
+  sMbsHeader* pElement;
+  uint64_t i;
+  INTS4 lastEvent=-1,lin=0;
+
+  if(pMap->pOffset[pMap->iElements] > 0x7fffffff) {
+    printf("fLmdMapWriteTagFile: %s too large for 32 bit tag offsets\n",pMap->cFile);
+    return(PUTLMD__TOOBIG);
+  }
+  if((tagFile=fopen(TagFile,"w")) == NULL) { return(PUTLMD__OPEN_ERR); }
+  memset(&taghe,0,sizeof(s_taghe));
+  fwrite(&taghe,sizeof(s_taghe),1,tagFile); // updated at the end
+  for(i=0; i<pMap->iElements; i++) {
+    fLmdMapGetElement(pMap,i,&pElement);
+    tag.l_event=0;
+    if(pElement->iType == LMD__TYPE_EVENT_HEADER_10_1) { tag.l_event=((sMbsEventHeader*)pElement)->iEventNumber; }
+    tag.l_offset=(INTS4)pMap->pOffset[i];
+    if(tag.l_event != lastEvent+1) {
+      lin++;
+      if(lin == 1) { taghe.l_first=tag.l_event; }
+    }
+    lastEvent=tag.l_event;
+    if(fwrite(&tag,sizeof(s_tag),1,tagFile) != 1) {
+      fclose(tagFile);
+      return(PUTLMD__EXCEED);
+    }
+  }
+  taghe.l_endian   = 1;
+  taghe.l_version  = 1;
+  taghe.l_bufsize  = 0; // no buffers in this format
+  taghe.l_buffers  = 0;
+  taghe.l_events   = pMap->iElements;
+  taghe.l_filesize = sizeof(s_tag)*pMap->iElements;
+  taghe.l_linear   = (lin == 1);
+  taghe.l_last     = lastEvent;
+  if((fseek(tagFile,0,SEEK_SET) != 0) || (fwrite(&taghe,sizeof(s_taghe),1,tagFile) != 1)) {
+    fclose(tagFile);
+    return(PUTLMD__EXCEED);
+  }
+  if(fclose(tagFile) != 0) { return(LMD__CLOSE_ERR); }
+  return(LMD__SUCCESS);
+}
+//===============================================================
+uint32_t fLmdMapGetElement(sLmdMapControl* pMap, uint64_t index, sMbsHeader** element)
+{
+  sMbsHeader* pM;
+  *element=NULL;
+  if(pMap->pMap == NULL) { return(GETLMD__NOFILE); }
+  if(index >= pMap->iElements) { return(GETLMD__OUTOF_RANGE); }
+  pM=(sMbsHeader*)(pMap->pMap+pMap->pOffset[index]);
+  if(pMap->iSwap && !pMap->pSwapped[index]) {
+    fLmdSwap4((uint32_t*)pM,fLmdMapElementWords(pMap,pMap->pOffset[index])/2);
+    pMap->pSwapped[index]=1;
+  }
+  *element=pM;
+  return(LMD__SUCCESS);
+}
+//===============================================================
+uint32_t fLmdMapGetNext(sLmdMapControl* pMap, sMbsHeader** element)
+{
+  uint32_t iReturn;
+  *element=NULL;
+  if(pMap->iCurrent >= pMap->iEnd) { return(GETLMD__NOMORE); }
+  iReturn=fLmdMapGetElement(pMap,pMap->iCurrent,element);
+  if(iReturn == LMD__SUCCESS) { pMap->iCurrent++; }
+  return(iReturn);
+}
+//===============================================================
+uint32_t fLmdMapSeek(sLmdMapControl* pMap, uint64_t index)
+{
+  if(index > pMap->iElements) { return(GETLMD__OUTOF_RANGE); }
+  pMap->iCurrent=index;
+  return(LMD__SUCCESS);
+}
+//===============================================================
+// restrict fLmdMapGetNext to the elements first..last-1 and seek to first
+uint32_t fLmdMapSetRange(sLmdMapControl* pMap, uint64_t first, uint64_t last)
+{
+  if((first > last) || (last > pMap->iElements)) { return(GETLMD__OUTOF_RANGE); }
+  pMap->iCurrent=first;
+  pMap->iEnd=last;
+  if(last > first) {
+    madvise(pMap->pMap+(pMap->pOffset[first] & ~((lmdoff_t)getpagesize()-1)),
+            pMap->pOffset[last]-(pMap->pOffset[first] & ~((lmdoff_t)getpagesize()-1)),MADV_WILLNEED);
+  }
+  return(LMD__SUCCESS);
+}
+//===============================================================
+// range iRange of nRanges contiguous ranges with about the same number of bytes
+uint32_t fLmdMapGetRange(sLmdMapControl* pMap, uint32_t iRange, uint32_t nRanges, uint64_t* first, uint64_t* last)
+{
+  uint64_t bound[2];
+  lmdoff_t begin,bytes,target;
+  uint64_t lo,hi,mid;
+  uint32_t i;
+
+  if((nRanges == 0) || (iRange >= nRanges)) { return(GETLMD__OUTOF_RANGE); }
+  begin=pMap->pOffset[0];
+  bytes=pMap->pOffset[pMap->iElements]-begin;
+  for(i=0; i<2; i++) {
+    // first element starting at or behind the target byte
+    target=begin+bytes/nRanges*(iRange+i)+bytes%nRanges*(iRange+i)/nRanges;
+    lo=0;
+    hi=pMap->iElements;
+    if(iRange+i == nRanges) { lo=hi; }
+    while(lo < hi) {
+      mid=lo+(hi-lo)/2;
+      if(pMap->pOffset[mid] < target) { lo=mid+1; }
+      else { hi=mid; }
+    }
+    bound[i]=lo;
+  }
+  *first=bound[0];
+  *last=bound[1];
+  return(LMD__SUCCESS);
+}
+//===============================================================
+uint64_t fLmdMapGetElements(sLmdMapControl* pMap)
+{
+  return(pMap->iElements);
+}
+//===============================================================
+void fLmdMapCleanup(sLmdMapControl* pMap)
+{
+  if(pMap->pMap != NULL) { munmap(pMap->pMap,pMap->iMapBytes); }
+  if(pMap->pOffset != NULL) { free(pMap->pOffset); }
+  if(pMap->pSwapped != NULL) { free(pMap->pSwapped); }
+  pMap->pMap=NULL;
+  pMap->pOffset=NULL;
+  pMap->pSwapped=NULL;
+  pMap->iMapBytes=0;
+  pMap->iSwap=0;
+  pMap->iElements=0;
+  pMap->iCurrent=0;
+  pMap->iEnd=0;
+}
+//===============================================================
+uint32_t fLmdMapClose(sLmdMapControl* pMap)
+{
+  fLmdMapCleanup(pMap);
+  if(pMap->iFile != -1) {
+    if(close(pMap->iFile) != 0) {
+      pMap->iFile=-1;
+      return(LMD__CLOSE_ERR);
+    }
+  }
+  pMap->iFile=-1;
+  return(LMD__SUCCESS);
+}
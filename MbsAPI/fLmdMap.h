@@ -0,0 +1,53 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/* Memory mapped reader for LMD files (file header LMD__TYPE_FILE_HEADER_101_1).
+ *
+ * The file is mapped once, the elements are returned as pointers into the
+ * mapping without copying (files written with the other byte order are swapped
+ * in place in a private mapping, element by element when they are accessed).
+ * An offset index of all elements is taken from a tag file, from the offset
+ * table in the file or built by stepping through the element headers. It allows
+ * to seek to element N and to split the file into contiguous ranges of about
+ * the same size for parallel processing. The sub-events of an event can be
+ * accessed in place with f_evt_get_subevent((s_ve10_1*)element, ...).
+ *
+ * Tag files have the layout of f_evt_cre_tagfile (s_taghe, then one s_tag per
+ * element with the event number and the byte offset in the file). As the
+ * offsets are 32 bit, tag files can only be written for files below 2 GB. */
+#ifndef MbsLmdMap
+#define MbsLmdMap
+
+#include "fLmd.h"
+
+typedef struct {
+  int      iFile;          /* file descriptor */
+  char*    pMap;           /* mapped file */
+  lmdoff_t iMapBytes;      /* mapped bytes (file size) */
+  sMbsFileHeader sFileHeader; /* copy of the file header, swapped if needed */
+  uint32_t iSwap;
+  lmdoff_t* pOffset;       /* byte offsets of the elements, iElements+1 entries */
+  uint64_t iElements;      /* elements in the index */
+  uint64_t iCurrent;       /* next element of fLmdMapGetNext */
+  uint64_t iEnd;           /* end of the range read by fLmdMapGetNext */
+  uint8_t* pSwapped;       /* elements already swapped, only if iSwap */
+  uint32_t iVerbose;
+  char     cFile[512];     /* file name */
+} sLmdMapControl;
+
+sLmdMapControl* fLmdMapAllocateControl();
+uint32_t   fLmdMapOpen(sLmdMapControl*,char*,char*);
+uint32_t   fLmdMapWriteTagFile(sLmdMapControl*,char*);
+uint32_t   fLmdMapGetElement(sLmdMapControl*,uint64_t,sMbsHeader**);
+uint32_t   fLmdMapGetNext(sLmdMapControl*,sMbsHeader**);
+uint32_t   fLmdMapSeek(sLmdMapControl*,uint64_t);
+uint32_t   fLmdMapSetRange(sLmdMapControl*,uint64_t,uint64_t);
+uint32_t   fLmdMapGetRange(sLmdMapControl*,uint32_t,uint32_t,uint64_t*,uint64_t*);
+uint64_t   fLmdMapGetElements(sLmdMapControl*);
+uint32_t   fLmdMapClose(sLmdMapControl*);
+
+#endif
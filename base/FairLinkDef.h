@@ -26,7 +26,13 @@
 #pragma link C++ class FairLink+;
 //#pragma link C++ class FairLinkedData+;
 //#pragma link C++ class FairSingleLinkedData+;
+#pragma link C++ class FairCompactLink+;
+#pragma link C++ class std::vector<FairCompactLink>+;
+#pragma link C++ class std::set<FairLink>+;
 #pragma link C++ class FairMultiLinkedData+;
+#pragma read sourceClass="FairMultiLinkedData" version="[-4]" source="std::set<FairLink> fLinks" \
+  targetClass="FairMultiLinkedData" target="fLinks" \
+  code="{ fLinks.clear(); for (std::set<FairLink>::const_iterator it = onfile.fLinks.begin(); it != onfile.fLinks.end(); it++) { fLinks.push_back(FairCompactLink(*it)); } }"
 #pragma link C++ class FairMultiLinkedData_Interface+;
 //#pragma link C++ class FairBasePoint+;
 #pragma link C++ class FairHit+;
@@ -52,6 +58,8 @@
 #pragma link C++ class FairGenericStack+;
 #pragma link C++ class FairTask+;
 #pragma link C++ class FairFieldFactory+;
+#pragma link C++ class FairFieldMap+;
+#pragma link C++ class FairFieldMapCreator+;
 #pragma link C++ class FairRadLenPoint+;
 #pragma link C++ class FairRadLenManager+;
 #pragma link C++ class FairRadGridManager+;
@@ -61,6 +69,8 @@
 #pragma link C++ class FairTimeStamp+;
 #pragma link C++ class FairRadMapPoint+;
 #pragma link C++ class FairTSBufferFunctional+;
+#pragma link C++ class FairTimeIndex+;
+#pragma link C++ class FairTimeSlice+;
 #pragma link C++ class FairFileInfo+;
 #pragma link C++ class FairRunInfo+;
 #pragma link C++ class FairWriteoutBuffer;
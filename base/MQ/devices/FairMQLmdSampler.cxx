@@ -15,6 +15,8 @@
 
 #include "FairMQLogger.h"
 #include "FairMQLmdSampler.h"
+#include <chrono>
+#include <cstring>
 #include <stdexcept>
 
 FairMQLmdSampler::FairMQLmdSampler() : 
@@ -29,7 +31,14 @@ FairMQLmdSampler::FairMQLmdSampler() :
     fxSubEvent(nullptr),
     fxInfoHeader(nullptr),
     stop(false),
-    fMsgCounter(0)
+    fMsgCounter(0),
+    fSubEventChanMap(),
+    fAggregationMode(kSubEvent),
+    fSubEventSlotMap(),
+    fSlots(),
+    fCurrentBuffer(-1),
+    fMaxAggregatedSize(1024 * 1024),
+    fBytesSent(0)
 {
 }
 
@@ -85,18 +94,47 @@ void FairMQLmdSampler::InitTask()
     // Init Counters
     fNEvent=0;
     fCurrentEvent=0;
+    fCurrentBuffer=-1;
+    fBytesSent=0;
+
+    // resolve the channels once, sub-event keys of the same channel share one output slot
+    fSubEventSlotMap.clear();
+    fSlots.clear();
+    std::map<std::string,int> slotOfChannel;
+    for (const auto& keyChannel : fSubEventChanMap)
+    {
+        const std::string& chanName = keyChannel.second;
+        if (!fChannels.count(chanName))
+        {
+            throw std::runtime_error(std::string("FairMQLmdSampler::InitTask: MQ-channel name '") + chanName + "' does not exist. Check the MQ-channel configuration");
+        }
+        if (!slotOfChannel.count(chanName))
+        {
+            slotOfChannel[chanName] = fSlots.size();
+            fSlots.push_back(std::unique_ptr<OutputSlot>(new OutputSlot(&fChannels.at(chanName).at(0))));
+        }
+        fSubEventSlotMap[keyChannel.first] = slotOfChannel.at(chanName);
+    }
 }
 
 void FairMQLmdSampler::Run()
 {
-    
+    auto start = std::chrono::steady_clock::now();
+
     while (CheckCurrentState(RUNNING) )//&& !stop)
     {    
         if(1 == ReadEvent())
             break;
     }
-    LOG(INFO)<<"Sent "<<fMsgCounter<<" messages.";
+    Flush();
 
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    LOG(INFO)<<"Sent "<<fMsgCounter<<" messages.";
+    if (seconds > 0)
+    {
+        LOG(INFO) << "FairMQLmdSampler: " << fNEvent << " events, " << fBytesSent << " bytes in " << seconds << " s, "
+                  << fNEvent / seconds << " events/s, " << fBytesSent / seconds / 1000000. << " MB/s";
+    }
 }
 
 
@@ -105,6 +143,60 @@ void free_buffer (void *data, void *hint)
     LOG(TRACE) << "empty deleter";
 }
 
+//______________________________________________________________________________
+void FairMQLmdSampler::SendSubEvent(OutputSlot& slot, int* data, int nrlongwords)
+{
+    std::vector<std::unique_ptr<FairMQMessage>> parts;
+    parts.push_back(std::unique_ptr<FairMQMessage>(fTransportFactory->CreateMessage(sizeof(int))));
+    memcpy(parts[0]->GetData(), &nrlongwords, sizeof(int));
+    // the data stays in the buffer of the event channel
+    parts.push_back(std::unique_ptr<FairMQMessage>(fTransportFactory->CreateMessage(data, nrlongwords * sizeof(int), free_buffer, nullptr)));
+    if (slot.fChannel->SendParts(parts) >= 0)
+    {
+        fBytesSent += nrlongwords * sizeof(int);
+        fMsgCounter++;
+    }
+}
+
+//______________________________________________________________________________
+void FairMQLmdSampler::AddSubEvent(OutputSlot& slot, int* data, int nrlongwords)
+{
+    // copied, the buffer of the event channel is reused by the next events
+    slot.fSizes.push_back(nrlongwords);
+    slot.fData.sputn(reinterpret_cast<char*>(data), nrlongwords * sizeof(int));
+}
+
+//______________________________________________________________________________
+void FairMQLmdSampler::Flush()
+{
+    for (const auto& slotPtr : fSlots)
+    {
+        OutputSlot& slot = *slotPtr;
+        if (slot.fSizes.empty())
+        {
+            continue;
+        }
+
+        int nSubEvts = slot.fSizes.size();
+        std::vector<std::unique_ptr<FairMQMessage>> parts;
+        parts.push_back(std::unique_ptr<FairMQMessage>(fTransportFactory->CreateMessage((nSubEvts + 1) * sizeof(int))));
+        int* header = static_cast<int*>(parts[0]->GetData());
+        header[0] = nSubEvts;
+        memcpy(header + 1, slot.fSizes.data(), nSubEvts * sizeof(int));
+
+        size_t size = slot.fData.GetSize();
+        parts.push_back(std::unique_ptr<FairMQMessage>(fTransportFactory->CreateMessage()));
+        slot.fData.Finish(parts[1].get());
+
+        if (slot.fChannel->SendParts(parts) >= 0)
+        {
+            fBytesSent += size;
+            fMsgCounter++;
+        }
+        slot.fSizes.clear();
+    }
+}
+
 //______________________________________________________________________________
 int FairMQLmdSampler::ReadEvent()
 {
@@ -132,6 +224,7 @@ int FairMQLmdSampler::ReadEvent()
 
         if(GETEVT__NOMORE == status) 
         {
+            Flush();
             Close();
         }
 
@@ -163,6 +256,31 @@ int FairMQLmdSampler::ReadEvent()
     /*bool result = */
     //Unpack((int*)fxEvent, sizeof(s_ve10_1), -2, -2, -2, -2, -2);
 
+    if (fAggregationMode == kBuffer)
+    {
+        if (fxBuffer)
+        {
+            // the events of the last buffer are complete
+            if (fxBuffer->l_buf != fCurrentBuffer)
+            {
+                Flush();
+                fCurrentBuffer = fxBuffer->l_buf;
+            }
+        }
+        else
+        {
+            // no buffer headers (LMD files), send the complete events when a channel has gathered enough data
+            for (const auto& slotPtr : fSlots)
+            {
+                if (slotPtr->fData.GetSize() >= fMaxAggregatedSize)
+                {
+                    Flush();
+                    break;
+                }
+            }
+        }
+    }
+
     int nrSubEvts = f_evt_get_subevent(fxEvent, 0, NULL, NULL, NULL);
     int sebuflength;
     short setype;
@@ -201,8 +319,8 @@ int FairMQLmdSampler::ReadEvent()
         // Data to send : fxEventData
         SubEvtKey key(setype, sesubtype, seprocid, sesubcrate, secontrol);
 
-        
-        if(!fSubEventChanMap.count(key))
+        std::map<SubEvtKey,int>::const_iterator slotIt = fSubEventSlotMap.find(key);
+        if(slotIt == fSubEventSlotMap.end())
         {
             LOG(TRACE)<<"FairMQLmdSampler::ReadEvent: sub-event key not registered";
         }
@@ -211,21 +329,15 @@ int FairMQLmdSampler::ReadEvent()
             LOG(TRACE)<<"array size = "<<sebuflength;
             LOG(TRACE)<<"fxEventData = "<<*fxEventData;
 
-            std::string chanName=fSubEventChanMap.at(key);
-            LOG(TRACE)<<"chanName="<<chanName;
-
-            // send header
-            //std::unique_ptr<FairMQMessage> header(fTransportFactory->CreateMessage(fxSubEvent, sizeof(fxSubEvent), free_buffer, nullptr));
-            //fChannels.at(chanName).at(0).SendPart(header);
-
-            int* arraySize = new int(sebuflength);
-
-            std::unique_ptr<FairMQMessage> msgSize(fTransportFactory->CreateMessage(arraySize, sizeof(int)));
-            fChannels.at(chanName).at(0).SendPart(msgSize);
-            // send data
-            std::unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage(fxEventData, sebuflength, free_buffer, nullptr));
-            fChannels.at(chanName).at(0).Send(msg);
-            fMsgCounter++;
+            OutputSlot& slot = *fSlots[slotIt->second];
+            if (fAggregationMode == kSubEvent)
+            {
+                SendSubEvent(slot, fxEventData, sebuflength);
+            }
+            else
+            {
+                AddSubEvent(slot, fxEventData, sebuflength);
+            }
             /*
             if(Unpack(fxEventData, sebuflength,
                       setype, sesubtype,
@@ -237,6 +349,11 @@ int FairMQLmdSampler::ReadEvent()
         }
     }
 
+    if (fAggregationMode == kEvent)
+    {
+        Flush();
+    }
+
     // Increment evt counters.
     fNEvent++;
     fCurrentEvent++;
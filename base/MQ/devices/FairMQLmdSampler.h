@@ -26,11 +26,14 @@ extern "C"
 
 #include "FairMQDevice.h"
 #include "FairMQMessage.h"
+#include "FairMQMessageStreamBuf.h"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <tuple>
 #include <map>
+#include <memory>
 
 
 namespace fs = boost::filesystem;
@@ -42,6 +45,15 @@ class FairMQLmdSampler : public FairMQDevice
 
 public:
 
+    /// How the sub-events are sent:
+    /// kSubEvent - every sub-event as two-part message (size in longwords, data),
+    /// kEvent    - all sub-events of an MBS event for the same channel as one two-part message,
+    /// kBuffer   - like kEvent, but for all events of an MBS buffer. Inputs without buffer headers (LMD files)
+    ///             send the events gathered for a channel when they exceed the size set with SetMaxAggregatedSize.
+    /// The aggregated messages start with a header part {number of sub-events, size in longwords of every sub-event},
+    /// the second part holds the data of the sub-events one after the other.
+    enum AggregationMode { kSubEvent, kEvent, kBuffer };
+
     FairMQLmdSampler();
     virtual ~FairMQLmdSampler();
 
@@ -49,6 +61,11 @@ public:
     void AddDir(const std::string& dir);
     void AddFile(const std::string& fileName);
 
+    void SetAggregationMode(AggregationMode mode) { fAggregationMode = mode; }
+    AggregationMode GetAggregationMode() const { return fAggregationMode; }
+    /// Bytes gathered for a channel in kBuffer mode before they are sent if the input has no buffer headers
+    void SetMaxAggregatedSize(size_t bytes) { fMaxAggregatedSize = bytes; }
+
 protected:
 
     void InitTask();
@@ -58,6 +75,21 @@ protected:
     
     void Close();
 private:
+    /// Output channel with the sub-events gathered for it
+    struct OutputSlot
+    {
+        OutputSlot(FairMQChannel* channel) : fChannel(channel), fSizes(), fData() {}
+
+        FairMQChannel* fChannel;
+        std::vector<int> fSizes;
+        FairMQMessageOutBuf fData;
+    };
+
+    void SendSubEvent(OutputSlot& slot, int* data, int nrlongwords);
+    void AddSubEvent(OutputSlot& slot, int* data, int nrlongwords);
+    /// Sends the gathered sub-events of all channels
+    void Flush();
+
      ////////////////////// data members
     int fCurrentFile;
     int fNEvent;    
@@ -73,6 +105,13 @@ private:
     int fMsgCounter;
     typedef std::tuple<short,short,short,short,short> SubEvtKey;
     std::map<SubEvtKey,std::string > fSubEventChanMap;
+
+    AggregationMode fAggregationMode;
+    std::map<SubEvtKey,int> fSubEventSlotMap; // resolved in InitTask
+    std::vector<std::unique_ptr<OutputSlot>> fSlots;
+    int fCurrentBuffer;
+    size_t fMaxAggregatedSize;
+    uint64_t fBytesSent;
 };
 
 #endif  /* !FAIRMQLMDSAMPLER_H */
\ No newline at end of file
@@ -50,10 +50,12 @@ void FairMQProcessor::Run()
     FairMQChannel& dataInChannel = fChannels.at("data-in").at(0);
     FairMQChannel& dataOutChannel = fChannels.at("data-out").at(0);
 
+    // the payload message object is reused for all events, every receive replaces its content
+    std::unique_ptr<FairMQMessage> payload(fTransportFactory->CreateMessage());
+    fProcessorTask->SetPayload(payload.get());
+
     while (CheckCurrentState(RUNNING))
     {
-        fProcessorTask->SetPayload(fTransportFactory->CreateMessage());
-
         ++receivedMsgs;
 
         if (dataInChannel.Receive(fProcessorTask->GetPayload()) > 0)
@@ -63,8 +65,6 @@ void FairMQProcessor::Run()
             dataOutChannel.Send(fProcessorTask->GetPayload());
             sentMsgs++;
         }
-
-        fProcessorTask->GetPayload()->CloseMessage();
     }
 
     LOG(INFO) << "Received " << receivedMsgs << " and sent " << sentMsgs << " messages!";
@@ -73,15 +73,12 @@ void FairMQProcessor::Run()
 void FairMQProcessor::SendPart()
 {
       fChannels.at("data-out").at(0).Send(fProcessorTask->GetPayload(), "snd-more");
-      fProcessorTask->GetPayload()->CloseMessage();
 }
 
 bool FairMQProcessor::ReceivePart()
 {
     if (fChannels.at("data-in").at(0).ExpectsAnotherPart())
     {
-        fProcessorTask->GetPayload()->CloseMessage();
-        fProcessorTask->SetPayload(fTransportFactory->CreateMessage());
         return fChannels.at("data-in").at(0).Receive(fProcessorTask->GetPayload());
     }
     else
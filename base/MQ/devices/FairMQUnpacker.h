@@ -19,10 +19,12 @@
 #include "FairMQMessage.h"
 #include "RootSerializer.h"
 
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <map>
+#include <vector>
 
 
 template<typename U, typename T=RootSerializer>
@@ -113,28 +115,73 @@ protected:
         const FairMQChannel& inputChannel = fChannels.at(fInputChannelName).at(0);
         const FairMQChannel& outputChannel = fChannels.at("data-out").at(0);
 
+        std::vector<std::unique_ptr<FairMQMessage>> parts;
+
         while (CheckCurrentState(RUNNING))
         {
+            parts.clear();
+            if (inputChannel.ReceiveParts(parts) < 0)
+            {
+                continue;
+            }
+            if (parts.size() != 2)
+            {
+                LOG(ERROR) << "FairMQUnpacker: expected a message of two parts (sizes, data), got " << parts.size();
+                continue;
+            }
 
-            std::unique_ptr<FairMQMessage> msgSize(fTransportFactory->CreateMessage());
-            std::unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
-
-            if(inputChannel.Receive(msgSize)>=0)
-                if(inputChannel.Receive(msg)>=0)
+            // header of one sub-event: {size}, of aggregated sub-events: {number of sub-events, sizes...}
+            size_t headerSize = parts[0]->GetSize();
+            if (headerSize < sizeof(int))
+            {
+                LOG(ERROR) << "FairMQUnpacker: header part of " << headerSize << " bytes is too short, message skipped";
+                continue;
+            }
+            int* header = static_cast<int*>(parts[0]->GetData());
+            int nSubEvts = 1;
+            int* sizes = header;
+            if (headerSize > sizeof(int))
+            {
+                nSubEvts = header[0];
+                sizes = header + 1;
+                if (nSubEvts < 0 || headerSize < (static_cast<size_t>(nSubEvts) + 1) * sizeof(int))
                 {
-                    int dataSize=*(static_cast<int*>(msgSize->GetData()));
-                    int* subEvt_ptr = static_cast<int*>(msg->GetData());
-
-                    LOG(TRACE)<<"array size = "<<dataSize;
-                    if(dataSize>0)
-                        LOG(TRACE)<<"first element in array = "<<*subEvt_ptr;
-                    
-                    fUnpacker->DoUnpack(subEvt_ptr,dataSize);
-
-                    serialization_type::SetMessage(msg.get());
-                    outputChannel.Send(serialization_type::SerializeMsg(fUnpacker->GetOutputData()));
-                    fUnpacker->Reset();
+                    LOG(ERROR) << "FairMQUnpacker: header part of " << headerSize << " bytes does not hold "
+                               << nSubEvts << " sub-event sizes, message skipped";
+                    continue;
                 }
+            }
+
+            // the sizes must fit into the data part
+            size_t dataWords = 0;
+            bool validSizes = true;
+            for (int i = 0; i < nSubEvts && validSizes; ++i)
+            {
+                validSizes = sizes[i] >= 0;
+                dataWords += sizes[i];
+            }
+            if (!validSizes || dataWords * sizeof(int) > parts[1]->GetSize())
+            {
+                LOG(ERROR) << "FairMQUnpacker: sub-event sizes do not match the data part of "
+                           << parts[1]->GetSize() << " bytes, message skipped";
+                continue;
+            }
+
+            int* subEvt_ptr = static_cast<int*>(parts[1]->GetData());
+            for (int i = 0; i < nSubEvts; ++i)
+            {
+                int dataSize = sizes[i];
+                LOG(TRACE)<<"array size = "<<dataSize;
+                if(dataSize>0)
+                    LOG(TRACE)<<"first element in array = "<<*subEvt_ptr;
+
+                fUnpacker->DoUnpack(subEvt_ptr,dataSize);
+                subEvt_ptr += dataSize;
+            }
+
+            serialization_type::SetMessage(parts[1].get());
+            outputChannel.Send(serialization_type::SerializeMsg(fUnpacker->GetOutputData()));
+            fUnpacker->Reset();
         }
     }
 
@@ -13,11 +13,16 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <sstream>
+#include <istream>
+#include <ostream>
 #include <type_traits>
 
 // boost
 #include <boost/serialization/access.hpp>
+#include <boost/serialization/collection_size_type.hpp>
+#include <boost/serialization/item_version_type.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/split_member.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
@@ -32,6 +37,7 @@
 // FairRoot - FairMQ
 #include "FairMQLogger.h"
 #include "FairMQMessage.h"
+#include "FairMQMessageStreamBuf.h"
 #include "BaseSerializationPolicy.h"
 #include "BaseDeserializationPolicy.h"
 
@@ -64,7 +70,49 @@ typedef boost::archive::binary_oarchive         BoostBinArchOut;
 ///    ////////////////////////   serialize   /////////////////////////////////
 ///    ////////////////////////////////////////////////////////////////////////
 
+/// Saves the objects of a TClonesArray in the same format as a std::vector<DataType>
+/// (see boost::serialization::stl::save_collection) without copying them into a vector
+template <typename DataType>
+class BoostClonesArrayView
+{
+  public:
+    BoostClonesArrayView(TClonesArray* clonesArray) :
+        fClonesArray(clonesArray)
+    {}
+
+    template <class Archive>
+    void save(Archive& ar, const unsigned int version) const
+    {
+        boost::serialization::collection_size_type count(0);
+        for (Int_t i = 0; i < fClonesArray->GetEntriesFast(); ++i)
+        {
+            if (fClonesArray->At(i))
+            {
+                ++count;
+            }
+        }
+        const boost::serialization::item_version_type item_version(boost::serialization::version<DataType>::value);
+        ar << BOOST_SERIALIZATION_NVP(count);
+        ar << BOOST_SERIALIZATION_NVP(item_version);
+        for (Int_t i = 0; i < fClonesArray->GetEntriesFast(); ++i)
+        {
+            const DataType* data = reinterpret_cast<const DataType*>(fClonesArray->At(i));
+            if (!data)
+            {
+                continue;
+            }
+            ar << boost::serialization::make_nvp("item", *data);
+        }
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+  private:
+    TClonesArray* fClonesArray;
+};
+
 ////// base template class
+/// The archives are written directly into the message buffer (FairMQMessageOutBuf)
 template <typename DataType, typename BoostArchiveOut=BoostBinArchOut>
 class BoostSerializer : public BaseSerializationPolicy<BoostSerializer<DataType,BoostArchiveOut>>
 {
@@ -72,7 +120,10 @@ class BoostSerializer : public BaseSerializationPolicy<BoostSerializer<DataType,
     BoostSerializer() :
         BaseSerializationPolicy<BoostSerializer<DataType,BoostArchiveOut>>(),
         fMessage(nullptr),
-        fTransport(nullptr)
+        fTransport(nullptr),
+        fDataVector(),
+        fOutBuf(),
+        fOutStream(&fOutBuf)
     {}
 
     ~BoostSerializer()
@@ -91,7 +142,7 @@ class BoostSerializer : public BaseSerializationPolicy<BoostSerializer<DataType,
         fMessage = msg;
     }
 
-    void GetMessage()
+    FairMQMessage* GetMessage()
     {
         return fMessage;
     }
@@ -103,23 +154,24 @@ class BoostSerializer : public BaseSerializationPolicy<BoostSerializer<DataType,
 
     /// --------------------------------------------------------
     /// main method to boost serialize
-    void DoSerialization()
+    template <typename T>
+    void DoSerialization(const T& data)
     {
-        std::ostringstream buffer;
-        BoostArchiveOut OutputArchive(buffer);
         try
         {
-            OutputArchive << fDataVector;
+            BoostArchiveOut OutputArchive(fOutStream);
+            OutputArchive << data;
         }
         catch (boost::archive::archive_exception& e)
         {
             MQLOG(ERROR) << e.what();
         }
+        fOutBuf.Finish(fMessage);
+    }
 
-        int size = buffer.str().length();
-        // fMessage = fTransport->CreateMessage(size);
-        fMessage->Rebuild(size);
-        std::memcpy(fMessage->GetData(), buffer.str().c_str(), size);
+    void DoSerialization()
+    {
+        DoSerialization(fDataVector);
 
         // delete the vector content
         if (fDataVector.size() > 0)
@@ -128,67 +180,17 @@ class BoostSerializer : public BaseSerializationPolicy<BoostSerializer<DataType,
         }
     }
 
-    void DoSerialization(const std::vector<DataType>& DataVector)
-    {
-        std::ostringstream buffer;
-        BoostArchiveOut OutputArchive(buffer);
-        try
-        {
-            OutputArchive << DataVector;
-        }
-        catch (boost::archive::archive_exception& e)
-        {
-            MQLOG(ERROR) << e.what();
-        }
-
-        int size = buffer.str().length();
-        // fMessage = fTransport->CreateMessage(size);
-        fMessage->Rebuild(size);
-        std::memcpy(fMessage->GetData(), buffer.str().c_str(), size);
-
-    }
-
     /// --------------------------------------------------------
     /// DataType&    -------->  FairMQMessage*
     FairMQMessage* SerializeMsg(DataType& Data)
     {
-        //fDataVector.push_back(Data);
-        //DoSerialization();
-        std::ostringstream buffer;
-        BoostArchiveOut OutputArchive(buffer);
-        try
-        {
-            OutputArchive << Data;
-        }
-        catch (boost::archive::archive_exception& e)
-        {
-            MQLOG(ERROR) << e.what();
-        }
-
-        int size = buffer.str().length();
-        // fMessage = fTransport->CreateMessage(size);
-        fMessage->Rebuild(size);
-        std::memcpy(fMessage->GetData(), buffer.str().c_str(), size);
+        DoSerialization(Data);
         return fMessage;
     }
 
     FairMQMessage* SerializeMsg(DataType* Data)
     {
-        std::ostringstream buffer;
-        BoostArchiveOut OutputArchive(buffer);
-        try
-        {
-            OutputArchive << *Data;
-        }
-        catch (boost::archive::archive_exception& e)
-        {
-            MQLOG(ERROR) << e.what();
-        }
-
-        int size = buffer.str().length();
-        // fMessage = fTransport->CreateMessage(size);
-        fMessage->Rebuild(size);
-        std::memcpy(fMessage->GetData(), buffer.str().c_str(), size);
+        DoSerialization(*Data);
         return fMessage;
     }
     /// --------------------------------------------------------    
@@ -200,19 +202,11 @@ class BoostSerializer : public BaseSerializationPolicy<BoostSerializer<DataType,
     }
     /// --------------------------------------------------------
     /// TClonesArray*    -------->  FairMQMessage*
+    /// the message can be deserialized into a std::vector<DataType>
     FairMQMessage* SerializeMsg(TClonesArray* clonesArray)
     {
-        // convert TClonesArray to vector<DataType>
-        for (Int_t i = 0; i < clonesArray->GetEntriesFast(); ++i)
-        {
-            DataType* data = reinterpret_cast<DataType*>(clonesArray->At(i));
-            if (!data)
-            {
-                continue;
-            }
-            fDataVector.push_back(*data);
-        }
-        DoSerialization();
+        const BoostClonesArrayView<DataType> view(clonesArray);
+        DoSerialization(view);
         return fMessage;
     }
 
@@ -234,6 +228,8 @@ class BoostSerializer : public BaseSerializationPolicy<BoostSerializer<DataType,
     FairMQMessage*          fMessage;
     FairMQTransportFactory* fTransport;
     std::vector<DataType>   fDataVector;
+    FairMQMessageOutBuf     fOutBuf;
+    std::ostream            fOutStream;
 };
 
 ///    ////////////////////////////////////////////////////////////////////////
@@ -260,7 +256,9 @@ class BoostDeSerializer : public BaseSerializationPolicy<BoostDeSerializer<DataT
     BoostDeSerializer() :
         BaseSerializationPolicy<BoostDeSerializer<DataType,TContainer,BoostArchiveIn>>(),
         fMessage(nullptr),
-        fTransport(nullptr)
+        fTransport(nullptr),
+        fInBuf(),
+        fInStream(&fInBuf)
     {
         DefaultContainerInit();
     }
@@ -283,7 +281,7 @@ class BoostDeSerializer : public BaseSerializationPolicy<BoostDeSerializer<DataT
         fMessage = msg;
     }
 
-    void GetMessage()
+    FairMQMessage* GetMessage()
     {
         return fMessage;
     }
@@ -294,19 +292,16 @@ class BoostDeSerializer : public BaseSerializationPolicy<BoostDeSerializer<DataT
     }
 
     /// --------------------------------------------------------
-    /// main method to boost deserialize
-    void DoDeSerialization(FairMQMessage* msg)
+    /// main method to boost deserialize, reads the message data in place
+    template <typename T>
+    void DoDeSerialization(FairMQMessage* msg, T& data)
     {
-        if (fDataVector.size() > 0)
-        {
-                fDataVector.clear();
-        }
-        std::string msgStr(static_cast<char*>(msg->GetData()), msg->GetSize());
-        std::istringstream buffer(msgStr);
-        BoostArchiveIn InputArchive(buffer);
+        fInBuf.SetMessage(msg);
+        fInStream.clear();
         try
         {
-            InputArchive >> fDataVector;
+            BoostArchiveIn InputArchive(fInStream);
+            InputArchive >> data;
         }
         catch (boost::archive::archive_exception& e)
         {
@@ -314,6 +309,15 @@ class BoostDeSerializer : public BaseSerializationPolicy<BoostDeSerializer<DataT
         }
     }
 
+    void DoDeSerialization(FairMQMessage* msg)
+    {
+        if (fDataVector.size() > 0)
+        {
+                fDataVector.clear();
+        }
+        DoDeSerialization(msg, fDataVector);
+    }
+
     /// --------------------------------------------------------
     /// FairMQMessage*  -------->  std::vector<DataType>& 
     template <typename T = TContainer, enable_if_match<T, std::vector<DataType> > = 0>
@@ -359,17 +363,7 @@ class BoostDeSerializer : public BaseSerializationPolicy<BoostDeSerializer<DataT
     template <typename T = TContainer, enable_if_match<T, DataType> = 0>
     T& DeserializeMsg(FairMQMessage* msg)
     {
-        std::string msgStr(static_cast<char*>(msg->GetData()), msg->GetSize());
-        std::istringstream buffer(msgStr);
-        BoostArchiveIn InputArchive(buffer);
-        try
-        {
-            InputArchive >> fDataContainer;
-        }
-        catch (boost::archive::archive_exception& e)
-        {
-            MQLOG(ERROR) << e.what();
-        }
+        DoDeSerialization(msg, fDataContainer);
         return fDataContainer;
     }
 
@@ -421,6 +415,8 @@ class BoostDeSerializer : public BaseSerializationPolicy<BoostDeSerializer<DataT
     FairMQTransportFactory* fTransport;
     std::vector<DataType>   fDataVector;
     TContainer              fDataContainer;
+    FairMQMessageInBuf      fInBuf;
+    std::istream            fInStream;
 
     //////////////////////////////////////////////////////////////////////////
     /// container init/destroy specialization for pointer/not pointer type ///
@@ -10,11 +10,14 @@
 
 //std
 #include <iostream>
+#include <mutex>
+#include <vector>
 //Root
 #include "TClonesArray.h"
 #include "TMessage.h"
 //FairRoot
 #include "FairMQMessage.h"
+#include "FairMQLogger.h"
 
 // special class to expose protected TMessage constructor
 class FairTMessage : public TMessage
@@ -25,13 +28,90 @@ class FairTMessage : public TMessage
     {
         ResetBit(kIsOwner);
     }
+
+    /// Streams the next object of the message into obj instead of creating a new object like ReadObject()
+    bool ReadObjectInto(TObject* obj)
+    {
+        InitMap();
+        UInt_t startpos = Length();
+        UInt_t tag = 0;
+        TClass* cl = ReadClass(obj->IsA(), &tag);
+        if (cl != obj->IsA())
+        {
+            // null object, reference or object of another class
+            return false;
+        }
+        obj->Streamer(*this);
+        CheckByteCount(startpos, tag, cl);
+        return true;
+    }
 };
 
+// Process wide pool of TMessage objects for the serializer. The transport returns them through
+// free_tmessage (possibly from its own threads), their buffers stay allocated for the next message.
+class FairTMessagePool
+{
+  public:
+    static FairTMessagePool& Instance()
+    {
+        // never destroyed, messages may come back after the device is gone
+        static FairTMessagePool* pool = new FairTMessagePool();
+        return *pool;
+    }
+
+    TMessage* Get()
+    {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            if (!fFree.empty())
+            {
+                TMessage* tm = fFree.back();
+                fFree.pop_back();
+                tm->Reset();
+                return tm;
+            }
+        }
+        return new TMessage(kMESS_OBJECT);
+    }
+
+    void Release(TMessage* tm)
+    {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            if (fFree.size() < fMaxCached)
+            {
+                fFree.push_back(tm);
+                return;
+            }
+        }
+        delete tm;
+    }
+
+    void SetMaxCached(size_t maxCached)
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fMaxCached = maxCached;
+    }
+
+  private:
+    FairTMessagePool()
+        : fMutex()
+        , fFree()
+        , fMaxCached(64)
+    {}
+
+    std::mutex fMutex;
+    std::vector<TMessage*> fFree;
+    size_t fMaxCached;
+
+    FairTMessagePool(const FairTMessagePool&);
+    FairTMessagePool& operator=(const FairTMessagePool&);
+};
 
 // helper function to clean up the object holding the data after it is transported.
-void free_tmessage (void *data, void *hint)
+inline void free_tmessage (void *data, void *hint)
 {
-    delete (TMessage*)hint;
+    FairTMessagePool::Instance().Release(static_cast<TMessage*>(hint));
 }
 
 //template <typename TPayload>
@@ -62,10 +142,10 @@ class RootSerializer
 
     virtual void DoSerialization(TClonesArray* array)
     {
-        TMessage* tm = new TMessage(kMESS_OBJECT);
+        TMessage* tm = FairTMessagePool::Instance().Get();
         tm->WriteObject(array);
-        // fMessage = fTransportFactory->CreateMessage(tm->Buffer(), tm->BufferSize(), free_tmessage, tm);
-        fMessage->Rebuild(tm->Buffer(), tm->BufferSize(), free_tmessage, tm);
+        // the buffer of a recycled TMessage can be larger than the serialized data, send only the written part
+        fMessage->Rebuild(tm->Buffer(), tm->Length(), free_tmessage, tm);
     }
 
     FairMQMessage* SerializeMsg(TClonesArray* array)
@@ -98,28 +178,48 @@ class RootDeSerializer
         : fContainer(nullptr)
         , fMessage(nullptr)
         , fNumInput(0)
+        , fOwner(false)
     {}
 
     ~RootDeSerializer()
-    {}
+    {
+        DeleteContainer();
+    }
 
     void InitContainer(const std::string &ClassName)
     {
+        DeleteContainer();
         fContainer = new TClonesArray(ClassName.c_str());
+        fOwner = true;
     }
 
+    /// the array stays owned by the caller and is filled again by every DeserializeMsg()
     void InitContainer(TClonesArray* array)
     {
+        DeleteContainer();
         fContainer = array;
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////
     // deserialize
 
+    /// Streams the message into the existing container, its objects are reused.
+    /// Without a container the first message creates one.
     virtual void DoDeSerialization(FairMQMessage* msg)
     {
         FairTMessage tm(msg->GetData(), msg->GetSize());
-        fContainer  = (TClonesArray*)(tm.ReadObject(tm.GetClass()));
+        if (!fContainer)
+        {
+            fContainer = static_cast<TClonesArray*>(tm.ReadObject(tm.GetClass()));
+            fOwner = true;
+            return;
+        }
+
+        fContainer->Clear("C");
+        if (!tm.ReadObjectInto(fContainer))
+        {
+            MQLOG(ERROR) << "RootDeSerializer::DoDeSerialization(): message does not contain a TClonesArray";
+        }
     }
 
     TClonesArray* DeserializeMsg(FairMQMessage* msg)
@@ -143,6 +243,17 @@ class RootDeSerializer
     TClonesArray* fContainer;
     FairMQMessage* fMessage;
     int fNumInput;
+    bool fOwner;
+
+    void DeleteContainer()
+    {
+        if (fOwner)
+        {
+            delete fContainer;
+            fOwner = false;
+        }
+        fContainer = nullptr;
+    }
 };
 
 #endif /* ROOTBASECLASSSERIALIZER_H */
@@ -14,6 +14,9 @@
 
 #include "FairLink.h"
 #include "FairRootManager.h"
+#include "FairLogger.h"
+
+#include <climits>                      // for SHRT_MIN, SHRT_MAX
 
 ClassImp(FairLink);
 
@@ -79,3 +82,12 @@ FairLink::~FairLink()
 {
   // TODO Auto-generated destructor stub
 }
+
+Short_t FairCompactLink::ToShort(Int_t value)
+{
+  if (value < SHRT_MIN || value > SHRT_MAX) {
+    LOG(FATAL) << "FairCompactLink: file id or type " << value
+               << " does not fit into 16 bit" << FairLogger::endl;
+  }
+  return static_cast<Short_t>(value);
+}
@@ -111,4 +111,37 @@ class FairLink : public TObject
 
 };
 
+/**
+ * Packed form of a FairLink as it is stored inside FairMultiLinkedData.
+ * File id and type (branch id) are kept as 16 bit values, so one link
+ * needs 16 bytes instead of a full TObject. The ordering is the same as
+ * the one of FairLink. A file id or type outside of the 16 bit range is
+ * a fatal error.
+ */
+struct FairCompactLink
+{
+  FairCompactLink() : fEntry(-1), fIndex(-1), fWeight(1.), fFile(-1), fType(-1) {}
+  FairCompactLink(const FairLink& link)
+    : fEntry(link.GetEntry()), fIndex(link.GetIndex()), fWeight(link.GetWeight()),
+      fFile(ToShort(link.GetFile())), fType(ToShort(link.GetType())) {}
+
+  FairLink ToLink() const { return FairLink(fFile, fEntry, fType, fIndex, fWeight); }
+
+  bool operator<(const FairCompactLink& link) const {
+    if (fFile != -1 && link.fFile != -1 && fFile != link.fFile) { return fFile < link.fFile; }
+    if (fEntry != -1 && link.fEntry != -1 && fEntry != link.fEntry) { return fEntry < link.fEntry; }
+    if (fType != link.fType) { return fType < link.fType; }
+    return fIndex < link.fIndex;
+  }
+
+  /** Checks that value fits into a Short_t before it is narrowed */
+  static Short_t ToShort(Int_t value);
+
+  Int_t fEntry;
+  Int_t fIndex;
+  Float_t fWeight;
+  Short_t fFile;
+  Short_t fType;
+};
+
 #endif /* FAIRLINK_H_ */
@@ -20,8 +20,7 @@
 
 #include "TClonesArray.h"               // for TClonesArray
 
-#include <algorithm>                    // for find
-#include <iterator>                     // for distance
+#include <algorithm>                    // for lower_bound, sort
 
 ClassImp(FairMultiLinkedData);
 
@@ -38,7 +37,7 @@ FairMultiLinkedData::FairMultiLinkedData()
 
 FairMultiLinkedData::FairMultiLinkedData(std::set<FairLink> links, Bool_t persistanceCheck)
   :TObject(),
-   fLinks(links),
+   fLinks(links.begin(), links.end()),
    fPersistanceCheck(persistanceCheck),
    fInsertHistory(kTRUE),
    fVerbose(0),
@@ -71,12 +70,19 @@ FairMultiLinkedData::FairMultiLinkedData(Int_t dataType, std::vector<Int_t> link
   SimpleAddLinks(fileId, evtId, dataType, links, bypass, mult);
 }
 
+std::set<FairLink> FairMultiLinkedData::GetLinks() const
+{
+  std::set<FairLink> links;
+  for (std::vector<FairCompactLink>::const_iterator it = fLinks.begin(); it != fLinks.end(); it++) {
+    links.insert(links.end(), it->ToLink());
+  }
+  return links;
+}
+
 FairLink FairMultiLinkedData::GetLink(Int_t pos) const
 {
-  if (pos < (Int_t)fLinks.size()) {
-    std::set<FairLink>::iterator it = fLinks.begin();
-    for (int i = 0; i < pos; i++) { it++; }
-    return *it;
+  if (pos >= 0 && pos < (Int_t)fLinks.size()) {
+    return fLinks[pos].ToLink();
   } else {
     std::cout << "-E- FairMultiLinkedData:GetLink(pos) pos " << pos << " outside range " << fLinks.size() << std::endl;
     return FairLink();
@@ -101,9 +107,8 @@ void FairMultiLinkedData::SetLink(FairLink link, Bool_t bypass, Float_t mult)
 
 void FairMultiLinkedData::AddLinks(FairMultiLinkedData links, Float_t mult)
 {
-  std::set<FairLink> myLinks = links.GetLinks();
-  for (std::set<FairLink>::iterator it = myLinks.begin(); it != myLinks.end(); it++) {
-    FairLink myLink = *it;
+  for (std::vector<FairCompactLink>::const_iterator it = links.fLinks.begin(); it != links.fLinks.end(); it++) {
+    FairLink myLink = it->ToLink();
     myLink.SetWeight(myLink.GetWeight()*mult);
     AddLink(myLink);
   }
@@ -128,7 +133,7 @@ void FairMultiLinkedData::AddLink(FairLink link, Bool_t bypass, Float_t mult)
 
   if (fPersistanceCheck == kFALSE ||
       link.GetIndex() < 0 ||
-      ioman->CheckBranch(ioman->GetBranchName(link.GetType())) == 0) {
+      ioman->CheckBranchId(link.GetType()) == 0) {
     InsertLink(link);
     if (fInsertHistory == kTRUE)
     	InsertHistory(link);
@@ -137,9 +142,9 @@ void FairMultiLinkedData::AddLink(FairLink link, Bool_t bypass, Float_t mult)
 
   if (bypass == kFALSE) {
     if (fVerbose > 1) {
-      std::cout << "BranchName " << ioman->GetBranchName(link.GetType()) << " checkStatus: " <<  ioman->CheckBranch(ioman->GetBranchName(link.GetType())) << std::endl;
+      std::cout << "BranchName " << ioman->GetBranchName(link.GetType()) << " checkStatus: " <<  ioman->CheckBranchId(link.GetType()) << std::endl;
     }
-    if (link.GetType() > ioman->GetBranchId("MCTrack") && ioman->CheckBranch(ioman->GetBranchName(link.GetType())) != 1) {
+    if (link.GetType() > ioman->GetMCTrackBranchId() && ioman->CheckBranchId(link.GetType()) != 1) {
       if (fVerbose > 1) {
         std::cout << "BYPASS!" << std::endl;
       }
@@ -149,7 +154,7 @@ void FairMultiLinkedData::AddLink(FairLink link, Bool_t bypass, Float_t mult)
 
   if (bypass == kTRUE) {
     //FairRootManager* ioman = FairRootManager::Instance();
-    if (link.GetType() > ioman->GetBranchId("MCTrack")) {
+    if (link.GetType() > ioman->GetMCTrackBranchId()) {
       TClonesArray* array = (TClonesArray*)ioman->GetObject(ioman->GetBranchName(link.GetType()));
       if (fVerbose > 1) {
         std::cout << "Entries in " << ioman->GetBranchName(link.GetType()) << " Array: " << array->GetEntries() << std::endl;
@@ -176,20 +181,26 @@ void FairMultiLinkedData::AddLink(FairLink link, Bool_t bypass, Float_t mult)
 
 void FairMultiLinkedData::InsertLink(FairLink link)
 {
-  if (FairLinkManager::Instance()->IsIgnoreType(link.GetType())){
+  FairLinkManager* linkManager = FairLinkManager::Instance();
+  if (linkManager != 0 && linkManager->IsIgnoreType(link.GetType())){
 	return;
   }
+  InsertCompactLink(link, kTRUE);
+}
 
-  std::set<FairLink>::iterator it = fLinks.find(link);
-  if (it != fLinks.end()) {
-    FairLink myTempLink = *it;
-    myTempLink.AddWeight(link.GetWeight());
-    fLinks.erase(it);
-    fLinks.insert(myTempLink);
-  } else {
-    fLinks.insert(link);
+void FairMultiLinkedData::InsertCompactLink(const FairCompactLink& link, Bool_t addWeight)
+{
+  std::vector<FairCompactLink>::iterator it = std::lower_bound(fLinks.begin(), fLinks.end(), link);
+  if (it != fLinks.end() && !(link < *it)) {
+    if (addWeight) {
+      it->fWeight += link.fWeight;
+    }
+    return;
   }
-  return;
+  if (fLinks.capacity() == 0) {
+    fLinks.reserve(4); // most objects have only a few links
+  }
+  fLinks.insert(it, link);
 }
 
 void FairMultiLinkedData::InsertHistory(FairLink link)
@@ -202,7 +213,7 @@ void FairMultiLinkedData::InsertHistory(FairLink link)
 
         if (link.GetType() < 0)
                 return;
-        if (link.GetType() == ioman->GetBranchId("MCTrack"))
+        if (link.GetType() == ioman->GetMCTrackBranchId())
                 return;
         if(ioman->GetBranchName(link.GetType()).Contains("."))
         	return;
@@ -221,11 +232,11 @@ void FairMultiLinkedData::InsertHistory(FairLink link)
                 }
         }
         if (pointerToLinks != 0){
-                std::set<FairLink> linkSet = pointerToLinks->GetLinks();
-                for (std::set<FairLink>::const_iterator iter = linkSet.begin(); iter!= linkSet.end(); iter++){
+                std::vector<FairCompactLink> linkList = pointerToLinks->fLinks;
+                for (std::vector<FairCompactLink>::const_iterator iter = linkList.begin(); iter!= linkList.end(); iter++){
                 	if (fVerbose > 1)
-                		std::cout << "FairMultiLinkedData::InsertHistory inserting " << *iter << std::endl;
-                    InsertLink(*iter);
+                		std::cout << "FairMultiLinkedData::InsertHistory inserting " << iter->ToLink() << std::endl;
+                    InsertLink(iter->ToLink());
                 }
         }
 
@@ -241,9 +252,10 @@ Bool_t FairMultiLinkedData::IsLinkInList(Int_t type, Int_t index)
 
 Int_t FairMultiLinkedData::LinkPosInList(Int_t type, Int_t index)
 {
-  std::set<FairLink>::iterator it = std::find(fLinks.begin(), fLinks.end(), FairLink(type, index));
-  if (it != fLinks.end()) {
-    return std::distance(fLinks.begin(), it);
+  for (UInt_t i = 0; i < fLinks.size(); i++) {
+    if (fLinks[i].fType == type && fLinks[i].fIndex == index) {
+      return i;
+    }
   }
   return -1;
 }
@@ -260,10 +272,9 @@ void FairMultiLinkedData::DeleteLink(Int_t type, Int_t index)
 FairMultiLinkedData FairMultiLinkedData::GetLinksWithType(Int_t type) const
 {
   FairMultiLinkedData result;
-  for (std::set<FairLink>::iterator it = fLinks.begin(); it != fLinks.end(); it++) {
-    if (it->GetType() == type) {
-      FairLink myLink = *it;
-      result.InsertLink(myLink);
+  for (std::vector<FairCompactLink>::const_iterator it = fLinks.begin(); it != fLinks.end(); it++) {
+    if (it->fType == type) {
+      result.InsertLink(it->ToLink());
     }
   }
   return result;
@@ -274,7 +285,7 @@ bool LargerWeight(FairLink val1, FairLink val2){
 }
 
 std::vector<FairLink> FairMultiLinkedData::GetSortedMCTracks(){
-	FairMultiLinkedData mcLinks = GetLinksWithType(FairRootManager::Instance()->GetBranchId("MCTrack"));
+	FairMultiLinkedData mcLinks = GetLinksWithType(FairRootManager::Instance()->GetMCTrackBranchId());
 	std::set<FairLink> mcSet = mcLinks.GetLinks();
 	std::vector<FairLink> mcVector(mcSet.begin(), mcSet.end());
 	//std::sort(begin(mcVector), end(mcVector), [](FairLink& val1, FairLink& val2){ return val1.GetWeight() > val2.GetWeight();});
@@ -286,7 +297,7 @@ TObject* FairMultiLinkedData::GetData(FairLink& myLink)
 {
   FairRootManager* ioman = FairRootManager::Instance();
   TString branchName = ioman->GetBranchName(myLink.GetType());
-  if (ioman->CheckBranch(branchName) > 0) {
+  if (ioman->CheckBranchId(myLink.GetType()) > 0) {
     TClonesArray* myArray = (TClonesArray*)ioman->GetObject(branchName);
     if (myArray != 0) {
       if (myArray->GetEntries() > myLink.GetIndex()) {
@@ -300,33 +311,21 @@ TObject* FairMultiLinkedData::GetData(FairLink& myLink)
 
 void FairMultiLinkedData::SetAllWeights(Double_t weight)
 {
-  std::set<FairLink> tempLinks;
-  for (std::set<FairLink>::iterator it = fLinks.begin(); it != fLinks.end(); it++) {
-    FairLink tempLink = *it;
-    tempLink.SetWeight(weight);
-    tempLinks.insert(tempLink);
+  for (std::vector<FairCompactLink>::iterator it = fLinks.begin(); it != fLinks.end(); it++) {
+    it->fWeight = weight;
   }
-  fLinks = tempLinks;
 }
 
 void FairMultiLinkedData::AddAllWeights(Double_t weight)
 {
-  std::set<FairLink> tempLinks;
-  for (std::set<FairLink>::iterator it = fLinks.begin(); it != fLinks.end(); it++) {
-    FairLink tempLink = *it;
-    tempLink.SetWeight(weight + tempLink.GetWeight());
-    tempLinks.insert(tempLink);
+  for (std::vector<FairCompactLink>::iterator it = fLinks.begin(); it != fLinks.end(); it++) {
+    it->fWeight += weight;
   }
-  fLinks = tempLinks;
 }
 
 void FairMultiLinkedData::MultiplyAllWeights(Double_t weight)
 {
-  std::set<FairLink> tempLinks;
-  for (std::set<FairLink>::iterator it = fLinks.begin(); it != fLinks.end(); it++) {
-    FairLink tempLink = *it;
-    tempLink.SetWeight(weight * tempLink.GetWeight());
-    tempLinks.insert(tempLink);
+  for (std::vector<FairCompactLink>::iterator it = fLinks.begin(); it != fLinks.end(); it++) {
+    it->fWeight *= weight;
   }
-  fLinks = tempLinks;
 }
@@ -37,7 +37,7 @@ class FairMultiLinkedData : public  TObject
 
     virtual ~FairMultiLinkedData() {};
 
-    virtual std::set<FairLink>    GetLinks() const {    return fLinks;}           ///< returns stored links as FairLinks
+    virtual std::set<FairLink>    GetLinks() const;                                ///< returns stored links as FairLinks
     virtual FairLink		GetEntryNr() const { return fEntryNr;}				///< gives back the entryNr
     virtual Int_t           GetNLinks() const { return fLinks.size(); }       ///< returns the number of stored links
     virtual FairLink        GetLink(Int_t pos) const;                 ///< returns the FairLink at the given position
@@ -77,7 +77,7 @@ class FairMultiLinkedData : public  TObject
     virtual void DeleteLink(Int_t type, Int_t index);                               ///< Deletes a link ouf of fLinks
 
     virtual void Reset() {ResetLinks();}
-    virtual void ResetLinks() {fLinks.clear();}                                    ///< Clears fLinks
+    virtual void ResetLinks() {fLinks.clear();}                                    ///< Clears fLinks, the allocated memory is kept for the next links
 
 
     std::ostream& Print(std::ostream& out = std::cout) const
@@ -97,7 +97,7 @@ class FairMultiLinkedData : public  TObject
     }                                                     ///< Output
 
   protected:
-    std::set<FairLink> fLinks;
+    std::vector<FairCompactLink> fLinks; ///< links sorted by the ordering of FairLink
     FairLink fEntryNr;
     Bool_t fPersistanceCheck; //!
     Bool_t fInsertHistory; //!
@@ -105,13 +105,16 @@ class FairMultiLinkedData : public  TObject
 
     virtual void SimpleAddLinks(Int_t fileId, Int_t evtId, Int_t dataType, std::vector<Int_t> links, Bool_t bypass, Float_t mult) {
       for (UInt_t i = 0; i < links.size(); i++) {
-        fLinks.insert(FairLink(fileId, evtId, dataType, links[i]));
+        InsertCompactLink(FairLink(fileId, evtId, dataType, links[i]), kFALSE);
       }
     }
+    /** Insert a link at its sorted position. If an equal link is already stored
+     *  its weight is increased by the weight of link if addWeight is kTRUE.*/
+    void InsertCompactLink(const FairCompactLink& link, Bool_t addWeight);
     Int_t fDefaultType;
 
 
-    ClassDef(FairMultiLinkedData, 4);
+    ClassDef(FairMultiLinkedData, 5);
 };
 
 /**\fn virtual void FairMultiLinkedData::SetLinks(Int_t type, std::vector<Int_t> links)
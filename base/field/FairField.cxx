@@ -64,5 +64,23 @@ void FairField::GetFieldValue(const Double_t point[3], Double_t* bField)
   bField[2] = GetBz(point[0], point[1], point[2]);
 }
 
+// -------------------------------------------------------------------------
+void FairField::GetFieldValues(Int_t n, const Double_t* x, const Double_t* y, const Double_t* z,
+                               Double_t* bx, Double_t* by, Double_t* bz)
+{
+  Double_t point[3];
+  Double_t bField[3];
+  for (Int_t i = 0; i < n; i++) {
+    point[0] = x[i];
+    point[1] = y[i];
+    point[2] = z[i];
+    GetFieldValue(point, bField);
+    bx[i] = bField[0];
+    by[i] = bField[1];
+    bz[i] = bField[2];
+  }
+}
+// -------------------------------------------------------------------------
+
 
 ClassImp(FairField)
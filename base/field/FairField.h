@@ -127,6 +127,17 @@ class FairField : public TVirtualMagField
     void Field(const Double_t point[3], Double_t* B) {GetFieldValue(point,B);}
 
 
+    /** Get magnetic field for many points at once, e.g. for the batch
+     ** propagation in FairRKPropagator. The default calls GetFieldValue
+     ** for every point, field maps should override it.
+     ** @param n                Number of points
+     ** @param x,y,z            Coordinates [cm], arrays of length n
+     ** @param bx,by,bz (return) Field components [kG], arrays of length n
+     **/
+    virtual void GetFieldValues(Int_t n, const Double_t* x, const Double_t* y, const Double_t* z,
+                                Double_t* bx, Double_t* by, Double_t* bz);
+
+
     /** Screen output. To be implemented in the concrete class. **/
     virtual void  Print(Option_t* option = "") const {;}
     virtual void GetBxyz(const Double_t point[3], Double_t* bField) {LOG(WARNING)<<"FairField::GetBxyz Should be implemented in User class"<<FairLogger::endl;}
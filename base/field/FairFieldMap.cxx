@@ -0,0 +1,574 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+// -------------------------------------------------------------------------
+// -----                    FairFieldMap source file                   -----
+// -------------------------------------------------------------------------
+
+// Binary map file (all numbers in the byte order of the writer):
+//
+//   MapHeader     magic "FAIRFLD", format version, byte order, value size,
+//                 folded axes, grid, signs, position of the nodes
+//   nodes         Bx, By, Bz per node as float or double, the node (ix,iy,iz)
+//                 at index (ix*ny + iy)*nz + iz
+//
+// The file is mapped into memory and the nodes are used in place.
+
+#include "FairFieldMap.h"
+
+#include <fcntl.h>                      // for open, O_RDONLY
+#include <string.h>                     // for memcmp, memcpy, memset
+#include <sys/mman.h>                   // for mmap, munmap
+#include <sys/stat.h>                   // for fstat
+#include <unistd.h>                     // for close
+#include <fstream>                      // for ofstream
+#include <iomanip>                      // for setw
+
+using std::ios;
+using std::setw;
+
+namespace
+{
+
+const char kMagic[8]= {'F','A','I','R','F','L','D','\0'};
+const UInt_t kFormatVersion=1;
+const UInt_t kByteOrder=0x01020304;
+
+struct MapHeader {
+  char fMagic[8];
+  UInt_t fFormatVersion;
+  UInt_t fByteOrder;        // kByteOrder in the byte order of the writer
+  UInt_t fValueSize;        // 4 for float, 8 for double
+  Int_t fSymmetry;
+  Int_t fN[3];
+  Int_t fReserved;
+  Double_t fMin[3];
+  Double_t fMax[3];
+  Double_t fSign[3][3];
+  ULong64_t fDataOffset;
+};
+
+}
+
+// grid geometry prepared for the interpolation
+struct FairFieldMapGrid {
+  Double_t fMin[3];
+  Double_t fInvStep[3];     // 1 / node distance
+  Double_t fLast[3];        // index of the last node
+  Int_t fLastCell[3];       // index of the last cell
+  Long64_t fStride[3];      // distance of neighbouring nodes in values
+  Double_t fFold[3];        // 1 for folded axes, 0 otherwise
+  Double_t fSignM1[3][3];   // sign - 1 of the components for folded axes
+};
+
+namespace
+{
+
+// Trilinear interpolation without branches: the coordinates are folded
+// and clamped to the grid with arithmetic and min/max, points outside of
+// the grid get the weight 0.
+template <class T>
+inline void Interpolate(const FairFieldMapGrid& g, const T* data, Double_t scale,
+                        Double_t x, Double_t y, Double_t z, Double_t* bField)
+{
+  const Double_t p[3] = {x, y, z};
+  Double_t factor[3] = {scale, scale, scale};
+  Double_t inside = 1.;
+  Double_t t[3];
+  Long64_t offset = 0;
+  for (Int_t a = 0; a < 3; a++) {
+    Double_t mirrored = g.fFold[a] * (p[a] < 0.);
+    Double_t u = (p[a] - 2. * mirrored * p[a] - g.fMin[a]) * g.fInvStep[a];
+    factor[0] *= 1. + mirrored * g.fSignM1[a][0];
+    factor[1] *= 1. + mirrored * g.fSignM1[a][1];
+    factor[2] *= 1. + mirrored * g.fSignM1[a][2];
+    inside *= (u >= 0.) * (u <= g.fLast[a]);
+    u = u > 0. ? u : 0.;
+    u = u < g.fLast[a] ? u : g.fLast[a];
+    Int_t i = static_cast<Int_t>(u);
+    i = i < g.fLastCell[a] ? i : g.fLastCell[a];
+    t[a] = u - i;
+    offset += i * g.fStride[a];
+  }
+
+  const T* p000 = data + offset;
+  const T* p001 = p000 + g.fStride[2];
+  const T* p010 = p000 + g.fStride[1];
+  const T* p011 = p010 + g.fStride[2];
+  const T* p100 = p000 + g.fStride[0];
+  const T* p101 = p100 + g.fStride[2];
+  const T* p110 = p100 + g.fStride[1];
+  const T* p111 = p110 + g.fStride[2];
+  for (Int_t k = 0; k < 3; k++) {
+    Double_t c00 = p000[k] + t[2] * (p001[k] - p000[k]);
+    Double_t c01 = p010[k] + t[2] * (p011[k] - p010[k]);
+    Double_t c10 = p100[k] + t[2] * (p101[k] - p100[k]);
+    Double_t c11 = p110[k] + t[2] * (p111[k] - p110[k]);
+    Double_t c0 = c00 + t[1] * (c01 - c00);
+    Double_t c1 = c10 + t[1] * (c11 - c10);
+    bField[k] = (c0 + t[0] * (c1 - c0)) * factor[k] * inside;
+  }
+}
+
+}
+
+
+
+// -----   Default constructor   -------------------------------------------
+FairFieldMap::FairFieldMap()
+  : FairField(),
+    fFileName(""),
+    fScale(1.),
+    fUseFloat(kTRUE),
+    fSymmetry(0),
+    fFloatData(0),
+    fDoubleData(0),
+    fBuffer(0),
+    fMapping(0),
+    fMappingSize(0),
+    fGrid(new FairFieldMapGrid)
+{
+  fType = 2;
+  for (Int_t a = 0; a < 3; a++) {
+    fN[a] = 0;
+    fMin[a] = fMax[a] = 0.;
+    for (Int_t k = 0; k < 3; k++) { fSign[a][k] = 1.; }
+  }
+  UpdateGrid();
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Constructor with binary file   ----------------------------------
+FairFieldMap::FairFieldMap(const char* fileName)
+  : FairField("FairFieldMap"),
+    fFileName(""),
+    fScale(1.),
+    fUseFloat(kTRUE),
+    fSymmetry(0),
+    fFloatData(0),
+    fDoubleData(0),
+    fBuffer(0),
+    fMapping(0),
+    fMappingSize(0),
+    fGrid(new FairFieldMapGrid)
+{
+  fType = 2;
+  for (Int_t a = 0; a < 3; a++) {
+    fN[a] = 0;
+    fMin[a] = fMax[a] = 0.;
+    for (Int_t k = 0; k < 3; k++) { fSign[a][k] = 1.; }
+  }
+  UpdateGrid();
+  ReadFile(fileName);
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Constructor for a map in memory   -------------------------------
+FairFieldMap::FairFieldMap(const char* name,
+                           Int_t nx, Double_t xmin, Double_t xmax,
+                           Int_t ny, Double_t ymin, Double_t ymax,
+                           Int_t nz, Double_t zmin, Double_t zmax,
+                           Bool_t useFloat)
+  : FairField(name),
+    fFileName(""),
+    fScale(1.),
+    fUseFloat(useFloat),
+    fSymmetry(0),
+    fFloatData(0),
+    fDoubleData(0),
+    fBuffer(0),
+    fMapping(0),
+    fMappingSize(0),
+    fGrid(new FairFieldMapGrid)
+{
+  fType = 2;
+  Int_t n[3] = {nx, ny, nz};
+  Double_t min[3] = {xmin, ymin, zmin};
+  Double_t max[3] = {xmax, ymax, zmax};
+  Bool_t valid = kTRUE;
+  for (Int_t a = 0; a < 3; a++) {
+    fN[a] = n[a];
+    fMin[a] = min[a];
+    fMax[a] = max[a];
+    for (Int_t k = 0; k < 3; k++) { fSign[a][k] = 1.; }
+    if (n[a] < 2 || !(max[a] > min[a])) { valid = kFALSE; }
+  }
+  if (!valid) {
+    LOG(ERROR) << "FairFieldMap: " << name << " needs at least two nodes and a range > 0 per axis"
+               << FairLogger::endl;
+    for (Int_t a = 0; a < 3; a++) { fN[a] = 0; }
+  } else {
+    Long64_t nValues = 3 * Long64_t(nx) * ny * nz;
+    if (fUseFloat) {
+      Float_t* values = new Float_t[nValues];
+      memset(values, 0, nValues * sizeof(Float_t));
+      fBuffer = reinterpret_cast<Char_t*>(values);
+      fFloatData = values;
+    } else {
+      Double_t* values = new Double_t[nValues];
+      memset(values, 0, nValues * sizeof(Double_t));
+      fBuffer = reinterpret_cast<Char_t*>(values);
+      fDoubleData = values;
+    }
+  }
+  UpdateGrid();
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Destructor   ----------------------------------------------------
+FairFieldMap::~FairFieldMap()
+{
+  Reset();
+  delete fGrid;
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Public method Init   --------------------------------------------
+void FairFieldMap::Init()
+{
+  // a map read from a ROOT file only knows the name of the binary file
+  if (!fFloatData && !fDoubleData && fFileName.Length() > 0) {
+    ReadFile(fFileName.Data());
+  }
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Public method ReadFile   ----------------------------------------
+Bool_t FairFieldMap::ReadFile(const char* fileName)
+{
+  Reset();
+  Int_t file = ::open(fileName, O_RDONLY);
+  struct stat st;
+  if (file < 0 || fstat(file, &st) != 0) {
+    LOG(ERROR) << "FairFieldMap: could not open " << fileName << FairLogger::endl;
+    if (file >= 0) { ::close(file); }
+    return kFALSE;
+  }
+  ULong64_t size = st.st_size;
+  void* mapping = 0;
+  if (size >= sizeof(MapHeader)) {
+    mapping = mmap(0, size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (mapping == MAP_FAILED) { mapping = 0; }
+  }
+  // the mapping stays valid after the file is closed
+  ::close(file);
+
+  const MapHeader* header = static_cast<const MapHeader*>(mapping);
+  Bool_t valid = header && memcmp(header->fMagic, kMagic, sizeof(kMagic)) == 0
+                 && header->fFormatVersion == kFormatVersion && header->fByteOrder == kByteOrder
+                 && (header->fValueSize == sizeof(Float_t) || header->fValueSize == sizeof(Double_t))
+                 && header->fDataOffset % sizeof(Double_t) == 0
+                 && header->fDataOffset >= sizeof(MapHeader) && header->fDataOffset <= size;
+  // the nodes must fit into the file, each axis is checked against the nodes
+  // left for it, so the product of the numbers cannot overflow
+  ULong64_t nNodes = valid ? (size - header->fDataOffset) / (3 * header->fValueSize) : 0;
+  for (Int_t a = 0; valid && a < 3; a++) {
+    valid = header->fN[a] >= 2 && ULong64_t(header->fN[a]) <= nNodes && header->fMax[a] > header->fMin[a];
+    if (valid) { nNodes /= header->fN[a]; }
+  }
+  if (!valid) {
+    LOG(ERROR) << "FairFieldMap: " << fileName << " is not a field map of format version "
+               << kFormatVersion << " written with the byte order of this machine" << FairLogger::endl;
+    if (mapping) { munmap(mapping, size); }
+    return kFALSE;
+  }
+
+  fFileName = fileName;
+  fUseFloat = (header->fValueSize == sizeof(Float_t));
+  fSymmetry = header->fSymmetry;
+  for (Int_t a = 0; a < 3; a++) {
+    fN[a] = header->fN[a];
+    fMin[a] = header->fMin[a];
+    fMax[a] = header->fMax[a];
+    for (Int_t k = 0; k < 3; k++) { fSign[a][k] = header->fSign[a][k]; }
+  }
+  fMapping = mapping;
+  fMappingSize = size;
+  const char* data = static_cast<const char*>(mapping) + header->fDataOffset;
+  if (fUseFloat) { fFloatData = reinterpret_cast<const Float_t*>(data); }
+  else { fDoubleData = reinterpret_cast<const Double_t*>(data); }
+  UpdateGrid();
+  return kTRUE;
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Public method WriteFile   ---------------------------------------
+Bool_t FairFieldMap::WriteFile(const char* fileName) const
+{
+  if (!fFloatData && !fDoubleData) {
+    LOG(ERROR) << "FairFieldMap: no nodes to write to " << fileName << FairLogger::endl;
+    return kFALSE;
+  }
+  MapHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.fMagic, kMagic, sizeof(kMagic));
+  header.fFormatVersion = kFormatVersion;
+  header.fByteOrder = kByteOrder;
+  header.fValueSize = fUseFloat ? sizeof(Float_t) : sizeof(Double_t);
+  header.fSymmetry = fSymmetry;
+  for (Int_t a = 0; a < 3; a++) {
+    header.fN[a] = fN[a];
+    header.fMin[a] = fMin[a];
+    header.fMax[a] = fMax[a];
+    for (Int_t k = 0; k < 3; k++) { header.fSign[a][k] = fSign[a][k]; }
+  }
+  header.fDataOffset = sizeof(header);
+
+  std::ofstream file(fileName, ios::out | ios::binary | ios::trunc);
+  if (!file.is_open()) {
+    LOG(ERROR) << "FairFieldMap: could not open " << fileName << FairLogger::endl;
+    return kFALSE;
+  }
+  Long64_t nValues = 3 * Long64_t(fN[0]) * fN[1] * fN[2];
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (fUseFloat) { file.write(reinterpret_cast<const char*>(fFloatData), nValues * sizeof(Float_t)); }
+  else { file.write(reinterpret_cast<const char*>(fDoubleData), nValues * sizeof(Double_t)); }
+  file.close();
+  if (!file) {
+    LOG(ERROR) << "FairFieldMap: error writing " << fileName << FairLogger::endl;
+    return kFALSE;
+  }
+  return kTRUE;
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Public method SetSymmetry   -------------------------------------
+void FairFieldMap::SetSymmetry(Int_t axis, Int_t signBx, Int_t signBy, Int_t signBz)
+{
+  if (axis < 0 || axis > 2) {
+    LOG(ERROR) << "FairFieldMap::SetSymmetry: no axis " << axis << FairLogger::endl;
+    return;
+  }
+  if (fMin[axis] < 0.) {
+    LOG(WARNING) << "FairFieldMap::SetSymmetry: the grid starts at " << fMin[axis]
+                 << " cm, the nodes below 0 are never used" << FairLogger::endl;
+  }
+  fSymmetry |= (1 << axis);
+  fSign[axis][0] = signBx < 0 ? -1. : 1.;
+  fSign[axis][1] = signBy < 0 ? -1. : 1.;
+  fSign[axis][2] = signBz < 0 ? -1. : 1.;
+  UpdateGrid();
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Public method SetNode   -----------------------------------------
+void FairFieldMap::SetNode(Int_t ix, Int_t iy, Int_t iz, Double_t bx, Double_t by, Double_t bz)
+{
+  if (!fBuffer) {
+    LOG(ERROR) << "FairFieldMap::SetNode: the nodes of a mapped file cannot be changed" << FairLogger::endl;
+    return;
+  }
+  if (ix < 0 || ix >= fN[0] || iy < 0 || iy >= fN[1] || iz < 0 || iz >= fN[2]) {
+    LOG(ERROR) << "FairFieldMap::SetNode: no node (" << ix << ", " << iy << ", " << iz << ")"
+               << FairLogger::endl;
+    return;
+  }
+  Long64_t index = 3 * ((Long64_t(ix) * fN[1] + iy) * fN[2] + iz);
+  if (fUseFloat) {
+    Float_t* values = reinterpret_cast<Float_t*>(fBuffer) + index;
+    values[0] = bx;
+    values[1] = by;
+    values[2] = bz;
+  } else {
+    Double_t* values = reinterpret_cast<Double_t*>(fBuffer) + index;
+    values[0] = bx;
+    values[1] = by;
+    values[2] = bz;
+  }
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Public method Fill   --------------------------------------------
+void FairFieldMap::Fill(FairField* field)
+{
+  Double_t step[3];
+  for (Int_t a = 0; a < 3; a++) {
+    step[a] = (fMax[a] - fMin[a]) / (fN[a] - 1);
+  }
+  Double_t point[3];
+  Double_t bField[3];
+  for (Int_t ix = 0; ix < fN[0]; ix++) {
+    point[0] = fMin[0] + ix * step[0];
+    for (Int_t iy = 0; iy < fN[1]; iy++) {
+      point[1] = fMin[1] + iy * step[1];
+      for (Int_t iz = 0; iz < fN[2]; iz++) {
+        point[2] = fMin[2] + iz * step[2];
+        field->GetFieldValue(point, bField);
+        SetNode(ix, iy, iz, bField[0], bField[1], bField[2]);
+      }
+    }
+  }
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Get x component of the field   ----------------------------------
+Double_t FairFieldMap::GetBx(Double_t x, Double_t y, Double_t z)
+{
+  Double_t point[3] = {x, y, z};
+  Double_t bField[3];
+  GetFieldValue(point, bField);
+  return bField[0];
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Get y component of the field   ----------------------------------
+Double_t FairFieldMap::GetBy(Double_t x, Double_t y, Double_t z)
+{
+  Double_t point[3] = {x, y, z};
+  Double_t bField[3];
+  GetFieldValue(point, bField);
+  return bField[1];
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Get z component of the field   ----------------------------------
+Double_t FairFieldMap::GetBz(Double_t x, Double_t y, Double_t z)
+{
+  Double_t point[3] = {x, y, z};
+  Double_t bField[3];
+  GetFieldValue(point, bField);
+  return bField[2];
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Get the field at a point   --------------------------------------
+void FairFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
+{
+  if (fFloatData) {
+    Interpolate(*fGrid, fFloatData, fScale, point[0], point[1], point[2], bField);
+  } else if (fDoubleData) {
+    Interpolate(*fGrid, fDoubleData, fScale, point[0], point[1], point[2], bField);
+  } else {
+    bField[0] = bField[1] = bField[2] = 0.;
+  }
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Get the field at many points   ----------------------------------
+void FairFieldMap::GetFieldValues(Int_t n, const Double_t* x, const Double_t* y, const Double_t* z,
+                                  Double_t* bx, Double_t* by, Double_t* bz)
+{
+  const FairFieldMapGrid& grid = *fGrid;
+  Double_t bField[3];
+  if (fFloatData) {
+    for (Int_t i = 0; i < n; i++) {
+      Interpolate(grid, fFloatData, fScale, x[i], y[i], z[i], bField);
+      bx[i] = bField[0];
+      by[i] = bField[1];
+      bz[i] = bField[2];
+    }
+  } else if (fDoubleData) {
+    for (Int_t i = 0; i < n; i++) {
+      Interpolate(grid, fDoubleData, fScale, x[i], y[i], z[i], bField);
+      bx[i] = bField[0];
+      by[i] = bField[1];
+      bz[i] = bField[2];
+    }
+  } else {
+    for (Int_t i = 0; i < n; i++) {
+      bx[i] = by[i] = bz[i] = 0.;
+    }
+  }
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Screen output   -------------------------------------------------
+void FairFieldMap::Print(Option_t*) const
+{
+  const char* axes[3] = {"x", "y", "z"};
+  LOG(INFO) << "======================================================"
+            << FairLogger::endl;
+  LOG(INFO) << "----  " << fTitle << " : " << fName << FairLogger::endl;
+  LOG(INFO) << "----" << FairLogger::endl;
+  LOG(INFO) << "----  Field type    : map (" << (fUseFloat ? "float" : "double") << ")"
+            << FairLogger::endl;
+  if (fFileName.Length() > 0) {
+    LOG(INFO) << "----  Map file      : " << fFileName << FairLogger::endl;
+  }
+  LOG(INFO) << "----" << FairLogger::endl;
+  LOG(INFO) << "----  Grid : " << FairLogger::endl;
+  for (Int_t a = 0; a < 3; a++) {
+    LOG(INFO) << "----        " << axes[a] << " = " << setw(4) << fMin[a] << " to " << setw(4)
+              << fMax[a] << " cm, " << fN[a] << " nodes"
+              << ((fSymmetry & (1 << a)) ? ", folded" : "") << FairLogger::endl;
+  }
+  LOG(INFO) << "----  Scale factor  : " << fScale << FairLogger::endl;
+  LOG(INFO) << "======================================================"
+            << FairLogger::endl;
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Private method Reset   ------------------------------------------
+void FairFieldMap::Reset()
+{
+  if (fUseFloat) { delete[] reinterpret_cast<Float_t*>(fBuffer); }
+  else { delete[] reinterpret_cast<Double_t*>(fBuffer); }
+  if (fMapping) { munmap(fMapping, fMappingSize); }
+  fBuffer = 0;
+  fMapping = 0;
+  fMappingSize = 0;
+  fFloatData = 0;
+  fDoubleData = 0;
+}
+// -------------------------------------------------------------------------
+
+
+
+// -----   Private method UpdateGrid   -------------------------------------
+void FairFieldMap::UpdateGrid()
+{
+  FairFieldMapGrid& g = *fGrid;
+  for (Int_t a = 0; a < 3; a++) {
+    g.fMin[a] = fMin[a];
+    g.fInvStep[a] = fN[a] > 1 ? (fN[a] - 1) / (fMax[a] - fMin[a]) : 0.;
+    g.fLast[a] = fN[a] - 1;
+    g.fLastCell[a] = fN[a] - 2;
+    g.fFold[a] = (fSymmetry & (1 << a)) ? 1. : 0.;
+    for (Int_t k = 0; k < 3; k++) {
+      g.fSignM1[a][k] = g.fFold[a] * (fSign[a][k] - 1.);
+    }
+  }
+  g.fStride[2] = 3;
+  g.fStride[1] = 3 * Long64_t(fN[2]);
+  g.fStride[0] = 3 * Long64_t(fN[1]) * fN[2];
+}
+// -------------------------------------------------------------------------
+
+
+ClassImp(FairFieldMap)
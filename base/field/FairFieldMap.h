@@ -0,0 +1,167 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+
+/** FairFieldMap.h
+ **
+ ** Magnetic field map on a regular 3D grid with trilinear interpolation.
+ **
+ ** The field components of a grid node are stored next to each other
+ ** (Bx, By, Bz per node, z running fastest) as float or double, so an
+ ** interpolation reads eight compact nodes. The interpolation has no
+ ** branches, outside of the map the field is zero. Batched queries
+ ** (GetFieldValues) run without virtual calls per point.
+ **
+ ** The map can be folded at the coordinate planes: for a folded axis only
+ ** the side with coordinates >= 0 is stored and the field at negative
+ ** coordinates is taken from the mirror point with the given signs of
+ ** the components.
+ **
+ ** Maps are either filled in memory (SetNode, Fill) or read from the
+ ** binary file written by WriteFile, which is mapped into memory (mmap)
+ ** without any conversion. A FairFieldMapCreator creates the field for
+ ** FairRunAna from such a file.
+ **/
+
+#ifndef FAIRFIELDMAP_H
+#define FAIRFIELDMAP_H 1
+
+#include "FairField.h"                  // for FairField
+
+#include "Rtypes.h"                     // for Double_t, Int_t, etc
+#include "TString.h"                    // for TString
+
+struct FairFieldMapGrid;
+
+class FairFieldMap : public FairField
+{
+
+  public:
+
+    /** Default constructor **/
+    FairFieldMap();
+
+
+    /** Constructor for a map from a binary file, the file is mapped
+     ** into memory immediately
+     ** @param fileName  Binary map file written by WriteFile
+     **/
+    FairFieldMap(const char* fileName);
+
+
+    /** Constructor for a map filled in memory, the field is zero at
+     ** all nodes. At least two nodes are needed per axis.
+     ** @param nx,ny,nz          Number of grid nodes per axis
+     ** @param xmin,xmax, ...    Range of the grid [cm]
+     ** @param useFloat          Store the field as float instead of double
+     **/
+    FairFieldMap(const char* name,
+                 Int_t nx, Double_t xmin, Double_t xmax,
+                 Int_t ny, Double_t ymin, Double_t ymax,
+                 Int_t nz, Double_t zmin, Double_t zmax,
+                 Bool_t useFloat = kTRUE);
+
+
+    /** Destructor **/
+    virtual ~FairFieldMap();
+
+
+    /** Maps the file if the map was read from a ROOT file **/
+    virtual void Init();
+
+
+    /** Maps a binary map file into memory, returns kFALSE on errors **/
+    Bool_t ReadFile(const char* fileName);
+
+
+    /** Writes the map to a binary file, returns kFALSE on errors **/
+    Bool_t WriteFile(const char* fileName) const;
+
+
+    /** Folds the map at the plane axis = 0 (axis 0, 1, 2 for x, y, z).
+     ** The field at negative coordinates is the field at the mirror
+     ** point with the components multiplied by signBx, signBy, signBz.
+     ** To be called before the nodes are filled, the grid should start
+     ** at 0 along the folded axis.
+     **/
+    void SetSymmetry(Int_t axis, Int_t signBx, Int_t signBy, Int_t signBz);
+
+
+    /** Set the field at a grid node [kG] of a map filled in memory **/
+    void SetNode(Int_t ix, Int_t iy, Int_t iz, Double_t bx, Double_t by, Double_t bz);
+
+
+    /** Fill all nodes of a map in memory from another field **/
+    void Fill(FairField* field);
+
+
+    /** Test whether the map has nodes, i.e. was filled or read **/
+    Bool_t HasNodes() const { return fFloatData != 0 || fDoubleData != 0; }
+
+
+    /** Scale factor applied to all field values **/
+    void SetScale(Double_t scale) { fScale = scale; }
+    Double_t GetScale() const { return fScale; }
+
+
+    /** Field components [kG] at x,y,z [cm] **/
+    virtual Double_t GetBx(Double_t x, Double_t y, Double_t z);
+    virtual Double_t GetBy(Double_t x, Double_t y, Double_t z);
+    virtual Double_t GetBz(Double_t x, Double_t y, Double_t z);
+
+
+    /** Get magnetic field. For use of GEANT3
+     ** @param point            Coordinates [cm]
+     ** @param bField (return)  Field components [kG]
+     **/
+    virtual void GetFieldValue(const Double_t point[3], Double_t* bField);
+
+
+    /** Get magnetic field for n points, see FairField::GetFieldValues **/
+    virtual void GetFieldValues(Int_t n, const Double_t* x, const Double_t* y, const Double_t* z,
+                                Double_t* bx, Double_t* by, Double_t* bz);
+
+
+    /** Screen output **/
+    virtual void Print(Option_t* option = "") const;
+
+
+  protected:
+
+    TString  fFileName;     // Binary map file, empty for maps in memory
+    Int_t    fN[3];         // Number of grid nodes in x, y, z
+    Double_t fMin[3];       // Lower edge of the grid [cm]
+    Double_t fMax[3];       // Upper edge of the grid [cm]
+    Double_t fScale;        // Scale factor for the field values
+    Bool_t   fUseFloat;     // Field stored as float
+    Int_t    fSymmetry;     // Folded axes, bit 0, 1, 2 for x, y, z
+    Double_t fSign[3][3];   // Signs of Bx, By, Bz at negative coordinates of each axis
+
+    const Float_t*  fFloatData;  //! Bx, By, Bz per node if stored as float
+    const Double_t* fDoubleData; //! Bx, By, Bz per node if stored as double
+    Char_t*  fBuffer;            //! Nodes of a map filled in memory
+    void*    fMapping;           //! Mapped file
+    ULong64_t fMappingSize;      //! Size of the mapped file
+    FairFieldMapGrid* fGrid;     //! Grid geometry for the interpolation
+
+  private:
+
+    /** Releases the nodes and the mapped file **/
+    void Reset();
+
+    /** Computes the grid geometry from the members **/
+    void UpdateGrid();
+
+    FairFieldMap(const FairFieldMap&);
+    FairFieldMap& operator=(const FairFieldMap&);
+
+    ClassDef(FairFieldMap,1);
+
+};
+
+
+#endif
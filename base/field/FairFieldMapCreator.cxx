@@ -0,0 +1,43 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+// -------------------------------------------------------------------------
+// -----              FairFieldMapCreator source file                  -----
+// -------------------------------------------------------------------------
+
+#include "FairFieldMapCreator.h"
+
+#include "FairFieldMap.h"               // for FairFieldMap
+#include "FairLogger.h"                 // for FairLogger, MESSAGE_ORIGIN
+
+FairFieldMapCreator::FairFieldMapCreator(const char* fileName, Double_t scale)
+  : FairFieldFactory(),
+    fFileName(fileName),
+    fScale(scale)
+{
+  fCreator=this;
+}
+
+FairFieldMapCreator::~FairFieldMapCreator()
+{
+}
+
+FairField* FairFieldMapCreator::createFairField()
+{
+  FairFieldMap* field = new FairFieldMap(fFileName.Data());
+  if (!field->HasNodes()) {
+    LOG(ERROR) << "FairFieldMapCreator: no field map from " << fFileName << FairLogger::endl;
+    delete field;
+    return 0;
+  }
+  field->SetScale(fScale);
+  field->Init();
+  field->Print();
+  return field;
+}
+
+ClassImp(FairFieldMapCreator)
@@ -0,0 +1,50 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+// -------------------------------------------------------------------------
+// -----               FairFieldMapCreator header file                 -----
+// -------------------------------------------------------------------------
+
+/** FairFieldMapCreator
+ ** Field factory for a FairFieldMap from a binary map file. Creating the
+ ** creator in the macro registers it as the FairFieldFactory, FairRunAna
+ ** then creates the field from the file.
+ **/
+
+#ifndef FAIRFIELDMAPCREATOR_H
+#define FAIRFIELDMAPCREATOR_H
+
+#include "FairFieldFactory.h"           // for FairFieldFactory
+
+#include "Rtypes.h"                     // for Double_t, etc
+#include "TString.h"                    // for TString
+
+class FairField;
+
+class FairFieldMapCreator : public FairFieldFactory
+{
+
+  public:
+    /** @param fileName  Binary map file written by FairFieldMap::WriteFile
+     ** @param scale     Scale factor for the field values
+     **/
+    FairFieldMapCreator(const char* fileName = "", Double_t scale = 1.);
+    virtual ~FairFieldMapCreator();
+    virtual FairField* createFairField();
+    virtual void SetParm() {}
+
+  protected:
+    TString fFileName;
+    Double_t fScale;
+
+  private:
+    FairFieldMapCreator(const FairFieldMapCreator&);
+    FairFieldMapCreator& operator=(const FairFieldMapCreator&);
+
+    ClassDef(FairFieldMapCreator,1)
+};
+#endif //FAIRFIELDMAPCREATOR_H
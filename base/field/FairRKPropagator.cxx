@@ -12,7 +12,86 @@
 #include "TMath.h"                      // for Sqrt
 #include "TMathBase.h"                  // for Abs
 
-#include <stdio.h>                      // for printf
+#include <vector>                       // for vector
+
+#if defined(__AVX__)
+#include <immintrin.h>                  // for __m256d
+#elif defined(__SSE2__)
+#include <emmintrin.h>                  // for __m128d
+#endif
+
+namespace
+{
+
+// Vector of doubles for the batch stepper, one lane per track. Only +, -, *
+// and Abs are used, so every lane computes exactly what the single track
+// code computes.
+#if defined(__AVX__)
+const Int_t kLanes = 4;
+struct RKVec {
+  __m256d v;
+  RKVec(__m256d x) : v(x) {}
+  RKVec(Double_t x) : v(_mm256_set1_pd(x)) {}
+};
+inline RKVec Load(const Double_t* p) { return _mm256_loadu_pd(p); }
+inline void Store(Double_t* p, RKVec a) { _mm256_storeu_pd(p, a.v); }
+inline RKVec operator+(RKVec a, RKVec b) { return _mm256_add_pd(a.v, b.v); }
+inline RKVec operator-(RKVec a, RKVec b) { return _mm256_sub_pd(a.v, b.v); }
+inline RKVec operator*(RKVec a, RKVec b) { return _mm256_mul_pd(a.v, b.v); }
+inline RKVec Abs(RKVec a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.), a.v); }
+#elif defined(__SSE2__)
+const Int_t kLanes = 2;
+struct RKVec {
+  __m128d v;
+  RKVec(__m128d x) : v(x) {}
+  RKVec(Double_t x) : v(_mm_set1_pd(x)) {}
+};
+inline RKVec Load(const Double_t* p) { return _mm_loadu_pd(p); }
+inline void Store(Double_t* p, RKVec a) { _mm_storeu_pd(p, a.v); }
+inline RKVec operator+(RKVec a, RKVec b) { return _mm_add_pd(a.v, b.v); }
+inline RKVec operator-(RKVec a, RKVec b) { return _mm_sub_pd(a.v, b.v); }
+inline RKVec operator*(RKVec a, RKVec b) { return _mm_mul_pd(a.v, b.v); }
+inline RKVec Abs(RKVec a) { return _mm_andnot_pd(_mm_set1_pd(-0.), a.v); }
+#else
+const Int_t kLanes = 1;
+struct RKVec {
+  Double_t v;
+  RKVec(Double_t x) : v(x) {}
+};
+inline RKVec Load(const Double_t* p) { return *p; }
+inline void Store(Double_t* p, RKVec a) { *p = a.v; }
+inline RKVec operator+(RKVec a, RKVec b) { return a.v + b.v; }
+inline RKVec operator-(RKVec a, RKVec b) { return a.v - b.v; }
+inline RKVec operator*(RKVec a, RKVec b) { return a.v * b.v; }
+inline RKVec Abs(RKVec a) { return TMath::Abs(a.v); }
+#endif
+
+// work arrays of the batch stepper, one entry per active track
+enum RKWork {
+  kX, kY, kZ, kA, kB, kC, kH, kH2, kH4, kPh2,
+  kBx, kBy, kBz, kPx, kPy, kPz,
+  kS0x, kS0y, kS0z, kS1x, kS1y, kS1z, kS2x, kS2y, kS2z, kAt, kBt, kCt,
+  kAng2, kEst1, kEst2, kEst3,
+  kXn, kYn, kZn, kAn, kBn, kCn,
+  kNWork
+};
+
+// number of tracks stepped together, a multiple of kLanes
+const Int_t kBatchChunk = 128;
+
+// unit normal of the plane spanned by vec1 and vec2
+void PlaneNormal(const Double_t* vec1, const Double_t* vec2, Double_t* norm)
+{
+  norm[0]=vec1[1]*vec2[2] - vec1[2]*vec2[1]; // a2b3 - a3b2
+  norm[1]=vec1[2]*vec2[0] - vec1[0]*vec2[2]; // a3b1 - a1b3
+  norm[2]=vec1[0]*vec2[1] - vec1[1]*vec2[0]; // a1b2 - a2b1
+  Double_t mag=TMath::Sqrt(norm[0]*norm[0]+norm[1]*norm[1]+norm[2]*norm[2]);
+  norm[0]=norm[0]/mag;
+  norm[1]=norm[1]/mag;
+  norm[2]=norm[2]/mag;
+}
+
+}
 
 ClassImp(FairRKPropagator);
 
@@ -37,25 +116,13 @@ void FairRKPropagator::PropagatToPlane(Double_t Charge, Double_t* vecRKIn, Doubl
   vec3 a point on the plane
   */
   Double_t Norm[3];
-  Double_t Mag;
   Double_t dist[3];
   Double_t distance[3];
   Double_t vecRKoutT[7];
 
   for (Int_t i=0; i< 7; i++) {vecRKoutT[i]=0;}
     
-  Norm[0]=vec1[1]*vec2[2] - vec2[2] * vec2[1]; // a2b3 − a3b2,
-  Norm[1]=vec1[2]*vec2[0] - vec1[0] * vec2[2]; // a3b1 − a1b3;
-  Norm[2]=vec1[0]*vec2[1] - vec1[1] * vec2[0];
-
-  Mag=TMath::Sqrt(Norm[0]*Norm[0]+Norm[1]*Norm[1]+Norm[2]*Norm[2]);
-
-  // printf(" Mag = %f   \n ", Mag);
-
-  Norm[0]=Norm[0]/Mag;
-  Norm[1]=Norm[1]/Mag;
-  Norm[2]=Norm[2]/Mag;
-  //   printf(" after normalization : Normal = %f %f %f  \n ", Norm[0],Norm[1],Norm[2]);
+  PlaneNormal(vec1, vec2, Norm);
 
   dist[0]=vecRKIn[0]-vec3[0];
   dist[1]=vecRKIn[1]-vec3[1];
@@ -128,8 +195,6 @@ void FairRKPropagator::Propagat(Double_t Charge, Double_t* vecRKIn, Double_t* Po
     if(nIter++>1000) { break; }
   } while(1);
   if (res > res_old) for (Int_t k=0; k< 7; k++) { vecRKOut[k]=vecRKOutT[k]; }
-  for (Int_t k=0; k< 3; k++) { printf(" vecRKOut[%i] =%f ", k, vecRKOut[k] ); }
-  printf("\n");
 }
 //______________________________________________________________________________
 void FairRKPropagator::Step(Double_t Charge, Double_t* vecRKIn, Double_t* vecOut)
@@ -231,7 +296,6 @@ void FairRKPropagator::OneStepRungeKutta(Double_t charge, Double_t step,
 
   do {
     rest  = step - tl;
-    printf(" Step  no. %i  x=%f  y=%f  z=%f  px/p = %f  py/p =%f  pz/p= %f \n", iter, x,y,z,a,b,c);
     if (TMath::Abs(h) > TMath::Abs(rest)) {
       h = rest;
     }
@@ -437,3 +501,324 @@ void FairRKPropagator::OneStepRungeKutta(Double_t charge, Double_t step,
   */
 
 }
+//______________________________________________________________________________
+void FairRKPropagator::PropagatBatch(Int_t nTracks, const Double_t* charge, Double_t* vecRKIn, const Double_t* Pos, Double_t* vecOut)
+{
+  // Propagat for all tracks, the tracks which are still moving towards
+  // their point are stepped together. Like in Propagat the co-ords in
+  // vecRKIn are replaced by the last accepted ones.
+  if (nTracks<=0) { return; }
+  std::vector<Double_t> diff(nTracks), maxStep(nTracks), res(nTracks,100.0), res_old(nTracks);
+  std::vector<Double_t> vecRKOut(7*nTracks,0.), vecRKOutT(3*nTracks,0.), stepOut(7*nTracks);
+  std::vector<Int_t> active(nTracks), nIter(nTracks,0);
+  for (Int_t i=0; i<nTracks; i++) {
+    diff[i] = Pos[2*nTracks+i] - vecRKIn[2*nTracks+i];
+    maxStep[i] = diff[i]/25;
+    res_old[i] = diff[i];
+    active[i] = i;
+  }
+
+  Int_t nActive=nTracks;
+  while (nActive>0) {
+    StepBatch(nTracks,&active[0],nActive,charge,&maxStep[0],vecRKIn,&stepOut[0]);
+    Int_t nLeft=0;
+    for (Int_t j=0; j<nActive; j++) {
+      Int_t i=active[j];
+      for (Int_t k=0; k<7; k++) { vecRKOut[k*nTracks+i]=stepOut[k*nActive+j]; }
+      res[i]=(vecRKOut[2*nTracks+i]-Pos[2*nTracks+i])/diff[i];
+      if( TMath::Abs(res[i])< 0.01 || res[i] >res_old[i] ) { continue; }
+      for (Int_t k=0; k<3; k++) {
+        vecRKOutT[k*nTracks+i]=vecRKOut[k*nTracks+i];
+        vecRKIn[k*nTracks+i]=vecRKOut[k*nTracks+i];
+      }
+      if(nIter[i]++>1000) { continue; }
+      active[nLeft++]=i;
+    }
+    nActive=nLeft;
+  }
+
+  for (Int_t i=0; i<nTracks; i++) {
+    for (Int_t k=0; k<3; k++) {
+      if (res[i] > res_old[i]) { vecOut[k*nTracks+i]=vecRKOutT[k*nTracks+i]; }
+      else { vecOut[k*nTracks+i]=vecRKOut[k*nTracks+i]; }
+    }
+  }
+}
+//______________________________________________________________________________
+void FairRKPropagator::PropagatToPlaneBatch(Int_t nTracks, const Double_t* charge, Double_t* vecRKIn, const Double_t* vec1, const Double_t* vec2, const Double_t* vec3, Double_t* vecOut)
+{
+  // PropagatToPlane for all tracks to the same plane, the tracks which are
+  // still moving towards the plane are stepped together
+  if (nTracks<=0) { return; }
+  Double_t Norm[3];
+  PlaneNormal(vec1, vec2, Norm);
+
+  std::vector<Double_t> diff(nTracks), maxStep(nTracks), res(nTracks,100.0), res_old(nTracks,100.0);
+  std::vector<Double_t> vecRKOut(3*nTracks,0.), vecRKoutT(3*nTracks,0.), stepOut(7*nTracks);
+  std::vector<Int_t> active(nTracks), nIter(nTracks,0);
+  Double_t dist[3];
+  for (Int_t i=0; i<nTracks; i++) {
+    for (Int_t k=0; k<3; k++) { dist[k]=Norm[k]*(vecRKIn[k*nTracks+i]-vec3[k]); }
+    diff[i] = TMath::Abs(dist[0]+dist[1]+dist[2]);
+    maxStep[i] = diff[i];
+    active[i] = i;
+  }
+
+  Int_t nActive=nTracks;
+  while (nActive>0) {
+    StepBatch(nTracks,&active[0],nActive,charge,&maxStep[0],vecRKIn,&stepOut[0]);
+    Int_t nLeft=0;
+    for (Int_t j=0; j<nActive; j++) {
+      Int_t i=active[j];
+      for (Int_t k=0; k<3; k++) {
+        vecRKOut[k*nTracks+i]=stepOut[k*nActive+j];
+        dist[k]=(vecRKOut[k*nTracks+i]-vec3[k])*Norm[k];
+      }
+      maxStep[i]=TMath::Sqrt(dist[0]*dist[0]+dist[1]*dist[1]+dist[2]*dist[2]);
+      res[i]=TMath::Abs(maxStep[i]/diff[i]);
+      if( res[i]< 0.001 || res[i] >res_old[i] ) { continue; }
+      for (Int_t k=0; k<3; k++) {
+        vecRKIn[k*nTracks+i]=vecRKOut[k*nTracks+i];
+        vecRKoutT[k*nTracks+i]=vecRKOut[k*nTracks+i];
+      }
+      res_old[i]=res[i];
+      if(nIter[i]++>1000) { continue; }
+      active[nLeft++]=i;
+    }
+    nActive=nLeft;
+  }
+
+  for (Int_t i=0; i<nTracks; i++) {
+    for (Int_t k=0; k<3; k++) {
+      if (res[i] > res_old[i]) { vecOut[k*nTracks+i]=vecRKoutT[k*nTracks+i]; }
+      else { vecOut[k*nTracks+i]=vecRKOut[k*nTracks+i]; }
+    }
+  }
+}
+//______________________________________________________________________________
+void FairRKPropagator::StepBatch(Int_t nTracks, const Int_t* active, Int_t nActive, const Double_t* charge,
+                                 const Double_t* maxStep, const Double_t* vecRKIn, Double_t* vecOut)
+{
+  std::vector<Double_t> vecRKIn2(7*nActive), charge2(nActive), step2(nActive);
+  for (Int_t j=0; j<nActive; j++) {
+    Int_t i=active[j];
+    charge2[j]=charge[i];
+    step2[j]=maxStep[i];
+    for (Int_t k=0; k<7; k++) { vecRKIn2[k*nActive+j]=vecRKIn[k*nTracks+i]; }
+  }
+  OneStepRungeKuttaBatch(nActive,&charge2[0],&step2[0],&vecRKIn2[0],vecOut);
+  for (Int_t j=0; j<nActive; j++) {
+    vecOut[3*nActive+j] = vecOut[3*nActive+j]/vecOut[6*nActive+j];
+    vecOut[4*nActive+j] = vecOut[4*nActive+j]/vecOut[6*nActive+j];
+    vecOut[5*nActive+j] = vecOut[5*nActive+j]/vecOut[6*nActive+j];
+  }
+}
+//______________________________________________________________________________
+void FairRKPropagator::OneStepRungeKuttaBatch(Int_t nTracks, const Double_t* charge, const Double_t* step,
+    const Double_t* vect, Double_t* vout)
+{
+  // Batch version of OneStepRungeKutta.
+  //
+  // Every pass makes one trial step for all tracks which are not done yet:
+  // the field is queried for all of them at once at each of the three
+  // points and the Nystroem stages in between run over SIMD lanes. The step
+  // size control is then applied to every track on its own like in the
+  // single track method, tracks which are done drop out of the next pass.
+
+  if (nTracks<=0) { return; }
+
+  const Double_t maxit = 10;
+  const Double_t maxcut = 11;
+
+  const Double_t hmin   = 1e-4;
+  const Double_t kdlt   = 1e-3;
+  const Double_t kdlt32 = kdlt/32.;
+  const Double_t kthird = 1./3.;
+  const Double_t khalf  = 0.5;
+  const Double_t kec    = 2.9979251e-3;
+  const Double_t kpisqua = 9.86960440109;
+
+  for(Int_t j = 0; j < 7*nTracks; j++) {
+    vout[j] = vect[j];
+  }
+
+  // the tracks are stepped in chunks which keep the work arrays in the
+  // cache, the work arrays are padded to full vectors and the padding
+  // lanes are computed but never used
+  std::vector<Double_t> pinv(kBatchChunk), tl(kBatchChunk), hTrack(kBatchChunk);
+  std::vector<Int_t> iter(kBatchChunk), ncut(kBatchChunk), active(kBatchChunk);
+  std::vector<Double_t> buffer(kNWork*kBatchChunk,0.);
+  Double_t* w[kNWork];
+  for (Int_t k=0; k<kNWork; k++) { w[k] = &buffer[k*kBatchChunk]; }
+
+  for (Int_t first=0; first<nTracks; first+=kBatchChunk) {
+    Int_t nActive = TMath::Min(kBatchChunk, nTracks-first);
+    for (Int_t l=0; l<nActive; l++) {
+      Int_t i = first+l;
+      pinv[l] = kec * charge[i] / vect[6*nTracks+i];
+      tl[l] = 0.;
+      hTrack[l] = step[i];
+      iter[l] = 0;
+      ncut[l] = 0;
+      active[l] = l;
+    }
+
+    while (nActive>0) {
+      for (Int_t j=0; j<nActive; j++) {
+        Int_t l = active[j];
+        Int_t i = first+l;
+        Double_t rest = step[i] - tl[l];
+        if (TMath::Abs(hTrack[l]) > TMath::Abs(rest)) {
+          hTrack[l] = rest;
+        }
+        w[kX][j] = vout[i];
+        w[kY][j] = vout[nTracks+i];
+        w[kZ][j] = vout[2*nTracks+i];
+        w[kA][j] = vout[3*nTracks+i];
+        w[kB][j] = vout[4*nTracks+i];
+        w[kC][j] = vout[5*nTracks+i];
+        w[kH][j] = hTrack[l];
+        w[kH2][j] = khalf * hTrack[l];
+        w[kH4][j] = khalf * w[kH2][j];
+        w[kPh2][j] = khalf * (pinv[l] * hTrack[l]);
+      }
+
+      fMagField->GetFieldValues(nActive, w[kX], w[kY], w[kZ], w[kBx], w[kBy], w[kBz]);
+
+      // * start of integration
+      for (Int_t j=0; j<nActive; j+=kLanes) {
+        RKVec a = Load(w[kA]+j), b = Load(w[kB]+j), c = Load(w[kC]+j);
+        RKVec ph2 = Load(w[kPh2]+j), h2 = Load(w[kH2]+j), h4 = Load(w[kH4]+j);
+        RKVec fx = RKVec(-1.0) * Load(w[kBx]+j);
+        RKVec fy = RKVec(-1.0) * Load(w[kBy]+j);
+        RKVec fz = RKVec(-1.0) * Load(w[kBz]+j);
+
+        RKVec sx = (b * fz - c * fy) * ph2;
+        RKVec sy = (c * fx - a * fz) * ph2;
+        RKVec sz = (a * fy - b * fx) * ph2;
+        Store(w[kAng2]+j, sx*sx + sy*sy + sz*sz);
+        Store(w[kS0x]+j, sx);
+        Store(w[kS0y]+j, sy);
+        Store(w[kS0z]+j, sz);
+
+        RKVec dxt = h2 * a + h4 * sx;
+        RKVec dyt = h2 * b + h4 * sy;
+        RKVec dzt = h2 * c + h4 * sz;
+        Store(w[kPx]+j, Load(w[kX]+j) + dxt);
+        Store(w[kPy]+j, Load(w[kY]+j) + dyt);
+        Store(w[kPz]+j, Load(w[kZ]+j) + dzt);
+        Store(w[kEst1]+j, Abs(dxt) + Abs(dyt) + Abs(dzt));
+      }
+
+      // * second intermediate point
+      fMagField->GetFieldValues(nActive, w[kPx], w[kPy], w[kPz], w[kBx], w[kBy], w[kBz]);
+
+      for (Int_t j=0; j<nActive; j+=kLanes) {
+        RKVec a = Load(w[kA]+j), b = Load(w[kB]+j), c = Load(w[kC]+j);
+        RKVec ph2 = Load(w[kPh2]+j), h = Load(w[kH]+j);
+        RKVec fx = RKVec(-1.0) * Load(w[kBx]+j);
+        RKVec fy = RKVec(-1.0) * Load(w[kBy]+j);
+        RKVec fz = RKVec(-1.0) * Load(w[kBz]+j);
+
+        RKVec at = a + Load(w[kS0x]+j);
+        RKVec bt = b + Load(w[kS0y]+j);
+        RKVec ct = c + Load(w[kS0z]+j);
+        RKVec s1x = (bt * fz - ct * fy) * ph2;
+        RKVec s1y = (ct * fx - at * fz) * ph2;
+        RKVec s1z = (at * fy - bt * fx) * ph2;
+        at = a + s1x;
+        bt = b + s1y;
+        ct = c + s1z;
+        RKVec s2x = (bt * fz - ct * fy) * ph2;
+        RKVec s2y = (ct * fx - at * fz) * ph2;
+        RKVec s2z = (at * fy - bt * fx) * ph2;
+        Store(w[kS1x]+j, s1x);
+        Store(w[kS1y]+j, s1y);
+        Store(w[kS1z]+j, s1z);
+        Store(w[kS2x]+j, s2x);
+        Store(w[kS2y]+j, s2y);
+        Store(w[kS2z]+j, s2z);
+
+        RKVec dxt = h * (a + s2x);
+        RKVec dyt = h * (b + s2y);
+        RKVec dzt = h * (c + s2z);
+        Store(w[kPx]+j, Load(w[kX]+j) + dxt);
+        Store(w[kPy]+j, Load(w[kY]+j) + dyt);
+        Store(w[kPz]+j, Load(w[kZ]+j) + dzt);
+        Store(w[kAt]+j, a + RKVec(2.) * s2x);
+        Store(w[kBt]+j, b + RKVec(2.) * s2y);
+        Store(w[kCt]+j, c + RKVec(2.) * s2z);
+        Store(w[kEst2]+j, Abs(dxt) + Abs(dyt) + Abs(dzt));
+      }
+
+      fMagField->GetFieldValues(nActive, w[kPx], w[kPy], w[kPz], w[kBx], w[kBy], w[kBz]);
+
+      for (Int_t j=0; j<nActive; j+=kLanes) {
+        RKVec a = Load(w[kA]+j), b = Load(w[kB]+j), c = Load(w[kC]+j);
+        RKVec at = Load(w[kAt]+j), bt = Load(w[kBt]+j), ct = Load(w[kCt]+j);
+        RKVec ph2 = Load(w[kPh2]+j), h = Load(w[kH]+j);
+        RKVec fx = RKVec(-1.0) * Load(w[kBx]+j);
+        RKVec fy = RKVec(-1.0) * Load(w[kBy]+j);
+        RKVec fz = RKVec(-1.0) * Load(w[kBz]+j);
+        RKVec s0x = Load(w[kS0x]+j), s0y = Load(w[kS0y]+j), s0z = Load(w[kS0z]+j);
+        RKVec s1x = Load(w[kS1x]+j), s1y = Load(w[kS1y]+j), s1z = Load(w[kS1z]+j);
+        RKVec s2x = Load(w[kS2x]+j), s2y = Load(w[kS2y]+j), s2z = Load(w[kS2z]+j);
+
+        Store(w[kZn]+j, Load(w[kZ]+j) + (c + (s0z + s1z + s2z) * RKVec(kthird)) * h);
+        Store(w[kYn]+j, Load(w[kY]+j) + (b + (s0y + s1y + s2y) * RKVec(kthird)) * h);
+        Store(w[kXn]+j, Load(w[kX]+j) + (a + (s0x + s1x + s2x) * RKVec(kthird)) * h);
+        RKVec s3x = (bt*fz - ct*fy)* ph2;
+        RKVec s3y = (ct*fx - at*fz)* ph2;
+        RKVec s3z = (at*fy - bt*fx)* ph2;
+        Store(w[kAn]+j, a+(s0x+s3x+RKVec(2.) * (s1x+s2x)) * RKVec(kthird));
+        Store(w[kBn]+j, b+(s0y+s3y+RKVec(2.) * (s1y+s2y)) * RKVec(kthird));
+        Store(w[kCn]+j, c+(s0z+s3z+RKVec(2.) * (s1z+s2z)) * RKVec(kthird));
+        Store(w[kEst3]+j, Abs(s0x+s3x - (s1x+s2x))
+                          + Abs(s0y+s3y - (s1y+s2y))
+                          + Abs(s0z+s3z - (s1z+s2z)));
+      }
+
+      // step size control, in the order of OneStepRungeKutta
+      Int_t nLeft = 0;
+      for (Int_t j=0; j<nActive; j++) {
+        Int_t l = active[j];
+        Int_t i = first+l;
+        Bool_t done = kFALSE;
+        if (w[kAng2][j] > kpisqua) {
+          done = kTRUE;
+        } else if (w[kEst1][j] > hTrack[l] || w[kEst2][j] > 2.*TMath::Abs(hTrack[l])
+                   || (w[kEst3][j] > kdlt && TMath::Abs(hTrack[l]) > hmin)) {
+          if (ncut[l]++ > maxcut) { done = kTRUE; }
+          else { hTrack[l] *= khalf; }
+        } else {
+          ncut[l] = 0;
+          // * if too many iterations, go to helix
+          if (iter[l]++ > maxit) {
+            done = kTRUE;
+          } else {
+            tl[l] += hTrack[l];
+            if (w[kEst3][j] < kdlt32) {
+              hTrack[l] *= 2.;
+            }
+            Double_t a = w[kAn][j];
+            Double_t b = w[kBn][j];
+            Double_t c = w[kCn][j];
+            Double_t cba = 1./ TMath::Sqrt(a*a + b*b + c*c);
+            vout[i] = w[kXn][j];
+            vout[nTracks+i] = w[kYn][j];
+            vout[2*nTracks+i] = w[kZn][j];
+            vout[3*nTracks+i] = cba*a;
+            vout[4*nTracks+i] = cba*b;
+            vout[5*nTracks+i] = cba*c;
+
+            Double_t rest = step[i] - tl[l];
+            if (step[i] < 0.) { rest = -rest; }
+            if (rest < 1.e-5*TMath::Abs(step[i])) { done = kTRUE; }
+          }
+        }
+        if (!done) { active[nLeft++] = l; }
+      }
+      nActive = nLeft;
+    }
+  }
+}
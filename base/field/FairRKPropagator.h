@@ -29,6 +29,8 @@ class FairRKPropagator : public TObject
     FairRKPropagator& operator=(const FairRKPropagator&); // Not implemented
     Double_t fMaxStep;
     FairField*              fMagField;
+    /** Step for the tracks in the list active, vecOut is indexed like the list */
+    void StepBatch(Int_t nTracks, const Int_t* active, Int_t nActive, const Double_t* charge, const Double_t* maxStep, const Double_t* vecRKIn, Double_t* vecOut);
   public:
     void Step(Double_t Charge, Double_t* vecRKIn, Double_t* vecOut);
     void OneStepRungeKutta(Double_t charge, Double_t step, Double_t* vect, Double_t* vout);
@@ -52,6 +54,43 @@ class FairRKPropagator : public TObject
 
     void PropagatToPlane(Double_t Charge, Double_t* vecRKIn, Double_t* vec1, Double_t* vec2, Double_t* vec3, Double_t* vecOut);
 
+    /** Batch versions for many tracks in the same field.
+    The tracks are stored as structure of arrays, component k of track i is
+    at [k*nTracks+i]. All tracks are stepped together with SIMD arithmetic
+    and the field is queried for all of them at once with
+    FairField::GetFieldValues. The results agree with the single track
+    methods within rounding.
+    */
+
+    /**One Runge-Kutta step for each track
+    @nTracks   Number of tracks
+    @charge    Particle charges
+    @step      Step sizes
+    @vect      Initial co-ords,direction cosines,momentum (7*nTracks)
+    @vout      Output co-ords,direction cosines,momentum (7*nTracks)
+    */
+    void OneStepRungeKuttaBatch(Int_t nTracks, const Double_t* charge, const Double_t* step, const Double_t* vect, Double_t* vout);
+
+    /**Propagate to closest approach of points, see Propagat
+    @nTracks   Number of tracks
+    @charge    Particle charges
+    @vecRKIn   Initial co-ords,direction cosines,momentum (7*nTracks)
+    @Pos       Points (3*nTracks)
+    @vecOut    Output co-ords (3*nTracks)
+    */
+    void PropagatBatch(Int_t nTracks, const Double_t* charge, Double_t* vecRKIn, const Double_t* Pos, Double_t* vecOut);
+
+    /**Propagate to closest approach of a plane, see PropagatToPlane
+    @nTracks   Number of tracks
+    @charge    Particle charges
+    @vecRKIn   Initial co-ords,direction cosines,momentum (7*nTracks)
+    @vec1      vector on the plane
+    @vec2      vector on the plane
+    @vec3      point on the plane
+    @vecOut    Output co-ords (3*nTracks)
+    */
+    void PropagatToPlaneBatch(Int_t nTracks, const Double_t* charge, Double_t* vecRKIn, const Double_t* vec1, const Double_t* vec2, const Double_t* vec3, Double_t* vecOut);
+
     virtual ~FairRKPropagator();
     ClassDef(FairRKPropagator, 1);
 
@@ -67,6 +67,11 @@ class TParticle;
 #include <utility>                      // for pair
 
 using std::pair;
+
+/** Copies of sensitive volumes with a copy number below this value are
+ *  kept in the dispatcher table of Stepping() */
+static const Int_t kMaxTableCopyNo = 65536;
+
 //_____________________________________________________________________________
 FairMCApplication::FairMCApplication(const char* name, const char* title,
                                      TObjArray* ModList, const char* MatName)
@@ -95,6 +100,7 @@ FairMCApplication::FairMCApplication(const char* name, const char* title,
    fDisDet(NULL),
    fVolMap(),
    fVolIter(),
+   fVolTable(),
    fModVolMap(),
    fModVolIter(),
    fTrkPos(TLorentzVector(0,0,0,0)),
@@ -176,6 +182,7 @@ FairMCApplication::FairMCApplication(const FairMCApplication& rhs)
    fDisDet(NULL),
    fVolMap(),
    fVolIter(),
+   fVolTable(),
    fModVolMap(),
    fModVolIter(),
    fTrkPos(rhs.fTrkPos),
@@ -258,6 +265,7 @@ FairMCApplication::FairMCApplication()
    fDisDet(0),
    fVolMap(),
    fVolIter(),
+   fVolTable(),
    fModVolMap(),
    fModVolIter(),
    fTrkPos(TLorentzVector(0,0,0,0)),
@@ -627,48 +635,28 @@ void FairMCApplication::Stepping()
   }
 
 
-  // Check if the volume with id is in the volume multimap.
-  // If it is not in the map the volume is not a sensitive volume 
-  // and we do not call nay of our ProcessHits functions.
-
-  // If the volume is in the multimap, check in second step if the current 
-  // copy is alredy inside the multimap. 
-  // If the volume is not in the multimap add the copy of the volume to the 
-  // multimap. 
+  // Look up the volume with id and the current copy number in the table of
+  // sensitive volumes. If there is no entry for the id the volume is not a
+  // sensitive volume and we do not call any of our ProcessHits functions.
+  // The copies of the sensitive volumes are added to the table in
+  // InitGeometry, only copies which are not found in the geometry are
+  // created here.
   // In any case call the ProcessHits function for this specific detector.
   Int_t copyNo;
   Int_t id = gMC->CurrentVolID(copyNo);
-  Bool_t InMap =kFALSE;
   fDisVol=0;
   fDisDet=0;
-  Int_t fCopyNo=0;
-  fVolIter =fVolMap.find(id);
-  if (fVolIter!=fVolMap.end()) {
-    do {
-      fDisVol=fVolIter->second;
-      fCopyNo=fDisVol->getCopyNo();
-      if(copyNo==fCopyNo) {
-        fDisDet=fDisVol->GetDetector();
-        if (fDisDet) {
-          fDisDet->ProcessHits(fDisVol);
-        }
-        InMap=kTRUE;
-        break;
-      }
-      fVolIter++;
-    } while(fVolIter!=fVolMap.upper_bound(id));
-    //    if(fDisVol && !InMap) { // fDisVolume is set previously, no check needed
-    if(!InMap) {
-      FairVolume* fNewV=new FairVolume( gMC->CurrentVolName(), id);
-      fNewV->setMCid(id);
-      fNewV->setModId(fDisVol->getModId());
-      fNewV->SetModule(fDisVol->GetModule());
-      fNewV->setCopyNo(copyNo);
-      fVolMap.insert(pair<Int_t, FairVolume* >(id, fNewV));
-      fDisDet=fDisVol->GetDetector();
-      if ( fDisDet) {
-        fDisDet->ProcessHits(fNewV);
-      }
+  if (id >= 0 && id < static_cast<Int_t>(fVolTable.size()) && !fVolTable[id].empty()) {
+    const std::vector<FairVolume*>& copies = fVolTable[id];
+    if (copyNo >= 0 && copyNo < static_cast<Int_t>(copies.size())) {
+      fDisVol=copies[copyNo];
+    }
+    if (!fDisVol) {
+      fDisVol=GetSensitiveVolumeCopy(id, copyNo);
+    }
+    fDisDet=fDisVol->GetDetector();
+    if (fDisDet) {
+      fDisDet->ProcessHits(fDisVol);
     }
   }
 
@@ -1020,7 +1008,7 @@ void FairMCApplication::InitGeometry()
           fNewV->SetModule(fv->GetModule());
           fNewV->setCopyNo(fN->GetNumber());
           fNewV->setMCid(id);
-          fVolMap.insert(pair<Int_t, FairVolume* >(id, fNewV));
+          AddSensitiveVolume(fNewV);
         }
       } else {
         FairVolume* fNewV=new FairVolume( fv->GetName(), id);
@@ -1028,16 +1016,104 @@ void FairMCApplication::InitGeometry()
         fNewV->SetModule(fv->GetModule());
         fNewV->setCopyNo(1);
         fNewV->setMCid(id);
-        fVolMap.insert(pair<Int_t, FairVolume* >(id, fNewV));
+        AddSensitiveVolume(fNewV);
       }
     } else {
-      fVolMap.insert(pair<Int_t, FairVolume* >(id, fv));
+      AddSensitiveVolume(fv);
     }
   }
+  AddSensitiveVolumeCopies();
   fGeometryIsInitialized=kTRUE;
 
 }
 
+//_____________________________________________________________________________
+void FairMCApplication::AddSensitiveVolume(FairVolume* vol)
+{
+  Int_t id=vol->getMCid();
+  Int_t copyNo=vol->getCopyNo();
+  fVolMap.insert(pair<Int_t, FairVolume* >(id, vol));
+  if (id < 0) {
+    return;
+  }
+  if (id >= static_cast<Int_t>(fVolTable.size())) {
+    fVolTable.resize(id+1);
+  }
+  // a sensitive id has at least one entry, copies with very large copy
+  // numbers are only kept in fVolMap
+  std::vector<FairVolume*>& copies = fVolTable[id];
+  if (copies.empty()) {
+    copies.resize(1, 0);
+  }
+  if (copyNo >= 0 && copyNo < kMaxTableCopyNo) {
+    if (copyNo >= static_cast<Int_t>(copies.size())) {
+      copies.resize(copyNo+1, 0);
+    }
+    if (!copies[copyNo]) {
+      copies[copyNo]=vol;
+    }
+  }
+}
+
+//_____________________________________________________________________________
+FairVolume* FairMCApplication::GetSensitiveVolumeCopy(Int_t id, Int_t copyNo)
+{
+  FairVolume* proto=0;
+  for (fVolIter=fVolMap.find(id); fVolIter!=fVolMap.end() && fVolIter->first==id; fVolIter++) {
+    if (fVolIter->second->getCopyNo()==copyNo) {
+      return fVolIter->second;
+    }
+    proto=fVolIter->second;
+  }
+  if (!proto) {
+    return 0;
+  }
+  FairVolume* fNewV=new FairVolume(proto->GetName(), id);
+  fNewV->setMCid(id);
+  fNewV->setModId(proto->getModId());
+  if (proto->GetModule()) {
+    fNewV->SetModule(proto->GetModule());
+  }
+  fNewV->setCopyNo(copyNo);
+  AddSensitiveVolume(fNewV);
+  return fNewV;
+}
+
+//_____________________________________________________________________________
+void FairMCApplication::AddSensitiveVolumeCopies()
+{
+  // Walk once over all nodes of the geometry and create the FairVolumes for
+  // all placed copies of the sensitive volumes, so that Stepping() does not
+  // have to allocate anything.
+  if (!gGeoManager) {
+    return;
+  }
+  std::map<TGeoVolume*, FairVolume*> sensitive;
+  for (fVolIter=fVolMap.begin(); fVolIter!=fVolMap.end(); fVolIter++) {
+    TGeoVolume* v=gGeoManager->GetVolume(fVolIter->second->GetName());
+    if (v && sensitive.find(v)==sensitive.end()) {
+      sensitive[v]=fVolIter->second;
+    }
+  }
+  if (sensitive.empty()) {
+    return;
+  }
+  Int_t nVolumes=fVolMap.size();
+  TIter next(gGeoManager->GetListOfVolumes());
+  TGeoVolume* mother;
+  while ((mother=dynamic_cast<TGeoVolume*>(next()))) {
+    for (Int_t k=0; k<mother->GetNdaughters(); k++) {
+      TGeoNode* node=mother->GetNode(k);
+      std::map<TGeoVolume*, FairVolume*>::const_iterator it=sensitive.find(node->GetVolume());
+      if (it!=sensitive.end()) {
+        GetSensitiveVolumeCopy(it->second->getMCid(), node->GetNumber());
+      }
+    }
+  }
+  LOG(DEBUG) << "FairMCApplication: " << fVolMap.size() << " copies of sensitive volumes, "
+             << fVolMap.size()-nVolumes << " of them added from the geometry" << FairLogger::endl;
+}
+
 //_____________________________________________________________________________
 void FairMCApplication::GeneratePrimaries()
 {
@@ -24,6 +24,7 @@
 
 #include <map>                           // for map, multimap, etc
 #include <list>                           // for list
+#include <vector>                         // for vector
 
 class FairDetector;
 class FairEventHeader;
@@ -112,6 +113,12 @@ class FairMCApplication : public TVirtualMCApplication
     TChain*               GetChain();
     /** Initialize geometry */
     virtual void          InitGeometry();                                   // MC Application
+    /** Add a copy of a sensitive volume to the dispatcher of Stepping(),
+     *  the copy is identified by its MC id and copy number */
+    void                  AddSensitiveVolume(FairVolume* vol);
+    /** Add all copies of the sensitive volumes which are placed in the TGeo
+     *  geometry, called by InitGeometry */
+    void                  AddSensitiveVolumeCopies();
     /** Initialize MC engine */
     void                  InitMC(const char* setup,  const char* cuts);
     /** Initialize Tasks if any*/
@@ -195,6 +202,10 @@ class FairMCApplication : public TVirtualMCApplication
 
     Int_t GetIonPdg(Int_t z, Int_t a) const;
 
+    /** Return the sensitive volume for the given copy, a new FairVolume is
+     *  created if the copy is not yet known */
+    FairVolume* GetSensitiveVolumeCopy(Int_t id, Int_t copyNo);
+
     // data members
     /**List of active detector */
     TRefArray*           fActiveDetectors;
@@ -244,6 +255,9 @@ class FairMCApplication : public TVirtualMCApplication
     std::multimap <Int_t, FairVolume* > fVolMap;//!
     /**dispatcher internal use */
     std::multimap <Int_t, FairVolume* >::iterator fVolIter; //!
+    /**dispatcher internal use, sensitive volumes indexed by MC id and copy number.
+     * Ids without entries are not sensitive, copies without entry are looked up in fVolMap */
+    std::vector < std::vector<FairVolume*> > fVolTable; //!
     /** Track position*/
     /**dispatcher internal use RadLeng*/
     std::map <Int_t, Int_t > fModVolMap;//!
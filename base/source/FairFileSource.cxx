@@ -29,6 +29,7 @@
 #include "FairRootManager.h"
 #include "TRandom.h"                    // for TRandom, gRandom
 #include "TROOT.h"
+#include "TTreeCacheUnzip.h"            // for TTreeCacheUnzip
 #include <list>                         // for _List_iterator, list, etc
 using std::map;
 using std::set;
@@ -69,6 +70,11 @@ FairFileSource::FairFileSource(TFile *f, const char* Title, UInt_t identifier)
   , fGapTime(-1.)
   , fEventMeanTime(0.)
   , fTimeProb(0)
+  , fPrefetchDepth(0)
+  , fNReadEvents(0)
+  , fNReadStalls(0)
+  , fNLastMisses(0)
+  , fReadTimer()
 {
     if (fRootFile->IsZombie()) {
      LOG(FATAL) << "Error opening the Input file" << FairLogger::endl;
@@ -112,6 +118,11 @@ FairFileSource::FairFileSource(const TString* RootFileName, const char* Title, U
   , fGapTime(-1.)
   , fEventMeanTime(0.)
   , fTimeProb(0)
+  , fPrefetchDepth(0)
+  , fNReadEvents(0)
+  , fNReadStalls(0)
+  , fNLastMisses(0)
+  , fReadTimer()
 {
   fRootFile = new TFile(RootFileName->Data());
   if (fRootFile->IsZombie()) {
@@ -156,6 +167,11 @@ FairFileSource::FairFileSource(const TString RootFileName, const char* Title, UI
   , fGapTime(-1.)
   , fEventMeanTime(0.)
   , fTimeProb(0)
+  , fPrefetchDepth(0)
+  , fNReadEvents(0)
+  , fNReadStalls(0)
+  , fNLastMisses(0)
+  , fReadTimer()
 {
     fRootFile = new TFile(RootFileName.Data());
     if (fRootFile->IsZombie()) {
@@ -296,6 +312,10 @@ Bool_t FairFileSource::Init()
 
     AddFriendsToChain();
 
+   if ( fPrefetchDepth > 0 ) {
+     InitPrefetching();
+   }
+
    TList* timebasedlist= dynamic_cast <TList*> (fRootFile->Get("TimeBasedBranchList"));
    if(timebasedlist==0) {
       LOG(WARNING) << "No time based branch list in input file" << FairLogger::endl;
@@ -324,7 +344,18 @@ Int_t FairFileSource::ReadEvent(UInt_t i)
 {
     fCurrentEntryNo = i;
     SetEventTime();
-    if ( fInChain->GetEntry(i) ) return 0;
+    fReadTimer.Start(kFALSE);
+    Int_t nBytes = fInChain->GetEntry(i);
+    fReadTimer.Stop();
+    fNReadEvents++;
+    if ( fPrefetchDepth > 0 ) {
+      Int_t nMisses = GetNPrefetchMisses();
+      if ( nMisses > fNLastMisses ) {
+        fNReadStalls++;
+      }
+      fNLastMisses = nMisses;
+    }
+    if ( nBytes ) return 0;
 
     return 1;
 }
@@ -333,6 +364,9 @@ Int_t FairFileSource::ReadEvent(UInt_t i)
 //_____________________________________________________________________________
 void FairFileSource::Close()
 {
+    if ( fPrefetchDepth > 0 ) {
+      PrintPrefetchStatistics();
+    }
     CloseInFile();
 }
 //_____________________________________________________________________________
@@ -858,5 +892,76 @@ void FairFileSource::FillEventHeader(FairEventHeader* feh)
 }
 //_____________________________________________________________________________
 
+//_____________________________________________________________________________
+void FairFileSource::InitPrefetching()
+{
+  // The tree cache reads all baskets of the next entries with one request,
+  // with parallel unzipping a TTreeCacheUnzip decompresses them on a
+  // background thread. The cache holds at least one cluster of the tree.
+  fInChain->LoadTree(0);
+  TTree* tree = fInChain->GetTree();
+  if ( !tree || tree->GetEntries() == 0 ) {
+    return;
+  }
+  Long64_t nEntries = fPrefetchDepth;
+  if ( tree->GetAutoFlush() > nEntries ) {
+    nEntries = tree->GetAutoFlush();
+  }
+  Long64_t cacheSize = nEntries * (tree->GetZipBytes() / tree->GetEntries() + 1);
+  fInChain->SetParallelUnzip(kTRUE);
+  fInChain->SetCacheSize(cacheSize);
+  fInChain->AddBranchToCache("*", kTRUE);
+  fInChain->LoadTree(0);
+  fNLastMisses = GetNPrefetchMisses();
+  LOG(INFO) << "FairFileSource: read ahead of " << fPrefetchDepth
+            << " entries, cache size " << cacheSize << " bytes" << FairLogger::endl;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+Int_t FairFileSource::GetNPrefetchMisses()
+{
+  TTree* tree = fInChain->GetTree();
+  if ( !tree || !tree->GetCurrentFile() ) {
+    return 0;
+  }
+  TTreeCacheUnzip* cache = dynamic_cast<TTreeCacheUnzip*>(tree->GetCurrentFile()->GetCacheRead(tree));
+  if ( !cache ) {
+    return 0;
+  }
+  return cache->GetNMissed();
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairFileSource::PrintPrefetchStatistics()
+{
+  LOG(INFO) << "FairFileSource: " << fNReadEvents << " entries read in "
+            << fReadTimer.RealTime() << " s, the event loop waited for data "
+            << fNReadStalls << " times" << FairLogger::endl;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+FairSource* FairFileSource::CloneForWorker() const
+{
+  FairFileSource* clone = new FairFileSource(TString(fRootFile->GetName()), fInputTitle.Data(), fSourceIdentifier);
+  clone->fInputChainList = fInputChainList;
+  clone->fFriendFileList = fFriendFileList;
+  clone->fEventTimeInMCHeader = fEventTimeInMCHeader;
+  clone->fEventTimeMin = fEventTimeMin;
+  clone->fEventTimeMax = fEventTimeMax;
+  clone->fBeamTime = fBeamTime;
+  clone->fPrefetchDepth = fPrefetchDepth;
+  clone->fGapTime = fGapTime;
+  if (fTimeProb) {
+    clone->SetEventMeanTime(fEventMeanTime);
+  } else {
+    clone->fEventMeanTime = fEventMeanTime;
+  }
+  return clone;
+}
+//_____________________________________________________________________________
+
 ClassImp(FairFileSource)
 
@@ -22,6 +22,7 @@
 #include "TFile.h"
 #include "TFolder.h"
 #include "TF1.h"
+#include "TStopwatch.h"
 class FairEventHeader;
 class FairFileHeader;
 class FairMCEventHeader;
@@ -50,6 +51,8 @@ public:
     /**Read specific tree entry on one branch**/
     virtual void   ReadBranchEvent(const char* BrName, Int_t Entry);
     virtual void FillEventHeader(FairEventHeader* feh);
+    /** Create a source reading the same input files and friends */
+    virtual FairSource* CloneForWorker() const;
 
     const TFile*        GetRootFile(){return fRootFile;}
     /** Add a friend file (input) by name)*/
@@ -98,7 +101,22 @@ public:
     void                SetEvtHeaderNew(Bool_t Status) {fEvtHeaderIsNew = Status;}
     Bool_t              IsEvtHeaderNew() {return fEvtHeaderIsNew;}
 
+    /** Read and unzip the next nEntries entries of the input chain in the
+     *  background while the current entry is processed. Has to be set
+     *  before Init, 0 (default) switches the read ahead off.
+     */
+    void                SetPrefetchDepth(Int_t nEntries) {fPrefetchDepth = nEntries;}
+    /** Print the time spent in ReadEvent and how often the event loop had
+     *  to wait for data which was not yet prefetched*/
+    void                PrintPrefetchStatistics();
+    Int_t               GetNReadStalls() const {return fNReadStalls;}
+
 private:
+    /** Enable the read ahead cache with background unzipping on the input chain*/
+    void                InitPrefetching();
+    /** Number of baskets the event loop had to unzip itself*/
+    Int_t               GetNPrefetchMisses();
+
     /** Title of input source, could be input, background or signal*/
     TString                           fInputTitle;
     /**ROOT file*/
@@ -171,6 +189,17 @@ private:
     /** used to generate random numbers for event time; */
     TF1*                                    fTimeProb;      //!
 
+    /** Number of entries read ahead, 0 means no read ahead */
+    Int_t                                   fPrefetchDepth; //!
+    /** Number of ReadEvent calls */
+    Int_t                                   fNReadEvents; //!
+    /** Number of ReadEvent calls which had to wait for data */
+    Int_t                                   fNReadStalls; //!
+    /** Prefetch misses after the last ReadEvent */
+    Int_t                                   fNLastMisses; //!
+    /** Time spent in ReadEvent */
+    TStopwatch                              fReadTimer; //!
+
     ClassDef(FairFileSource, 2)
 };
 
@@ -10,18 +10,52 @@
 // -----                           FairLmdSource                           -----
 // -----                    Created 12.04.2013 by D.Kresan                 -----
 // -----------------------------------------------------------------------------
+#include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <iostream>
+#include <vector>
 using namespace std;
 
+#include "TCondition.h"
 #include "TList.h"
+#include "TMutex.h"
 #include "TObjString.h"
 #include "TRegexp.h"
 #include "TSystemDirectory.h"
 #include "TSystem.h"
+#include "TThread.h"
 
 #include "FairLmdSource.h"
 #include "FairLogger.h"
 
+/** One event read by the reader thread, with the headers to unpack before it */
+struct FairLmdRecord
+{
+  FairLmdRecord() : fHeaders(), fHeaderSizes(), fHeaderWords(), fEvent(), fEnd(kFALSE) {}
+  std::vector<Int_t> fHeaders;      // data of the file and buffer headers
+  std::vector<Int_t> fHeaderSizes;  // size given to Unpack
+  std::vector<Int_t> fHeaderWords;  // words of each header in fHeaders
+  std::vector<Int_t> fEvent;        // copy of the event
+  Bool_t fEnd;                      // end of the input, no event
+};
+
+/** State shared between FairLmdSource::ReadEvent and the reader thread */
+struct FairLmdReader
+{
+  FairLmdReader() : fMutex(), fCondition(&fMutex), fQueue(), fFree(), fThread(0),
+    fMaxQueued(0), fNRead(0), fNWaits(0), fStop(kFALSE) {}
+  TMutex                      fMutex;
+  TCondition                  fCondition;
+  std::deque<FairLmdRecord*>  fQueue;      // events in the order of the files
+  std::vector<FairLmdRecord*> fFree;       // records for reuse
+  TThread*                    fThread;
+  Int_t                       fMaxQueued;
+  Int_t                       fNRead;      // number of events read by the thread
+  Int_t                       fNWaits;     // number of times ReadEvent waited for the thread
+  Bool_t                      fStop;
+};
+
 FairLmdSource::FairLmdSource()
   : FairMbsSource(),
     fCurrentFile(0),
@@ -33,7 +67,17 @@ FairLmdSource::FairLmdSource()
     fxBuffer(NULL),
     fxEventData(NULL),
     fxSubEvent(NULL),
-    fxInfoHeader(NULL)
+    fxInfoHeader(NULL),
+    fUseMemoryMap(kFALSE),
+    fRange(0),
+    fNRanges(1),
+    fxMap(NULL),
+    fFirstEventOfFile(0),
+    fFirstElement(0),
+    fNewFile(kFALSE),
+    fReadAhead(0),
+    fReader(NULL),
+    fxRecord(NULL)
 {
 }
 
@@ -49,13 +93,28 @@ FairLmdSource::FairLmdSource(const FairLmdSource& source)
     fxBuffer(NULL),
     fxEventData(NULL),
     fxSubEvent(NULL),
-    fxInfoHeader(NULL)
+    fxInfoHeader(NULL),
+    fUseMemoryMap(source.fUseMemoryMap),
+    fRange(source.fRange),
+    fNRanges(source.fNRanges),
+    fxMap(NULL),
+    fFirstEventOfFile(0),
+    fFirstElement(0),
+    fNewFile(kFALSE),
+    fReadAhead(source.fReadAhead),
+    fReader(NULL),
+    fxRecord(NULL)
 {
 }
 
 
 FairLmdSource::~FairLmdSource()
 {
+  StopReader();
+  if(fxMap) {
+    fLmdMapClose(fxMap);
+    free(fxMap);
+  }
   fFileNames->Delete();
   delete fFileNames;
 }
@@ -110,6 +169,18 @@ void FairLmdSource::AddPath(TString dir, TString wildCard)
 }
 
 
+void FairLmdSource::SetFileRange(UInt_t iRange, UInt_t nRanges)
+{
+  if(nRanges == 0 || iRange >= nRanges) {
+    LOG(ERROR) << "FairLmdSource: invalid file range " << iRange << " of " << nRanges << FairLogger::endl;
+    return;
+  }
+  fRange = iRange;
+  fNRanges = nRanges;
+  fUseMemoryMap = kTRUE;
+}
+
+
 Bool_t FairLmdSource::Init()
 {
   if(! FairMbsSource::Init()) {
@@ -137,12 +208,49 @@ Bool_t FairLmdSource::Init()
 Bool_t FairLmdSource::OpenNextFile(TString fileName)
 {
   Int_t inputMode = GETEVT__FILE;
-  fxInputChannel = new s_evt_channel;
   void* headptr = &fxInfoHeader;
   INTS4 status;
 
   LOG(INFO) << "File " << fileName << " will be opened." << FairLogger::endl;
 
+  // the event counters belong to ReadEvent, the reader thread can not seek anyway
+  if(NULL == fxRecord) {
+    fFirstEventOfFile = fNEvent;
+  }
+  fNewFile = kTRUE;
+  if(fUseMemoryMap) {
+    if(! fxMap) {
+      fxMap = fLmdMapAllocateControl();
+    }
+    status = fLmdMapOpen(fxMap, const_cast<char*>(fileName.Data()), NULL);
+    if(LMD__SUCCESS == status) {
+      uint64_t first = 0;
+      uint64_t last = fLmdMapGetElements(fxMap);
+      if(fNRanges > 1) {
+        fLmdMapGetRange(fxMap, fRange, fNRanges, &first, &last);
+        fLmdMapSetRange(fxMap, first, last);
+      }
+      fFirstElement = first;
+      LOG(INFO) << "File " << fileName << " mapped, reading elements " << first << " to " << last << FairLogger::endl;
+
+      // the LMD file header has no s_filhe to decode
+      fxInfoHeader = NULL;
+      return kTRUE;
+    }
+    free(fxMap);
+    fxMap = NULL;
+    if(GETLMD__NOLMDFILE != status) {
+      LOG(ERROR) << "File " << fileName << " mapping failed." << FairLogger::endl;
+      return kFALSE;
+    }
+    if(fNRanges > 1) {
+      LOG(ERROR) << "File " << fileName << " is in the buffered format, it can not be split into ranges." << FairLogger::endl;
+      return kFALSE;
+    }
+    LOG(INFO) << "File " << fileName << " is in the buffered format, read without mapping." << FairLogger::endl;
+  }
+
+  fxInputChannel = new s_evt_channel;
   status = f_evt_get_open(inputMode,
                           const_cast<char*>(fileName.Data()),
                           fxInputChannel,
@@ -158,7 +266,7 @@ Bool_t FairLmdSource::OpenNextFile(TString fileName)
   LOG(INFO) << "File " << fileName << " opened." << FairLogger::endl;
 
   // Decode File Header
-  Bool_t result = Unpack((Int_t*)fxInfoHeader, sizeof(s_filhe), -4, -4, -4, -4, -4);
+  UnpackHeader(fxInfoHeader, sizeof(s_filhe));
 
   return kTRUE;
 }
@@ -166,16 +274,24 @@ Bool_t FairLmdSource::OpenNextFile(TString fileName)
 
 Int_t FairLmdSource::ReadEvent(UInt_t iev)
 {
-  void* evtptr = &fxEvent;
-  void* buffptr = &fxBuffer;
+  if(fReadAhead > 0 && (fReader || StartReader())) {
+    return ReadQueuedEvent();
+  }
+
+  if(0 != ReadRawEvent(iev)) {
+    return 1;
+  }
+  return UnpackEvent(fxEvent);
+}
+
 
-  Int_t status = f_evt_get_event(fxInputChannel, (INTS4**)evtptr,(INTS4**) buffptr);
-  //Int_t fuEventCounter = fxEvent->l_count;
-  //Int_t fCurrentMbsEventNo = fuEventCounter;
+Int_t FairLmdSource::ReadRawEvent(UInt_t iev)
+{
+  Int_t status = GetNextEvent(iev);
 
-  if(GETEVT__SUCCESS != status) {
+  while(GETEVT__SUCCESS != status) {
 
-    LOG(INFO) << "FairMbsStreamSource::ReadEvent()"
+    LOG(INFO) << "FairLmdSource::ReadEvent()"
               << FairLogger::endl;
 
     CHARS* sErrorString = NULL;
@@ -186,70 +302,60 @@ Int_t FairLmdSource::ReadEvent(UInt_t iev)
     }
 
     if(GETEVT__NOMORE == status) {
-      Close();
+      CloseFile();
     }
 
     TString name = ((TObjString*)fFileNames->At(fCurrentFile))->GetString();
     if(! OpenNextFile(name)) {
       return 1;
-    } else {
-      fCurrentFile += 1;
-      return ReadEvent();
     }
+    fCurrentFile += 1;
+    status = GetNextEvent(0);
   }
 
  //Store Start Times
-  if (fCurrentEvent==0 ) 
-      Unpack((Int_t*)fxBuffer, sizeof(s_bufhe), -4, -4, -4, -4, -4);
+  if(fNewFile) {
+    UnpackHeader(fxBuffer, sizeof(s_bufhe));
+    fNewFile = kFALSE;
+  }
+
+  return 0;
+}
 
 
+Int_t FairLmdSource::UnpackEvent(s_ve10_1* event)
+{
   // Decode event header
   Bool_t result = kFALSE;
-  /*Bool_t result = */Unpack((Int_t*)fxEvent, sizeof(s_ve10_1), -2, -2, -2, -2, -2);
+  /*Bool_t result = */Unpack((Int_t*)event, sizeof(s_ve10_1), -2, -2, -2, -2, -2);
 
-  Int_t nrSubEvts = f_evt_get_subevent(fxEvent, 0, NULL, NULL, NULL);
-  Int_t sebuflength;
-  Short_t setype;
-  Short_t sesubtype;
-  Short_t seprocid;
-  Short_t sesubcrate;
-  Short_t secontrol;
+  Int_t nrSubEvts = f_evt_get_subevent(event, 0, NULL, NULL, NULL);
+  Int_t status;
 
   LOG(DEBUG2)<< "FairLmdSource::ReadEvent => Found " << nrSubEvts << " Sub-event "
              << FairLogger::endl;
-  //if (fCurrentEvent%10000==0)
-  //cout << " -I- LMD_ANA:  evt# " <<  fCurrentEvent << "  n_subevt# " << nrSubEvts << " evt processed# " << fNEvent <<  " : " << fxEvent->l_count << endl;
-
 
-//  Int_t* SubEventDataPtr = new Int_t;
+  // the sub-events are collected first, they can be unpacked in parallel
   for(Int_t i = 1; i <= nrSubEvts; i++) {
     void* SubEvtptr = &fxSubEvent;
     void* EvtDataptr = &fxEventData;
     Int_t nrlongwords;
-    status = f_evt_get_subevent(fxEvent, i, (Int_t**)SubEvtptr, (Int_t**)EvtDataptr, &nrlongwords);
+    status = f_evt_get_subevent(event, i, (Int_t**)SubEvtptr, (Int_t**)EvtDataptr, &nrlongwords);
     if(status) {
+      UnpackSubEvents();
       return 1;
     }
-    sebuflength = nrlongwords;
-    setype = fxSubEvent->i_type;
-    sesubtype = fxSubEvent->i_subtype;
-    seprocid = fxSubEvent->i_procid;
-    sesubcrate = fxSubEvent->h_subcrate;
-    secontrol = fxSubEvent->h_control;
-
-    //cout << setype << "  " << sesubtype << "  " << seprocid << "  " << sesubcrate << "  " << secontrol << endl;
-
-    if(Unpack(fxEventData, sebuflength,
-              setype, sesubtype,
-              seprocid, sesubcrate, secontrol)) {
-      result = kTRUE;
-    }
+
+    AddSubEvent(fxEventData, nrlongwords,
+                fxSubEvent->i_type, fxSubEvent->i_subtype,
+                fxSubEvent->i_procid, fxSubEvent->h_subcrate, fxSubEvent->h_control);
   }
+  result = UnpackSubEvents();
 
   // Increment evt counters.
   fNEvent++;
   fCurrentEvent++;
- 
+
   if(! result)
   {
     return 2;
@@ -259,11 +365,215 @@ Int_t FairLmdSource::ReadEvent(UInt_t iev)
 }
 
 
+void FairLmdSource::UnpackHeader(void* data, Int_t size)
+{
+  if(NULL == data) {
+    return;
+  }
+  if(NULL == fxRecord) {
+    Unpack((Int_t*)data, size, -4, -4, -4, -4, -4);
+    return;
+  }
+  Int_t nWords = (size + sizeof(Int_t) - 1) / sizeof(Int_t);
+  size_t offset = fxRecord->fHeaders.size();
+  fxRecord->fHeaders.resize(offset + nWords);
+  memcpy(&fxRecord->fHeaders[offset], data, size);
+  fxRecord->fHeaderSizes.push_back(size);
+  fxRecord->fHeaderWords.push_back(nWords);
+}
+
+
+Int_t FairLmdSource::ReadQueuedEvent()
+{
+  FairLmdReader* reader = fReader;
+  reader->fMutex.Lock();
+  if(reader->fQueue.empty()) {
+    reader->fNWaits++;
+    while(reader->fQueue.empty()) {
+      reader->fCondition.Wait();
+    }
+  }
+  FairLmdRecord* record = reader->fQueue.front();
+  reader->fQueue.pop_front();
+  reader->fCondition.Broadcast();
+  reader->fMutex.UnLock();
+
+  size_t offset = 0;
+  for(size_t i = 0; i < record->fHeaderSizes.size(); i++) {
+    Unpack(&record->fHeaders[offset], record->fHeaderSizes[i], -4, -4, -4, -4, -4);
+    offset += record->fHeaderWords[i];
+  }
+
+  Int_t status = 1;
+  if(! record->fEnd) {
+    status = UnpackEvent((s_ve10_1*)&record->fEvent[0]);
+  }
+
+  reader->fMutex.Lock();
+  if(record->fEnd) {
+    // the thread has stopped, all further calls return the end
+    record->fHeaders.clear();
+    record->fHeaderSizes.clear();
+    record->fHeaderWords.clear();
+    reader->fQueue.push_front(record);
+  } else {
+    reader->fFree.push_back(record);
+  }
+  reader->fMutex.UnLock();
+
+  return status;
+}
+
+
+void* FairLmdSource::RunReader(void* arg)
+{
+  FairLmdSource* source = static_cast<FairLmdSource*>(arg);
+  FairLmdReader* reader = source->fReader;
+  Bool_t end = kFALSE;
+  while(! end) {
+    reader->fMutex.Lock();
+    while(static_cast<Int_t>(reader->fQueue.size()) >= reader->fMaxQueued && ! reader->fStop) {
+      reader->fCondition.Wait();
+    }
+    if(reader->fStop) {
+      reader->fMutex.UnLock();
+      break;
+    }
+    FairLmdRecord* record = NULL;
+    if(! reader->fFree.empty()) {
+      record = reader->fFree.back();
+      reader->fFree.pop_back();
+    }
+    reader->fMutex.UnLock();
+
+    if(NULL == record) {
+      record = new FairLmdRecord();
+    }
+    record->fHeaders.clear();
+    record->fHeaderSizes.clear();
+    record->fHeaderWords.clear();
+
+    // the headers of files opened on the way are queued with the event
+    source->fxRecord = record;
+    end = 0 != source->ReadRawEvent(0);
+    source->fxRecord = NULL;
+
+    record->fEnd = end;
+    if(! end) {
+      // l_dlen counts the 16 bit words after the 8 bytes of l_dlen, i_type and i_subtype
+      Int_t nBytes = source->fxEvent->l_dlen * 2 + 8;
+      record->fEvent.resize((nBytes + sizeof(Int_t) - 1) / sizeof(Int_t));
+      memcpy(&record->fEvent[0], source->fxEvent, nBytes);
+    }
+
+    reader->fMutex.Lock();
+    reader->fQueue.push_back(record);
+    if(! end) {
+      reader->fNRead++;
+    }
+    reader->fCondition.Broadcast();
+    reader->fMutex.UnLock();
+  }
+  return 0;
+}
+
+
+Bool_t FairLmdSource::StartReader()
+{
+  FairLmdReader* reader = new FairLmdReader();
+  reader->fMaxQueued = fReadAhead;
+
+  TThread::Initialize();
+  fReader = reader;
+  reader->fThread = new TThread("FairLmdSourceReader", &FairLmdSource::RunReader, this);
+  if(0 != reader->fThread->Run()) {
+    LOG(WARNING) << "FairLmdSource: could not start the reader thread, reading on the event loop thread"
+                 << FairLogger::endl;
+    delete reader->fThread;
+    delete reader;
+    fReader = NULL;
+    fReadAhead = 0;
+    return kFALSE;
+  }
+  LOG(INFO) << "FairLmdSource: events are read by a reader thread, "
+            << fReadAhead << " events are read ahead at most" << FairLogger::endl;
+  return kTRUE;
+}
+
+
+void FairLmdSource::StopReader()
+{
+  if(NULL == fReader) {
+    return;
+  }
+  FairLmdReader* reader = fReader;
+  reader->fMutex.Lock();
+  reader->fStop = kTRUE;
+  reader->fCondition.Broadcast();
+  reader->fMutex.UnLock();
+  reader->fThread->Join();
+  delete reader->fThread;
+  fReader = NULL;
+
+  for(size_t i = 0; i < reader->fQueue.size(); i++) {
+    delete reader->fQueue[i];
+  }
+  for(size_t i = 0; i < reader->fFree.size(); i++) {
+    delete reader->fFree[i];
+  }
+  LOG(INFO) << "FairLmdSource: reader thread read " << reader->fNRead
+            << " events, ReadEvent waited " << reader->fNWaits
+            << " times for it" << FairLogger::endl;
+  delete reader;
+}
+
+
+Int_t FairLmdSource::GetNextEvent(UInt_t iev)
+{
+  if(! fxMap) {
+    void* evtptr = &fxEvent;
+    void* buffptr = &fxBuffer;
+    return f_evt_get_event(fxInputChannel, (INTS4**)evtptr,(INTS4**) buffptr);
+  }
+
+  // random access within the current file
+  if(iev > 0 && static_cast<Int_t>(iev) != fNEvent && static_cast<Int_t>(iev) >= fFirstEventOfFile) {
+    if(LMD__SUCCESS == fLmdMapSeek(fxMap, fFirstElement + iev - fFirstEventOfFile)) {
+      fNEvent = iev;
+    }
+  }
+
+  sMbsHeader* element = NULL;
+  UInt_t status = fLmdMapGetNext(fxMap, &element);
+  fxEvent = (s_ve10_1*)element;
+  fxBuffer = NULL;
+  if(LMD__SUCCESS == status) {
+    return GETEVT__SUCCESS;
+  }
+  return GETLMD__NOMORE == status ? GETEVT__NOMORE : GETEVT__RDERR;
+}
+
+
 void FairLmdSource::Close()
 {
-  f_evt_get_close(fxInputChannel);
-  Unpack((Int_t*)fxBuffer, sizeof(s_bufhe), -4, -4, -4, -4, -4);  
-  fCurrentEvent=0;
+  StopReader();
+  CloseFile();
+}
+
+
+void FairLmdSource::CloseFile()
+{
+  if(fxMap) {
+    fLmdMapClose(fxMap);
+    free(fxMap);
+    fxMap = NULL;
+  } else {
+    f_evt_get_close(fxInputChannel);
+    UnpackHeader(fxBuffer, sizeof(s_bufhe));
+  }
+  if(NULL == fxRecord) {
+    fCurrentEvent=0;
+  }
 }
 
 
@@ -17,6 +17,7 @@
 extern "C"
 {
 #include "f_evt.h"
+#include "fLmdMap.h"
 #include "s_filhe_swap.h"
 #include "s_bufhe_swap.h"
 }
@@ -27,6 +28,8 @@ extern "C"
 
 
 class TList;
+struct FairLmdReader;
+struct FairLmdRecord;
 
 
 class FairLmdSource : public FairMbsSource
@@ -41,12 +44,34 @@ class FairLmdSource : public FairMbsSource
     inline const Int_t GetCurrentFile() const { return fCurrentFile; }
     inline const TList* GetFileNames() const { return fFileNames; }
 
+    /** Read the files through a memory mapping (fLmdMap) instead of f_evt_get_event.
+     *  Files in the old buffered format are still read with f_evt_get_event. */
+    void SetUseMemoryMap(Bool_t use = kTRUE) { fUseMemoryMap = use; }
+    /** Read only the part iRange of nRanges parts of the same size of every file,
+     *  e.g. in nRanges parallel jobs. Requires the memory mapping. */
+    void SetFileRange(UInt_t iRange, UInt_t nRanges);
+    /** Read the files on a separate thread, which keeps up to nEvents events
+     *  ahead of ReadEvent. The events are read in their order, the event
+     *  number given to ReadEvent is ignored. 0: read on the calling thread.
+     *  Together with SetUnpackThreads this pipelines reading, unpacking and
+     *  the tasks of FairRunOnline. */
+    void SetReadAhead(Int_t nEvents = 16) { fReadAhead = nEvents; }
+
     virtual Bool_t Init();
     virtual Int_t ReadEvent(UInt_t=0);
     virtual void Close();
 
   protected:
     Bool_t OpenNextFile(TString fileName);
+    Int_t GetNextEvent(UInt_t iev);
+    /** Read the next event into fxEvent, open the next file if needed.
+     *  Returns 0 on success, 1 at the end of the input */
+    Int_t ReadRawEvent(UInt_t iev);
+    /** Unpack the event header and the sub-events, returns the status of ReadEvent */
+    Int_t UnpackEvent(s_ve10_1* event);
+    /** Unpack a file or buffer header, on the reader thread it is queued with the next event */
+    void UnpackHeader(void* data, Int_t size);
+    void CloseFile();
 
     Int_t fCurrentFile;
 	Int_t fNEvent;
@@ -58,6 +83,25 @@ class FairLmdSource : public FairMbsSource
     Int_t* fxEventData;
     s_ves10_1* fxSubEvent;
 	s_filhe* fxInfoHeader;
+    Bool_t fUseMemoryMap;
+    UInt_t fRange;
+    UInt_t fNRanges;
+    sLmdMapControl* fxMap;     // memory mapped file, NULL if read with f_evt
+    Int_t fFirstEventOfFile;   // value of fNEvent for the first event of the current file
+    UInt_t fFirstElement;      // first element of the file range
+    Bool_t fNewFile;           // no event read from the current file yet
+    Int_t fReadAhead;
+    FairLmdReader* fReader;    //! reader thread, NULL if not started
+    FairLmdRecord* fxRecord;   //! record filled by the reader thread
+
+  private:
+    Bool_t StartReader();
+    void StopReader();
+    Int_t ReadQueuedEvent();
+    /** Main function of the reader thread */
+    static void* RunReader(void* arg);
+
+    FairLmdSource& operator=(const FairLmdSource&);
 
     ClassDef(FairLmdSource, 0)
 };
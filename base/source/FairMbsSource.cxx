@@ -14,18 +14,93 @@
 // -----------------------------------------------------------------------------
 
 #include <iostream>
+#include <iomanip>
+#include <utility>
+
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "FairMbsSource.h"
 #include "FairLogger.h"
+#include "FairSystemInfo.h"
+
+#include "TCondition.h"
+#include "TMutex.h"
+#include "TString.h"
+#include "TThread.h"
+
+typedef std::pair<ULong64_t, Short_t> SubEventKey;
 
-FairMbsSource::FairMbsSource() : FairSource(), fUnpackers(new TObjArray()) {}
+struct FairMbsSource::DispatchTable
+  : public boost::unordered_map<SubEventKey, std::vector<Int_t>, boost::hash<SubEventKey> > {};
+
+struct FairMbsSource::UnpackPool
+{
+  struct SubEvent {
+    Int_t* fData;
+    Int_t fSize;
+    Short_t fType;
+    Short_t fSubType;
+    Short_t fProcId;
+    Short_t fSubCrate;
+    Short_t fControl;
+  };
+  /** All sub-events of one unpacker in the current event */
+  struct Job {
+    Int_t fUnpacker;
+    std::vector<Int_t> fSubEvents;
+    std::vector<Int_t> fFailed;   // sub-events for which DoUnpack failed
+  };
+
+  UnpackPool() : fMutex(), fWork(&fMutex), fDone(&fMutex), fSubEvents(), fStatus(), fJobs(), fJobOf(),
+    fNJobs(0), fNext(0), fPending(0), fThreads(), fStop(kFALSE) {}
+  TMutex                 fMutex;
+  TCondition             fWork;       // jobs are available or the threads have to stop
+  TCondition             fDone;       // all jobs are finished
+  std::vector<SubEvent>  fSubEvents;  // sub-events of the current event
+  std::vector<Int_t>     fStatus;     // per sub-event: 0 no unpacker, 1 unpacked, -1 failed
+  std::vector<Job>       fJobs;       // the first fNJobs are used, the others keep their memory
+  std::vector<Int_t>     fJobOf;      // job of each unpacker, -1 if it has no sub-event
+  Int_t                  fNJobs;
+  Int_t                  fNext;       // next job to take
+  Int_t                  fPending;    // jobs not finished
+  std::vector<TThread*>  fThreads;
+  Bool_t                 fStop;
+};
+
+static SubEventKey MakeKey(Short_t type, Short_t subType, Short_t procId,
+                           Short_t subCrate, Short_t control) {
+  ULong64_t key = (ULong64_t)(UShort_t)type << 48 | (ULong64_t)(UShort_t)subType << 32 |
+                  (ULong64_t)(UShort_t)procId << 16 | (ULong64_t)(UShort_t)control;
+  return SubEventKey(key, subCrate);
+}
+
+FairMbsSource::FairMbsSource()
+    : FairSource(), fUnpackers(new TObjArray()), fDispatch(new DispatchTable()),
+      fUnpackCalls(), fUnpackTime(), fNUnknown(0), fNUnpackThreads(0), fPool(NULL) {}
 
 FairMbsSource::FairMbsSource(const FairMbsSource &source)
-    : FairSource(source), fUnpackers(new TObjArray(*(source.GetUnpackers()))) {}
+    : FairSource(source), fUnpackers(new TObjArray(*(source.GetUnpackers()))),
+      fDispatch(new DispatchTable()), fUnpackCalls(fUnpackers->GetEntriesFast(), 0),
+      fUnpackTime(fUnpackers->GetEntriesFast(), 0), fNUnknown(0),
+      fNUnpackThreads(source.GetUnpackThreads()), fPool(NULL) {}
 
 FairMbsSource::~FairMbsSource() {
+  if (fPool) {
+    StopUnpackThreads();
+    delete fPool;
+  }
   fUnpackers->Delete();
   delete fUnpackers;
+  delete fDispatch;
+}
+
+void FairMbsSource::AddUnpacker(FairUnpack *unpacker) {
+  fUnpackers->Add(unpacker);
+  // the cached lists of the sub-events seen so far do not contain the new unpacker
+  fDispatch->clear();
+  fUnpackCalls.resize(fUnpackers->GetEntriesFast(), 0);
+  fUnpackTime.resize(fUnpackers->GetEntriesFast(), 0);
 }
 
 Bool_t FairMbsSource::Init() {
@@ -34,6 +109,8 @@ Bool_t FairMbsSource::Init() {
       return kFALSE;
     }
   }
+  BuildDispatchTable();
+  ResetUnpackerStatistics();
   return kTRUE;
 }
 
@@ -43,6 +120,49 @@ void FairMbsSource::Reset() {
   }
 }
 
+void FairMbsSource::BuildDispatchTable() {
+  // The keys of all unpackers with a specified sub-crate are entered up front.
+  // Keys which are only served by the wildcard sub-crate unpackers (or by none
+  // at all) are added by FindUnpackers when the sub-event is seen first.
+  fDispatch->clear();
+  FairUnpack *unpack;
+  for (Int_t i = 0; i < fUnpackers->GetEntriesFast(); i++) {
+    unpack = (FairUnpack *)fUnpackers->At(i);
+    if (unpack->GetSubCrate() >= 0) {
+      FindUnpackers(unpack->GetType(), unpack->GetSubType(), unpack->GetProcId(),
+                    unpack->GetSubCrate(), unpack->GetControl());
+    }
+  }
+  LOG(DEBUG) << "FairMbsSource::BuildDispatchTable => " << fUnpackers->GetEntriesFast()
+             << " unpackers, " << fDispatch->size() << " sub-event keys" << FairLogger::endl;
+}
+
+const std::vector<Int_t> &FairMbsSource::FindUnpackers(Short_t type, Short_t subType,
+                                                       Short_t procId, Short_t subCrate,
+                                                       Short_t control) {
+  SubEventKey key = MakeKey(type, subType, procId, subCrate, control);
+  DispatchTable::iterator it = fDispatch->find(key);
+  if (it != fDispatch->end()) {
+    return it->second;
+  }
+
+  std::vector<Int_t> &matching = (*fDispatch)[key];
+  FairUnpack *unpack;
+  for (Int_t i = 0; i < fUnpackers->GetEntriesFast(); i++) {
+    unpack = (FairUnpack *)fUnpackers->At(i);
+    if (type != unpack->GetType() || subType != unpack->GetSubType() ||
+        procId != unpack->GetProcId() || control != unpack->GetControl()) {
+      continue;
+    }
+    // sub-crate < 0: all sub-crates
+    if (unpack->GetSubCrate() >= 0 && subCrate != unpack->GetSubCrate()) {
+      continue;
+    }
+    matching.push_back(i);
+  }
+  return matching;
+}
+
 Bool_t FairMbsSource::Unpack(Int_t *data, Int_t size, Short_t type,
                              Short_t subType, Short_t procId, Short_t subCrate,
                              Short_t control) {
@@ -52,32 +172,240 @@ Bool_t FairMbsSource::Unpack(Int_t *data, Int_t size, Short_t type,
              << " ProcId " << procId << " SubCrate " << subCrate
              << " Control " << control
              << FairLogger::endl;
-  
-  FairUnpack *unpack;
-  Bool_t seen = kFALSE;
-  for (Int_t i = 0; i < fUnpackers->GetEntriesFast(); i++) {
-    unpack = (FairUnpack *)fUnpackers->At(i);
 
-    if (unpack->GetSubCrate() < 0) { // All sub-crates
-      if (type != unpack->GetType() || subType != unpack->GetSubType() ||
-          procId != unpack->GetProcId() || control != unpack->GetControl()) {
-        continue;
+  const std::vector<Int_t> &matching = FindUnpackers(type, subType, procId, subCrate, control);
+  if (matching.empty()) {
+    fNUnknown++;
+    return kFALSE;
+  }
+
+  for (size_t i = 0; i < matching.size(); i++) {
+    Int_t index = matching[i];
+    Long64_t start = FairSystemInfo::GetSteadyTime();
+    Bool_t ok = ((FairUnpack *)fUnpackers->UncheckedAt(index))->DoUnpack(data, size);
+    fUnpackTime[index] += FairSystemInfo::GetSteadyTime() - start;
+    fUnpackCalls[index]++;
+    if (!ok) {
+      return kFALSE;
+    }
+  }
+  return kTRUE;
+}
+
+void FairMbsSource::AddSubEvent(Int_t *data, Int_t size, Short_t type,
+                                Short_t subType, Short_t procId, Short_t subCrate,
+                                Short_t control) {
+  if (!fPool) {
+    fPool = new UnpackPool();
+  }
+  UnpackPool::SubEvent sub;
+  sub.fData = data;
+  sub.fSize = size;
+  sub.fType = type;
+  sub.fSubType = subType;
+  sub.fProcId = procId;
+  sub.fSubCrate = subCrate;
+  sub.fControl = control;
+  fPool->fSubEvents.push_back(sub);
+}
+
+Bool_t FairMbsSource::UnpackSubEvents(Bool_t requireAll) {
+  if (!fPool) {
+    return kFALSE;
+  }
+  UnpackPool *pool = fPool;
+  Bool_t result = kFALSE;
+
+  if (fNUnpackThreads < 2 || (pool->fThreads.empty() && !StartUnpackThreads())) {
+    for (size_t i = 0; i < pool->fSubEvents.size(); i++) {
+      UnpackPool::SubEvent &sub = pool->fSubEvents[i];
+      if (Unpack(sub.fData, sub.fSize, sub.fType, sub.fSubType,
+                 sub.fProcId, sub.fSubCrate, sub.fControl)) {
+        result = kTRUE;
+      } else if (requireAll) {
+        // the remaining sub-events are not unpacked
+        pool->fSubEvents.clear();
+        return kFALSE;
       }
-    } else { // specified sub-crate
-      if (type != unpack->GetType() || subType != unpack->GetSubType() ||
-          procId != unpack->GetProcId() || subCrate != unpack->GetSubCrate() ||
-          control != unpack->GetControl()) {
-        continue;
+    }
+    pool->fSubEvents.clear();
+    return result;
+  }
+
+  // one job per unpacker with all its sub-events in their order
+  Int_t nJobs = 0;
+  pool->fJobOf.assign(fUnpackers->GetEntriesFast(), -1);
+  pool->fStatus.assign(pool->fSubEvents.size(), 0);
+  for (size_t i = 0; i < pool->fSubEvents.size(); i++) {
+    UnpackPool::SubEvent &sub = pool->fSubEvents[i];
+    LOG(DEBUG2) << "FairMbsSource::UnpackSubEvents => Found Sub-event with flags: "
+                << " Type " << sub.fType << " SubType " << sub.fSubType
+                << " ProcId " << sub.fProcId << " SubCrate " << sub.fSubCrate
+                << " Control " << sub.fControl << FairLogger::endl;
+    const std::vector<Int_t> &matching = FindUnpackers(sub.fType, sub.fSubType, sub.fProcId,
+                                                       sub.fSubCrate, sub.fControl);
+    if (matching.empty()) {
+      fNUnknown++;
+      continue;
+    }
+    pool->fStatus[i] = 1;
+    for (size_t k = 0; k < matching.size(); k++) {
+      Int_t &job = pool->fJobOf[matching[k]];
+      if (job < 0) {
+        job = nJobs++;
+        if (job == static_cast<Int_t>(pool->fJobs.size())) {
+          pool->fJobs.push_back(UnpackPool::Job());
+        }
+        pool->fJobs[job].fUnpacker = matching[k];
+        pool->fJobs[job].fSubEvents.clear();
+        pool->fJobs[job].fFailed.clear();
+      }
+      pool->fJobs[job].fSubEvents.push_back(i);
+    }
+  }
+
+  pool->fMutex.Lock();
+  pool->fNJobs = nJobs;
+  pool->fNext = 0;
+  pool->fPending = nJobs;
+  pool->fWork.Broadcast();
+  pool->fMutex.UnLock();
+
+  RunUnpackJobs();
+
+  pool->fMutex.Lock();
+  while (pool->fPending > 0) {
+    pool->fDone.Wait();
+  }
+  pool->fMutex.UnLock();
+
+  for (Int_t j = 0; j < nJobs; j++) {
+    for (size_t k = 0; k < pool->fJobs[j].fFailed.size(); k++) {
+      pool->fStatus[pool->fJobs[j].fFailed[k]] = -1;
+    }
+  }
+  for (size_t i = 0; i < pool->fStatus.size(); i++) {
+    if (pool->fStatus[i] > 0) {
+      result = kTRUE;
+    } else if (requireAll) {
+      result = kFALSE;
+      break;
+    }
+  }
+  pool->fSubEvents.clear();
+  return result;
+}
+
+void FairMbsSource::RunUnpackJobs() {
+  UnpackPool *pool = fPool;
+  pool->fMutex.Lock();
+  while (pool->fNext < pool->fNJobs) {
+    UnpackPool::Job &job = pool->fJobs[pool->fNext++];
+    pool->fMutex.UnLock();
+
+    FairUnpack *unpack = (FairUnpack *)fUnpackers->UncheckedAt(job.fUnpacker);
+    for (size_t k = 0; k < job.fSubEvents.size(); k++) {
+      UnpackPool::SubEvent &sub = pool->fSubEvents[job.fSubEvents[k]];
+      Long64_t start = FairSystemInfo::GetSteadyTime();
+      Bool_t ok = unpack->DoUnpack(sub.fData, sub.fSize);
+      fUnpackTime[job.fUnpacker] += FairSystemInfo::GetSteadyTime() - start;
+      fUnpackCalls[job.fUnpacker]++;
+      if (!ok) {
+        job.fFailed.push_back(job.fSubEvents[k]);
       }
     }
 
-    if (!unpack->DoUnpack(data, size)) {
+    pool->fMutex.Lock();
+    if (--pool->fPending == 0) {
+      pool->fDone.Broadcast();
+    }
+  }
+  pool->fMutex.UnLock();
+}
+
+void *FairMbsSource::RunUnpackThread(void *arg) {
+  FairMbsSource *source = static_cast<FairMbsSource *>(arg);
+  UnpackPool *pool = source->fPool;
+  pool->fMutex.Lock();
+  while (kTRUE) {
+    while (pool->fNext >= pool->fNJobs && !pool->fStop) {
+      pool->fWork.Wait();
+    }
+    if (pool->fStop) {
+      break;
+    }
+    pool->fMutex.UnLock();
+    source->RunUnpackJobs();
+    pool->fMutex.Lock();
+  }
+  pool->fMutex.UnLock();
+  return 0;
+}
+
+Bool_t FairMbsSource::StartUnpackThreads() {
+  TThread::Initialize();
+  for (Int_t k = 1; k < fNUnpackThreads; k++) {
+    TThread *thread = new TThread(Form("FairMbsUnpack_%d", k), &FairMbsSource::RunUnpackThread, this);
+    if (thread->Run() != 0) {
+      delete thread;
+      LOG(WARNING) << "FairMbsSource: could not start the unpacking threads, unpacking on one thread"
+                   << FairLogger::endl;
+      StopUnpackThreads();
+      fNUnpackThreads = 0;
       return kFALSE;
     }
+    fPool->fThreads.push_back(thread);
+  }
+  LOG(INFO) << "FairMbsSource: the sub-events are unpacked on " << fNUnpackThreads
+            << " threads" << FairLogger::endl;
+  return kTRUE;
+}
+
+void FairMbsSource::StopUnpackThreads() {
+  if (!fPool || fPool->fThreads.empty()) {
+    return;
+  }
+  fPool->fMutex.Lock();
+  fPool->fStop = kTRUE;
+  fPool->fWork.Broadcast();
+  fPool->fMutex.UnLock();
+  for (size_t k = 0; k < fPool->fThreads.size(); k++) {
+    fPool->fThreads[k]->Join();
+    delete fPool->fThreads[k];
+  }
+  fPool->fThreads.clear();
+  fPool->fStop = kFALSE;
+}
+
+Long64_t FairMbsSource::GetUnpackerCalls(Int_t i) const {
+  return (i >= 0 && i < (Int_t)fUnpackCalls.size()) ? fUnpackCalls[i] : 0;
+}
+
+Long64_t FairMbsSource::GetUnpackerTime(Int_t i) const {
+  return (i >= 0 && i < (Int_t)fUnpackTime.size()) ? fUnpackTime[i] : 0;
+}
 
-    seen = kTRUE;
+void FairMbsSource::ResetUnpackerStatistics() {
+  fUnpackCalls.assign(fUnpackers->GetEntriesFast(), 0);
+  fUnpackTime.assign(fUnpackers->GetEntriesFast(), 0);
+  fNUnknown = 0;
+}
+
+void FairMbsSource::PrintUnpackerStatistics() const {
+  LOG(INFO) << "FairMbsSource: unpacker statistics" << FairLogger::endl;
+  FairUnpack *unpack;
+  for (Int_t i = 0; i < fUnpackers->GetEntriesFast(); i++) {
+    unpack = (FairUnpack *)fUnpackers->At(i);
+    Long64_t calls = GetUnpackerCalls(i);
+    Double_t time = GetUnpackerTime(i) * 1.e-6; // ms
+    LOG(INFO) << "  " << std::setw(24) << std::left << unpack->ClassName() << std::right
+              << " (" << unpack->GetType() << "," << unpack->GetSubType() << ","
+              << unpack->GetProcId() << "," << unpack->GetSubCrate() << ","
+              << unpack->GetControl() << "): " << calls << " calls, "
+              << time << " ms, " << (calls > 0 ? 1.e3 * time / calls : 0.) << " us/call"
+              << FairLogger::endl;
   }
-  return seen;
+  LOG(INFO) << "  sub-events without unpacker: " << fNUnknown << FairLogger::endl;
 }
 
 ClassImp(FairMbsSource)
@@ -21,6 +21,8 @@
 
 #include "FairUnpack.h"
 
+#include <vector>
+
 
 class FairMbsSource : public FairSource
 {
@@ -29,7 +31,7 @@ class FairMbsSource : public FairSource
     FairMbsSource(const FairMbsSource& source);
     virtual ~FairMbsSource();
 
-    inline void AddUnpacker(FairUnpack* unpacker) { fUnpackers->Add(unpacker); }
+    void AddUnpacker(FairUnpack* unpacker);
     inline const TObjArray* GetUnpackers() const { return fUnpackers; }
 
     virtual Bool_t Init();
@@ -38,13 +40,66 @@ class FairMbsSource : public FairSource
 
     void Reset();
 
+    /** Number of DoUnpack calls of the i-th unpacker since Init */
+    Long64_t GetUnpackerCalls(Int_t i) const;
+    /** Time spent in DoUnpack of the i-th unpacker since Init, in ns */
+    Long64_t GetUnpackerTime(Int_t i) const;
+    /** Number of sub-events for which no unpacker was found */
+    inline Long64_t GetNUnknownSubEvents() const { return fNUnknown; }
+    void ResetUnpackerStatistics();
+    /** Prints calls, total and mean time of all unpackers */
+    void PrintUnpackerStatistics() const;
+
+    /** Unpack the sub-events of an event on nThreads threads, the calling one
+     *  included. All sub-events of one unpacker are unpacked in their order on
+     *  one thread, different unpackers run in parallel. DoUnpack must therefore
+     *  only change the data of its own unpacker. 0 or 1: no extra threads */
+    void SetUnpackThreads(Int_t nThreads) { fNUnpackThreads = nThreads; }
+    Int_t GetUnpackThreads() const { return fNUnpackThreads; }
+
   protected:
     Bool_t Unpack(Int_t* data, Int_t size,
                   Short_t type, Short_t subType,
                   Short_t procId, Short_t subCrate, Short_t control);
 
+    /** Collect a sub-event of the current event for UnpackSubEvents, the data
+     *  has to stay valid until UnpackSubEvents returns */
+    void AddSubEvent(Int_t* data, Int_t size,
+                     Short_t type, Short_t subType,
+                     Short_t procId, Short_t subCrate, Short_t control);
+    /** Unpack and forget the collected sub-events. Returns kTRUE if at least one
+     *  sub-event was unpacked by all its unpackers without error. With requireAll
+     *  every sub-event needs an unpacker and must be unpacked without error, without
+     *  threads the unpacking stops at the first failing sub-event like Unpack calls
+     *  in a loop */
+    Bool_t UnpackSubEvents(Bool_t requireAll = kFALSE);
+
   private:
+    /** Sub-event key (type, subType, procId, control packed, subCrate)
+     *  to the indices of the matching unpackers in registration order */
+    struct DispatchTable;
+    /** Collected sub-events, their unpacking jobs and the unpacking threads */
+    struct UnpackPool;
+
+    void BuildDispatchTable();
+    const std::vector<Int_t>& FindUnpackers(Short_t type, Short_t subType,
+                                            Short_t procId, Short_t subCrate, Short_t control);
+    Bool_t StartUnpackThreads();
+    void StopUnpackThreads();
+    /** Take jobs of the current event until none is left */
+    void RunUnpackJobs();
+    /** Main function of the unpacking threads */
+    static void* RunUnpackThread(void* arg);
+
     TObjArray* fUnpackers;
+    DispatchTable* fDispatch; //!
+    std::vector<Long64_t> fUnpackCalls; //!
+    std::vector<Long64_t> fUnpackTime;  //!
+    Long64_t fNUnknown; //!
+    Int_t fNUnpackThreads;
+    UnpackPool* fPool; //!
+
+    FairMbsSource& operator=(const FairMbsSource&);
 
     ClassDef(FairMbsSource, 0)
 };
@@ -129,11 +129,15 @@ Int_t FairMbsStreamSource::ReadEvent()
     sesubcrate = fxSubEvent->h_subcrate;
     secontrol = fxSubEvent->h_control;
 
-    if(! Unpack(fxEventData, sebuflength,
+    // the sub-events are collected first, they can be unpacked in parallel
+    AddSubEvent(fxEventData, sebuflength,
                 setype, sesubtype,
-                seprocid, sesubcrate, secontrol)) {
-      return 2;
-    }
+                seprocid, sesubcrate, secontrol);
+  }
+
+  // like before, the event fails if one of its sub-events fails
+  if(nrSubEvts > 0 && ! UnpackSubEvents(kTRUE)) {
+    return 2;
   }
 
   return 0;
@@ -29,6 +29,7 @@
 #include "FairRuntimeDb.h"              // for FairRuntimeDb
 #include "TRandom.h"                    // for TRandom, gRandom
 #include "TROOT.h"
+#include "TTreeCacheUnzip.h"            // for TTreeCacheUnzip
 #include <list>                         // for _List_iterator, list, etc
 using std::map;
 using std::set;
@@ -70,7 +71,11 @@ FairMixedSource::FairMixedSource(TFile *f, const char* Title, UInt_t identifier)
    fSBRatiobyN(kFALSE),
   fSBRatiobyT(kFALSE),
   fNoOfEntries(-1),
-  IsInitialized(kFALSE)
+  IsInitialized(kFALSE),
+  fPrefetchDepth(0),
+  fNReadEvents(0),
+  fNReadStalls(0),
+  fReadTimer()
 {
    if (fRootFile->IsZombie()) {
      LOG(FATAL) << "Error opening the Input file" << FairLogger::endl;
@@ -116,7 +121,11 @@ FairMixedSource::FairMixedSource(const TString* RootFileName, const char* Title,
    fSBRatiobyN(kFALSE),
   fSBRatiobyT(kFALSE),
  fNoOfEntries(-1),
- IsInitialized(kFALSE)
+ IsInitialized(kFALSE),
+  fPrefetchDepth(0),
+  fNReadEvents(0),
+  fNReadStalls(0),
+  fReadTimer()
 {
   fRootFile = new TFile(RootFileName->Data());
   if (fRootFile->IsZombie()) {
@@ -162,7 +171,11 @@ FairMixedSource::FairMixedSource(const TString RootFileName, const Int_t signalI
    fSBRatiobyN(kFALSE),
   fSBRatiobyT(kFALSE),
   fNoOfEntries(-1),
-  IsInitialized(kFALSE) 
+  IsInitialized(kFALSE),
+  fPrefetchDepth(0),
+  fNReadEvents(0),
+  fNReadStalls(0),
+  fReadTimer() 
 {
     fRootFile = new TFile(RootFileName.Data());
 
@@ -305,6 +318,14 @@ Bool_t FairMixedSource::Init()
     }
     FairRootManager::Instance()->SetListOfFolders(fListFolder);
 
+    if ( fPrefetchDepth > 0 ) {
+      InitPrefetching(fBackgroundChain);
+      std::map<UInt_t, TChain*>::const_iterator iterChain;
+      for(iterChain = fSignalTypeList.begin(); iterChain != fSignalTypeList.end(); iterChain++) {
+        InitPrefetching(iterChain->second);
+      }
+    }
+
     fBackgroundChain->GetEntry(0);
     if ( fEvtHeader ) {
       fOutHeader->SetRunId      (fEvtHeader->GetRunId());
@@ -343,7 +364,7 @@ Int_t FairMixedSource::ReadEvent(UInt_t i)
       if(SBratio <=ratio) {
         TChain* chain = fSignalTypeList[iterN->first];
         UInt_t entry = fCurrentEntry[iterN->first];
-        chain->GetEntry(entry);
+        ReadChainEntry(chain, entry);
         fOutHeader->SetMCEntryNumber(entry);
         fOutHeader->SetInputFileId(iterN->first);
         fOutHeader->SetEventTime(GetEventTime());
@@ -355,7 +376,7 @@ Int_t FairMixedSource::ReadEvent(UInt_t i)
     }
     if(!GetASignal) {
       UInt_t entry = fCurrentEntry[0];
-      fBackgroundChain->GetEntry(entry);
+      ReadChainEntry(fBackgroundChain, entry);
       fOutHeader->SetMCEntryNumber(entry);
       fOutHeader->SetInputFileId(0); //Background files has always 0 as Id
       fOutHeader->SetEventTime(GetEventTime());
@@ -373,6 +394,65 @@ Int_t FairMixedSource::ReadEvent(UInt_t i)
 }
 void FairMixedSource::Close()
 {
+  if ( fPrefetchDepth > 0 ) {
+    PrintPrefetchStatistics();
+  }
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairMixedSource::InitPrefetching(TChain* chain)
+{
+  // Same as in FairFileSource: one cache per chain which holds at least
+  // one cluster, the baskets are unzipped by a TTreeCacheUnzip thread.
+  chain->LoadTree(0);
+  TTree* tree = chain->GetTree();
+  if ( !tree || tree->GetEntries() == 0 ) {
+    return;
+  }
+  Long64_t nEntries = fPrefetchDepth;
+  if ( tree->GetAutoFlush() > nEntries ) {
+    nEntries = tree->GetAutoFlush();
+  }
+  Long64_t cacheSize = nEntries * (tree->GetZipBytes() / tree->GetEntries() + 1);
+  chain->SetParallelUnzip(kTRUE);
+  chain->SetCacheSize(cacheSize);
+  chain->AddBranchToCache("*", kTRUE);
+  chain->LoadTree(0);
+  LOG(INFO) << "FairMixedSource: read ahead of " << fPrefetchDepth
+            << " entries on chain " << chain->GetName()
+            << ", cache size " << cacheSize << " bytes" << FairLogger::endl;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+Int_t FairMixedSource::ReadChainEntry(TChain* chain, Long64_t entry)
+{
+  Int_t nMissesBefore = 0;
+  TTreeCacheUnzip* cache = 0;
+  if ( fPrefetchDepth > 0 && chain->LoadTree(entry) >= 0 && chain->GetTree()->GetCurrentFile() ) {
+    cache = dynamic_cast<TTreeCacheUnzip*>(chain->GetTree()->GetCurrentFile()->GetCacheRead(chain->GetTree()));
+    if ( cache ) {
+      nMissesBefore = cache->GetNMissed();
+    }
+  }
+  fReadTimer.Start(kFALSE);
+  Int_t nBytes = chain->GetEntry(entry);
+  fReadTimer.Stop();
+  fNReadEvents++;
+  if ( cache && cache->GetNMissed() > nMissesBefore ) {
+    fNReadStalls++;
+  }
+  return nBytes;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairMixedSource::PrintPrefetchStatistics()
+{
+  LOG(INFO) << "FairMixedSource: " << fNReadEvents << " entries read in "
+            << fReadTimer.RealTime() << " s, the event loop waited for data "
+            << fNReadStalls << " times" << FairLogger::endl;
 }
 void FairMixedSource::Reset()
 {
@@ -615,7 +695,7 @@ void  FairMixedSource::ReadBKEvent(UInt_t i)
     Int_t totEnt = fBackgroundChain->GetEntries();
     LOG(INFO) << "The number of entries in background chain is " << totEnt << FairLogger::endl;
   }
-  fBackgroundChain->GetEntry(i);
+  ReadChainEntry(fBackgroundChain, i);
 }
 //_____________________________________________________________________________
 
@@ -21,6 +21,7 @@
 #include "TChain.h"
 #include "TFile.h"
 #include "TF1.h"
+#include "TStopwatch.h"
 
 class FairEventHeader;
 class FairFileHeader;
@@ -118,7 +119,22 @@ public:
     void                SetEvtHeaderNew(Bool_t Status) {fEvtHeaderIsNew = Status;}
     Bool_t              IsEvtHeaderNew() {return fEvtHeaderIsNew;}
 
+    /** Read and unzip the next nEntries entries of the background and
+     *  signal chains in the background while the current entry is processed.
+     *  Has to be set before Init, 0 (default) switches the read ahead off.
+     */
+    void                SetPrefetchDepth(Int_t nEntries) {fPrefetchDepth = nEntries;}
+    /** Print the time spent reading entries and how often the event loop
+     *  had to wait for data which was not yet prefetched*/
+    void                PrintPrefetchStatistics();
+    Int_t               GetNReadStalls() const {return fNReadStalls;}
+
 private:
+    /** Enable the read ahead cache with background unzipping on a chain*/
+    void                InitPrefetching(TChain* chain);
+    /** Read an entry of one of the input chains and update the read statistics*/
+    Int_t               ReadChainEntry(TChain* chain, Long64_t entry);
+
     /**IO manager */
     FairRootManager*         fRootManager;
 
@@ -208,6 +224,15 @@ private:
     /**Chain containing the background*/
     TChain*                              fBackgroundChain; //!
     std::map<UInt_t, TChain*>            fSignalTypeList;//!
+
+    /** Number of entries read ahead, 0 means no read ahead */
+    Int_t                                fPrefetchDepth; //!
+    /** Number of entries read from the input chains */
+    Int_t                                fNReadEvents; //!
+    /** Number of entries for which the event loop had to wait for data */
+    Int_t                                fNReadStalls; //!
+    /** Time spent reading entries */
+    TStopwatch                           fReadTimer; //!
     
 public:
     ClassDef(FairMixedSource, 0)
@@ -76,13 +76,15 @@ Int_t FairRemoteSource::ReadEvent()
   // Decode event header
   Bool_t result = Unpack(fREvent->GetData(), sizeof(sMbsEv101), -2, -2, -2, -2, -2);
 
+  // the sub-events are collected first, they can be unpacked in parallel
   for(Int_t i = 0; i < fREvent->nSubEvt; i++) {
-    if(Unpack(fREvent->pSubEvt[i], fREvent->subEvtSize[i],
-              fREvent->subEvtType[i], fREvent->subEvtSubType[i],
-              fREvent->subEvtProcId[i], fREvent->subEvtSubCrate[i],
-              fREvent->subEvtControl[i])) {
-      result = kTRUE;
-    }
+    AddSubEvent(fREvent->pSubEvt[i], fREvent->subEvtSize[i],
+                fREvent->subEvtType[i], fREvent->subEvtSubType[i],
+                fREvent->subEvtProcId[i], fREvent->subEvtSubCrate[i],
+                fREvent->subEvtControl[i]);
+  }
+  if(UnpackSubEvents()) {
+    result = kTRUE;
   }
 
   if(! result) {
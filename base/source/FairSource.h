@@ -42,6 +42,10 @@ class FairSource : public TObject
     virtual void   ReadBranchEvent(const char* BrName) {return;}
     virtual void   ReadBranchEvent(const char* BrName, Int_t Event) {return;}
     virtual void FillEventHeader(FairEventHeader* feh) { return; } 
+    /** Create an independent, not yet initialized copy of this source for
+     *  a worker thread (see FairRunAna::SetNumberOfThreads). Sources which
+     *  can not be read in parallel return 0. */
+    virtual FairSource* CloneForWorker() const { return 0; }
 
   public:
     ClassDef(FairSource, 1)
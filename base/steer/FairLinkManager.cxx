@@ -27,7 +27,7 @@ FairLinkManager::FairLinkManager()
   : TObject(),
     fIgnoreTypes(),
     fIgnoreSetting(kTRUE),
-    fLogger(0)
+    fLogger(FairLogger::GetLogger())
 {
   if (fgInstance) {
     Fatal("FairLinkManager", "Singleton instance already exists.");
@@ -35,11 +35,6 @@ FairLinkManager::FairLinkManager()
   }
 //  std::cout << "-I- FairLinkManager::FairLinkManager created!" << std::endl;
   fgInstance = this;
-
-  // Logger only on master - TO DO
-  if ( FairRun::Instance()->GetIsMaster() ) {
-    fLogger = FairLogger::GetLogger();
-  }
 }
 //_____________________________________________________________________________
 FairLinkManager::~FairLinkManager()
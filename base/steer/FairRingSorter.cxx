@@ -15,17 +15,63 @@
 
 #include "FairTimeStamp.h"              // for FairTimeStamp
 
+#include <algorithm>                    // for stable_sort
+
+namespace {
+struct TimeLess {
+  bool operator()(const std::pair<double, FairTimeStamp*>& a, const std::pair<double, FairTimeStamp*>& b) const {
+    return a.first < b.first;
+  }
+};
+}
+
+FairRingSorter::~FairRingSorter()
+{
+  // elements still in the ring were never handed out
+  for (size_t i = 0; i < fRingBuffer.size(); i++) {
+    for (size_t j = 0; j < fRingBuffer[i].size(); j++) {
+      delete fRingBuffer[i][j].second;
+    }
+  }
+  if (fRecycleElements) {
+    for (size_t i = 0; i < fOutputData.size(); i++) {
+      delete fOutputData[i];
+    }
+    for (size_t i = 0; i < fFreeElements.size(); i++) {
+      delete fFreeElements[i];
+    }
+  }
+}
+
 FairTimeStamp* FairRingSorter::CreateElement(FairTimeStamp* data)
 {
 	return (FairTimeStamp*)data->Clone();
 }
 
+FairTimeStamp* FairRingSorter::CopyElement(FairTimeStamp*, FairTimeStamp*)
+{
+  return 0;
+}
+
+FairTimeStamp* FairRingSorter::NewElement(FairTimeStamp* data)
+{
+  if (!fFreeElements.empty()) {
+    FairTimeStamp* recycled = fFreeElements.back();
+    fFreeElements.pop_back();
+    FairTimeStamp* element = CopyElement(data, recycled);
+    if (element) {
+      return element;
+    }
+    delete recycled;
+  }
+  return CreateElement(data);
+}
+
 void FairRingSorter::AddElement(FairTimeStamp* digi, double timestamp)
 {
-  FairTimeStamp* newElement = CreateElement(digi);
   if (timestamp < fLowerBoundPointer.second) {
     std::cout << "-E- Timestamp " << timestamp << " below lower bound " << fLowerBoundPointer.second << std::endl;
-    newElement->Print();
+    digi->Print();
     return;
   }
   int index = CalcIndex(timestamp);
@@ -46,7 +92,11 @@ void FairRingSorter::AddElement(FairTimeStamp* digi, double timestamp)
     WriteOutElements(index+1);
     SetLowerBound(timestamp);
   }
-  fRingBuffer[index].insert(std::pair<double, FairTimeStamp*> (timestamp, newElement));
+  std::vector<TimeElement>& cell = fRingBuffer[index];
+  if (!cell.empty() && timestamp < cell.back().first) {
+    fCellSorted[index] = 0;
+  }
+  cell.push_back(TimeElement(timestamp, NewElement(digi)));
 }
 
 void FairRingSorter::SetLowerBound(double timestampOfHitToWrite)
@@ -86,26 +136,39 @@ void FairRingSorter::WriteOutElements(int index)
 
 void FairRingSorter::WriteOutElement(int index)
 {
-  std::multimap<double, FairTimeStamp*>* myDataField = &fRingBuffer.at(index);
-  std::multimap<double, FairTimeStamp*>::iterator it;
-  if (!myDataField->empty()) {
+  std::vector<TimeElement>& myDataField = fRingBuffer.at(index);
+  if (!myDataField.empty()) {
+    // equal time stamps keep their order of arrival like in a multimap
+    if (!fCellSorted[index]) {
+      std::stable_sort(myDataField.begin(), myDataField.end(), TimeLess());
+      fCellSorted[index] = 1;
+    }
     if (fVerbose > 1) {
 		std::cout << "-I- FairRingSorter:WriteOutElement ";
-		myDataField->begin()->second->Print();
+		myDataField.front().second->Print();
 		std::cout << std::endl;
     }
-    for (it = myDataField->begin(); it != myDataField->end(); it++) {
-      fOutputData.push_back(it->second);
+    for (size_t i = 0; i < myDataField.size(); i++) {
+      fOutputData.push_back(myDataField[i].second);
     }
-    myDataField->clear();
+    // the capacity of the cell stays for the next turn of the ring
+    myDataField.clear();
+  }
+}
+
+void FairRingSorter::DeleteOutputData()
+{
+  if (fRecycleElements) {
+    fFreeElements.insert(fFreeElements.end(), fOutputData.begin(), fOutputData.end());
   }
+  fOutputData.clear();
 }
 
 int FairRingSorter::CalcIndex(double val)
 {
   int index = (int)(val / fCellWidth);
-  while (index >= fRingBuffer.size()) {
-    index -= fRingBuffer.size();
+  if (index >= (int)fRingBuffer.size()) {
+    index %= fRingBuffer.size();
   }
   return index;
 }
@@ -22,23 +22,33 @@
 #include "Rtypes.h"                     // for FairRingSorter::Class, etc
 
 #include <iostream>                     // for operator<<, ostream, etc
-#include <map>                          // for multimap
 #include <utility>                      // for pair
 #include <vector>                       // for vector
 
 class FairTimeStamp;
 
+/**
+ * Sorts data by time stamp with a ring of time cells. The elements of a cell
+ * are appended to a vector and sorted when the cell is written out.
+ *
+ * Elements are copies made by CreateElement(). A sorter which implements
+ * CopyElement() and calls SetRecycleElements(kTRUE) owns its elements:
+ * the consumer has to copy the output data before DeleteOutputData(), which
+ * gives the elements back to the sorter to be overwritten by the next data.
+ */
 class FairRingSorter : public TObject
 {
   public:
     FairRingSorter(int size = 100, double width = 10)
-      : TObject(), fRingBuffer(size), fOutputData(), fLowerBoundPointer(0,0),
-        fCellWidth(width), fVerbose(0) {
+      : TObject(), fRingBuffer(size), fCellSorted(size, 1), fOutputData(), fFreeElements(),
+        fLowerBoundPointer(0,0), fCellWidth(width), fVerbose(0), fRecycleElements(kFALSE) {
     }
 
-    virtual ~FairRingSorter() {};
+    virtual ~FairRingSorter();
 
     virtual FairTimeStamp* CreateElement(FairTimeStamp* data);
+    /** Copies data into an element given back by DeleteOutputData(), returns 0 if the sorter cannot do this */
+    virtual FairTimeStamp* CopyElement(FairTimeStamp* data, FairTimeStamp* recycled);
 
     virtual void AddElement(FairTimeStamp* digi, double timestamp);
     virtual void WriteOutElements(int index);       ///< writes out the entries from LowerBoundPointer up to index
@@ -50,10 +60,22 @@ class FairRingSorter : public TObject
     virtual std::vector<FairTimeStamp*> GetOutputData() {
       return fOutputData;
     }
+    /** Sorted data without copying the vector, valid until DeleteOutputData() */
+    const std::vector<FairTimeStamp*>& GetOutputDataRef() const {
+      return fOutputData;
+    }
+    /** Exchanges the sorted data with the content of data, the caller takes over the elements */
+    virtual void SwapOutputData(std::vector<FairTimeStamp*>& data) {
+      fOutputData.swap(data);
+    }
 
-    virtual void DeleteOutputData() {fOutputData.clear(); }
+    virtual void DeleteOutputData();
     virtual void SetLowerBound(double timestampOfHitToWrite);
 
+    /** Keep the written out elements for the following data instead of handing them over to the consumer */
+    void SetRecycleElements(Bool_t recycle = kTRUE) {fRecycleElements = recycle;}
+    Bool_t GetRecycleElements() const {return fRecycleElements;}
+
     virtual void print(std::ostream& out = std::cout) {
       out << "RingSorter: Size " << fRingBuffer.size() << " CellWidth: " << fCellWidth << std::endl;
       out << "LowerBoundPointer at index: " << fLowerBoundPointer.first << " Time: " << fLowerBoundPointer.second << std::endl;
@@ -66,14 +88,24 @@ class FairRingSorter : public TObject
 
 
   private:
+    typedef std::pair<double, FairTimeStamp*> TimeElement;
+
     int CalcIndex(double val);
-    std::vector<std::multimap<double, FairTimeStamp*> > fRingBuffer;
+    FairTimeStamp* NewElement(FairTimeStamp* data);
+
+    std::vector<std::vector<TimeElement> > fRingBuffer;
+    std::vector<char> fCellSorted; //! cell was filled in time order
     std::vector<FairTimeStamp*> fOutputData;
+    std::vector<FairTimeStamp*> fFreeElements; //! written out elements waiting to be reused
     std::pair<int, double> fLowerBoundPointer;
     double fCellWidth;
     int fVerbose;
+    Bool_t fRecycleElements;
+
+    FairRingSorter(const FairRingSorter&);
+    FairRingSorter& operator=(const FairRingSorter&);
 
-    ClassDef(FairRingSorter,1)
+    ClassDef(FairRingSorter,2)
 
 };
 
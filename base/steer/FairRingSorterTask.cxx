@@ -78,7 +78,7 @@ void FairRingSorterTask::Exec(Option_t* opt)
   }
   if (fVerbose > 2) { fSorter->Print(); }
 
-  std::vector<FairTimeStamp*> sortedData = fSorter->GetOutputData();
+  const std::vector<FairTimeStamp*>& sortedData = fSorter->GetOutputDataRef();
 
 
   fOutputArray = FairRootManager::Instance()->GetEmptyTClonesArray(fOutputBranch);
@@ -114,7 +114,7 @@ void FairRingSorterTask::FinishTask()
   }
   fSorter->Print();
   fSorter->WriteOutAll();
-  std::vector<FairTimeStamp*> sortedData = fSorter->GetOutputData();
+  const std::vector<FairTimeStamp*>& sortedData = fSorter->GetOutputDataRef();
 
   FairRootManager* ioman = FairRootManager::Instance();
   fOutputArray = ioman->GetEmptyTClonesArray(fOutputBranch);
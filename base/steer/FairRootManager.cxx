@@ -24,33 +24,44 @@
 #include "FairMCEventHeader.h"          // for FairMCEventHeader
 #include "FairRun.h"                    // for FairRun
 #include "FairTSBufferFunctional.h"     // for FairTSBufferFunctional, etc
+#include "FairTimeIndex.h"              // for FairTimeIndex
+#include "FairTimeSlice.h"              // for FairTimeSlice
 #include "FairWriteoutBuffer.h"         // for FairWriteoutBuffer
 #include "FairLinkManager.h"            // for FairLinkManager
 #include "Riosfwd.h"                    // for ostream
+#include "RVersion.h"                   // for ROOT_VERSION_CODE, ROOT_VERSION
 #include "TArrayI.h"                    // for TArrayI
 #include "TBranch.h"                    // for TBranch
+#include "TBranchElement.h"             // for TBranchElement
+#include "TBufferFile.h"                // for TBufferFile
 #include "TChainElement.h"              // for TChainElement
 #include "TClass.h"                     // for TClass
 #include "TClonesArray.h"               // for TClonesArray
+#include "TCondition.h"                 // for TCondition
 #include "TCollection.h"                // for TCollection, TIter
 #include "TF1.h"                        // for TF1
 #include "TFolder.h"                    // for TFolder
 #include "TGeoManager.h"                // for TGeoManager, gGeoManager
+#include "THashTable.h"                 // for THashTable
 #include "TIterator.h"                  // for TIterator
 #include "TList.h"                      // for TList
 #include "TMath.h"                      // for floor
+#include "TMutex.h"                     // for TMutex
 #include "TNamed.h"                     // for TNamed
 #include "TObjArray.h"                  // for TObjArray
 #include "TObjString.h"                 // for TObjString
 #include "TROOT.h"                      // for TROOT, gROOT
 #include "TRandom.h"                    // for TRandom, gRandom
+#include "TThread.h"                    // for TThread
 #include "TTree.h"                      // for TTree
 #include "TRefArray.h"                  // for TRefArray
 
 #include <stdlib.h>                     // for exit
 #include <string.h>                     // for NULL, strcmp
 #include <algorithm>                    // for find
+#include <deque>                        // for deque
 #include <iostream>                     // for operator<<, basic_ostream, etc
+#include <limits>                       // for numeric_limits
 #include <list>                         // for _List_iterator, list, etc
 #include <map>                          // for map, _Rb_tree_iterator, etc
 #include <set>                          // for set, set<>::iterator
@@ -93,6 +104,7 @@ FairRootManager::FairRootManager()
     fActiveContainer(),
     fTSBufferMap(),
     fWriteoutBufferMap(),
+    fTimeIndexMap(),
     fInputBranchMap(),
     fTimeStamps(kFALSE),
     fBranchPerMap(kFALSE),
@@ -111,7 +123,18 @@ FairRootManager::FairRootManager()
     fListOfBranchesFromInput(0),
     fListOfBranchesFromInputIter(0),
     fListOfNonTimebasedBranches(new TRefArray()),
-    fListOfNonTimebasedBranchesIter(0)
+    fListOfNonTimebasedBranchesIter(0),
+    fMergeBuffer(0),
+    fAsyncQueueDepth(0),
+    fAsyncWriter(0),
+    fBranchIdTable(new THashTable()),
+    fBranchNameIndex(),
+    fBranchPersistency(),
+    fMCTrackBranchId(-1),
+    fTimeSliceLength(0.),
+    fTimeSliceOverlap(0.),
+    fTimeSliceOrigin(0.),
+    fTimeSlice(NULL)
   {
   if (fgInstance) {
     Fatal("FairRootManager", "Singleton instance already exists.");
@@ -126,6 +149,7 @@ FairRootManager::~FairRootManager()
 {
 //
   LOG(DEBUG) << "Enter Destructor of FairRootManager" << FairLogger::endl;
+  StopAsyncWriter();
   if(fOutTree) {
     delete fOutTree;
   }
@@ -134,8 +158,14 @@ FairRootManager::~FairRootManager()
     delete fOutFile;
   }
   delete fObj2;
+  delete fMergeBuffer;
+  delete fBranchIdTable;
   fBranchNameList->Delete();
   delete fBranchNameList;
+  for (std::map<TString, FairTimeIndex*>::iterator it = fTimeIndexMap.begin(); it != fTimeIndexMap.end(); it++) {
+    delete it->second;
+  }
+  delete fTimeSlice;
   fgInstance = 0;
   LOG(DEBUG) << "Leave Destructor of FairRootManager" << FairLogger::endl;
 }
@@ -243,6 +273,7 @@ void  FairRootManager::Register(const char* name, const char* folderName , TName
   //cout << " FairRootManager::Register Adding branch:(Obj) " << name << " In folder : " << folderName << endl;
  
   AddBranchToList(name);
+  UpdateBranchPersistency(name);
     
   if (toFile == kFALSE) {
           FairLinkManager::Instance()->AddIgnoreType(GetBranchId(name));
@@ -252,12 +283,51 @@ void  FairRootManager::Register(const char* name, const char* folderName , TName
 
 Int_t  FairRootManager::AddBranchToList(const char* name)
 {
-    if(fBranchNameList->FindObject(name)==0) {
-        fBranchNameList->AddLast(new TObjString(name));
+    if(fBranchIdTable->FindObject(name)==0) {
+        TObjString* ObjStr= new TObjString(name);
+        fBranchNameList->AddLast(ObjStr);
+        AddBranchToIndex(ObjStr, fBranchSeqId);
         fBranchSeqId++;
     }
     return fBranchSeqId;
 }
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairRootManager::AddBranchToIndex(TObjString* name, Int_t id)
+{
+  /** The id is kept in the unique id of the TObjString, so a lookup in
+   *  the hash table gives the id without scanning fBranchNameList*/
+  name->SetUniqueID(id);
+  if (fBranchIdTable->FindObject(name->GetName()) == 0) {
+    fBranchIdTable->Add(name);
+  }
+  if (id >= static_cast<Int_t>(fBranchNameIndex.size())) {
+    fBranchNameIndex.resize(id+1, 0);
+    fBranchPersistency.resize(id+1, -1);
+  }
+  fBranchNameIndex[id] = name;
+  fBranchPersistency[id] = -1;
+  if (fMCTrackBranchId < 0 && name->GetString() == "MCTrack") {
+    fMCTrackBranchId = id;
+  }
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairRootManager::RebuildBranchIndex()
+{
+  fBranchIdTable->Clear();
+  fBranchNameIndex.clear();
+  fBranchPersistency.clear();
+  fMCTrackBranchId = -1;
+  TIter next(fBranchNameList);
+  TObject* obj;
+  Int_t t=0;
+  while ((obj = next())) {
+    AddBranchToIndex(static_cast<TObjString*>(obj), t++);
+  }
+}
 
 
 //_____________________________________________________________________________
@@ -304,6 +374,7 @@ void  FairRootManager::Register(const char* name,const char* Foldername ,TCollec
   /**Keep the Object in Memory, and do not write it to the tree*/
   AddMemoryBranch(name, obj );
   AddBranchToList(name);
+  UpdateBranchPersistency(name);
   
   if (toFile == kFALSE) {
 	  FairLinkManager::Instance()->AddIgnoreType(GetBranchId(name));
@@ -359,9 +430,8 @@ TClonesArray* FairRootManager::GetTClonesArray(TString branchName)
 TString FairRootManager::GetBranchName(Int_t id)
 {
   /**Return the branch name from the id*/
-  if(id < fBranchSeqId) {
-    TObjString* ObjStr= (TObjString*) fBranchNameList->At(id);
-    return ObjStr->GetString();
+  if(id >= 0 && id < fBranchSeqId && id < static_cast<Int_t>(fBranchNameIndex.size())) {
+    return fBranchNameIndex[id]->GetString();
   } else {
     TString NotFound("Branch not found");
     return NotFound;
@@ -373,17 +443,11 @@ TString FairRootManager::GetBranchName(Int_t id)
 Int_t FairRootManager::GetBranchId(TString BrName)
 {
   /**Return the branch id from the name*/
-  TObjString* ObjStr;
-  Int_t Id=-1;
-  for(Int_t t=0; t<fBranchNameList->GetEntries(); t++) {
-    ObjStr= (TObjString*) fBranchNameList->At(t);
-    if(BrName==ObjStr->GetString()) {
-      Id=t;
-      break;
-    }
+  TObject* ObjStr= fBranchIdTable->FindObject(BrName.Data());
+  if(ObjStr) {
+    return ObjStr->GetUniqueID();
   }
-  return Id;
-
+  return -1;
 }
 //_____________________________________________________________________________
 
@@ -417,6 +481,98 @@ TClonesArray* FairRootManager::GetData(TString branchName, BinaryFunctor* startF
 }
 //_____________________________________________________________________________
 
+//_____________________________________________________________________________
+FairTSBufferFunctional* FairRootManager::GetTimeSliceBuffer(TString branchName)
+{
+  std::map<TString, FairTSBufferFunctional*>::iterator it = fTSBufferMap.find(branchName);
+  if (it != fTSBufferMap.end() && it->second != 0) {
+    return it->second;
+  }
+  TTree* inTree = GetInTree();
+  if (inTree == 0 || inTree->GetBranch(branchName) == 0) {
+    return 0;
+  }
+  FairTSBufferFunctional* buffer = new FairTSBufferFunctional(branchName, inTree, 0);
+  fTSBufferMap[branchName] = buffer;
+  return buffer;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+Int_t FairRootManager::GetNTimeSlices()
+{
+  if (fTimeSliceLength <= 0.) {
+    LOG(ERROR) << "FairRootManager::GetNTimeSlices() The length of the time slices is not set" << FairLogger::endl;
+    return 0;
+  }
+  Double_t firstTime = std::numeric_limits<Double_t>::max();
+  Double_t lastTime = -std::numeric_limits<Double_t>::max();
+  TIter next(fTimeBasedBranchNameList);
+  TObject* obj;
+  while ((obj = next())) {
+    FairTSBufferFunctional* buffer = GetTimeSliceBuffer(obj->GetName());
+    if (buffer == 0) {
+      continue;
+    }
+    FairTimeIndex* timeIndex = buffer->GetTimeIndex();
+    Int_t nEntries = timeIndex->GetNEntries();
+    if (nEntries == 0) {
+      continue;
+    }
+    if (timeIndex->GetMinTimeFrom(0) < firstTime) { firstTime = timeIndex->GetMinTimeFrom(0); }
+    if (timeIndex->GetMaxTimeUpTo(nEntries - 1) > lastTime) { lastTime = timeIndex->GetMaxTimeUpTo(nEntries - 1); }
+  }
+  if (firstTime > lastTime) {
+    LOG(WARNING) << "FairRootManager::GetNTimeSlices() No data in time based input branches" << FairLogger::endl;
+    return 0;
+  }
+  // the slices start at multiples of their length
+  fTimeSliceOrigin = TMath::Floor(firstTime / fTimeSliceLength) * fTimeSliceLength;
+  return static_cast<Int_t>((lastTime - fTimeSliceOrigin) / fTimeSliceLength) + 1;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+Int_t FairRootManager::ReadTimeSlice(Int_t i)
+{
+  if (fTimeSliceLength <= 0.) {
+    LOG(ERROR) << "FairRootManager::ReadTimeSlice() The length of the time slices is not set" << FairLogger::endl;
+    return 1;
+  }
+  if (fTimeSlice == 0) {
+    fTimeSlice = new FairTimeSlice();
+  }
+  Double_t startTime = fTimeSliceOrigin + i * fTimeSliceLength;
+  *fTimeSlice = FairTimeSlice(i, startTime, startTime + fTimeSliceLength, fTimeSliceOverlap);
+  fCurrentTime = startTime;
+  return 0;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairRootManager::ResetTimeSlice()
+{
+  delete fTimeSlice;
+  fTimeSlice = 0;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+TObjArray* FairRootManager::GetTimeSliceData(TString branchName)
+{
+  if (fTimeSlice == 0) {
+    LOG(ERROR) << "FairRootManager::GetTimeSliceData() No time slice was read" << FairLogger::endl;
+    return 0;
+  }
+  FairTSBufferFunctional* buffer = GetTimeSliceBuffer(branchName);
+  if (buffer == 0) {
+    LOG(ERROR) << "FairRootManager::GetTimeSliceData() Branch " << branchName << " is not in the input" << FairLogger::endl;
+    return 0;
+  }
+  return buffer->GetTimeSliceData(fTimeSlice->GetStartTime(), fTimeSlice->GetOverlapEndTime());
+}
+//_____________________________________________________________________________
+
 //_____________________________________________________________________________
 void FairRootManager::TerminateTSBuffer(TString branchName)
 {
@@ -450,24 +606,283 @@ Bool_t FairRootManager::AllDataProcessed()
 }
 //_____________________________________________________________________________
 
+//_____________________________________________________________________________
+/** Output of one event handed from Fill() to the writer thread*/
+struct FairRootManagerWriterEvent
+{
+  FairRootManagerWriterEvent() : fArrays(), fSnapshot(TBuffer::kWrite) {}
+  std::vector<TClonesArray*> fArrays;    // objects moved out of the persistent TClonesArrays, 0 for other objects
+  TBufferFile                fSnapshot;  // streamed copy of the persistent objects which are not TClonesArrays
+};
+
+/** State shared between FairRootManager::Fill and the writer thread*/
+struct FairRootManagerWriter
+{
+  FairRootManagerWriter() : fMutex(), fCondition(&fMutex), fTree(0), fBranches(), fAddresses(), fSources(), fSourceArrays(), fTargets(),
+    fQueue(), fFree(), fThread(0), fMaxQueued(0), fNFilled(0), fNWaits(0), fBusy(kFALSE), fStop(kFALSE) {}
+  TMutex                     fMutex;
+  TCondition                 fCondition;
+  TTree*                     fTree;
+  std::vector<TBranch*>      fBranches;     // top level branches of the output tree
+  std::vector<void*>         fAddresses;    // original branch addresses
+  std::vector<TObject*>      fSources;      // registered objects, used by the tasks
+  std::vector<TClonesArray*> fSourceArrays; // fSources which are TClonesArrays, 0 for other objects
+  std::vector<TObject*>      fTargets;      // writer owned objects bound to the tree
+  std::deque<FairRootManagerWriterEvent*>  fQueue; // events waiting to be filled
+  std::vector<FairRootManagerWriterEvent*> fFree;  // events for reuse
+  TThread*                   fThread;
+  Int_t                      fMaxQueued;
+  Int_t                      fNFilled;      // number of filled events
+  Int_t                      fNWaits;       // number of times Fill() waited for the writer
+  Bool_t                     fBusy;         // writer is filling an event
+  Bool_t                     fStop;
+};
+
 //_____________________________________________________________________________
 void FairRootManager::Fill()
 {
   if (fOutTree != 0) {
-    fOutTree->Fill();
+    FillTimeIndex();
+    if (fAsyncQueueDepth > 0 && fAsyncWriter == 0 && !StartAsyncWriter()) {
+      fAsyncQueueDepth = 0;
+    }
+    if (fAsyncWriter == 0) {
+      fOutTree->Fill();
+      return;
+    }
+    FairRootManagerWriter* writer = fAsyncWriter;
+    FairRootManagerWriterEvent* event = 0;
+    writer->fMutex.Lock();
+    if (static_cast<Int_t>(writer->fQueue.size()) >= writer->fMaxQueued) {
+      writer->fNWaits++;
+      while (static_cast<Int_t>(writer->fQueue.size()) >= writer->fMaxQueued) {
+        writer->fCondition.Wait();
+      }
+    }
+    if (!writer->fFree.empty()) {
+      event = writer->fFree.back();
+      writer->fFree.pop_back();
+    }
+    writer->fMutex.UnLock();
+
+    if (event == 0) {
+      event = new FairRootManagerWriterEvent();
+      event->fArrays.resize(writer->fSources.size(), 0);
+    }
+    /** The objects of the persistent TClonesArrays are moved to arrays of the
+     *  event without copying them, so the tasks start the next event with
+     *  empty arrays. Only the other persistent objects, e.g. the event
+     *  headers, are streamed into the snapshot of the event.
+     */
+    event->fSnapshot.Reset();
+    event->fSnapshot.SetWriteMode();
+    for (UInt_t i = 0; i < writer->fSources.size(); i++) {
+      TClonesArray* source = writer->fSourceArrays[i];
+      if (source != 0) {
+        event->fArrays[i] = new TClonesArray(source->GetClass(), TMath::Max(source->GetEntriesFast(), 1));
+        event->fArrays[i]->AbsorbObjects(source);
+      } else {
+        writer->fSources[i]->Streamer(event->fSnapshot);
+      }
+    }
+
+    writer->fMutex.Lock();
+    writer->fQueue.push_back(event);
+    writer->fCondition.Broadcast();
+    writer->fMutex.UnLock();
   } else {
     LOG(INFO) << " No Output Tree" << FairLogger::endl;
   }
 }
 //_____________________________________________________________________________
 
+//_____________________________________________________________________________
+void FairRootManager::FillTimeIndex()
+{
+  /** The writeout buffers have put the data of this entry into their arrays,
+   *  one index entry is added per output tree entry */
+  for (std::map<TString, FairWriteoutBuffer*>::iterator it = fWriteoutBufferMap.begin(); it != fWriteoutBufferMap.end(); it++) {
+    if (it->second == 0 || !it->second->IsBufferingActivated()) {
+      continue;
+    }
+    FairTimeIndex*& index = fTimeIndexMap[it->first];
+    if (index == 0) {
+      if (fOutTree->GetBranch(it->first) == 0) {
+        continue;     // memory branch
+      }
+      index = new FairTimeIndex();
+    }
+    std::map<TString, TClonesArray*>::iterator array = fActiveContainer.find(it->first);
+    index->AddEntry(array != fActiveContainer.end() ? array->second : 0);
+  }
+}
+//_____________________________________________________________________________
+
 //_____________________________________________________________________________
 void FairRootManager::LastFill()
 {
+  // the histograms are written to the output file, which is used by the writer thread
+  FlushAsyncWrite();
   FairMonitor::GetMonitor()->StoreHistograms(fOutFile);
   if (fFillLastData) {
     Fill();
   }
+  FlushAsyncWrite();
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairRootManager::FlushAsyncWrite()
+{
+  if (fAsyncWriter == 0) {
+    return;
+  }
+  fAsyncWriter->fMutex.Lock();
+  while (!fAsyncWriter->fQueue.empty() || fAsyncWriter->fBusy) {
+    fAsyncWriter->fCondition.Wait();
+  }
+  fAsyncWriter->fMutex.UnLock();
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+Bool_t FairRootManager::StartAsyncWriter()
+{
+  /** The top level branches of the output tree point to the registered
+   *  objects. Each branch is bound to an object owned by the writer. At
+   *  the hand-off in Fill() the content of the registered objects moves to
+   *  an event queued for the writer thread, which moves it into its own
+   *  objects and fills the tree. Afterwards the writer and the event loop
+   *  share no objects, so the tasks work on the next event while the last
+   *  one is compressed and written.
+   */
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+  ROOT::EnableThreadSafety();
+#else
+  LOG(WARNING) << "FairRootManager: the writer thread needs ROOT::EnableThreadSafety() of ROOT 6.06,"
+               << " the output tree is filled synchronously" << FairLogger::endl;
+  return kFALSE;
+#endif
+  FairRootManagerWriter* writer = new FairRootManagerWriter();
+  writer->fTree = fOutTree;
+  writer->fMaxQueued = fAsyncQueueDepth;
+  TObjArray* branches = fOutTree->GetListOfBranches();
+  for (Int_t i = 0; i < branches->GetEntriesFast(); i++) {
+    TBranchElement* branch = dynamic_cast<TBranchElement*>(branches->At(i));
+    TObject* source = 0;
+    if (branch != 0) {
+      for (std::map<TString, TObject*>::const_iterator iter = fMap.begin(); iter != fMap.end(); iter++) {
+        if (reinterpret_cast<char*>(iter->second) == branch->GetObject()) {
+          source = iter->second;
+          break;
+        }
+      }
+    }
+    if (source == 0) {
+      LOG(WARNING) << "FairRootManager: branch " << branches->At(i)->GetName()
+                   << " does not belong to a registered object, the output tree is filled synchronously"
+                   << FairLogger::endl;
+      delete writer;
+      return kFALSE;
+    }
+    writer->fBranches.push_back(branch);
+    writer->fAddresses.push_back(branch->GetAddress());
+    writer->fSources.push_back(source);
+    writer->fSourceArrays.push_back(dynamic_cast<TClonesArray*>(source));
+  }
+  // the branches keep the address of the pointers, so fTargets must not grow after this
+  writer->fTargets.resize(writer->fSources.size());
+  for (UInt_t i = 0; i < writer->fSources.size(); i++) {
+    if (writer->fSourceArrays[i] != 0) {
+      // an empty array, the objects of each event are moved in and out again
+      writer->fTargets[i] = new TClonesArray(writer->fSourceArrays[i]->GetClass());
+    } else {
+      writer->fTargets[i] = writer->fSources[i]->Clone();
+    }
+    writer->fBranches[i]->SetAddress(&writer->fTargets[i]);
+  }
+
+  TThread::Initialize();
+  fAsyncWriter = writer;
+  writer->fThread = new TThread("FairRootManagerWriter", &FairRootManager::RunAsyncWriter, writer);
+  writer->fThread->Run();
+  LOG(INFO) << "FairRootManager: output tree is filled by a writer thread, "
+            << fAsyncQueueDepth << " events are queued at most" << FairLogger::endl;
+  return kTRUE;
+}
+//_____________________________________________________________________________
+void FairRootManager::StopAsyncWriter()
+{
+  if (fAsyncWriter == 0) {
+    return;
+  }
+  FairRootManagerWriter* writer = fAsyncWriter;
+  writer->fMutex.Lock();
+  writer->fStop = kTRUE;
+  writer->fCondition.Broadcast();
+  writer->fMutex.UnLock();
+  writer->fThread->Join();
+  delete writer->fThread;
+  fAsyncWriter = 0;
+
+  for (UInt_t i = 0; i < writer->fBranches.size(); i++) {
+    writer->fBranches[i]->SetAddress(writer->fAddresses[i]);
+    delete writer->fTargets[i];
+  }
+  for (UInt_t i = 0; i < writer->fFree.size(); i++) {
+    delete writer->fFree[i];
+  }
+  LOG(INFO) << "FairRootManager: writer thread filled " << writer->fNFilled
+            << " events, the event loop waited " << writer->fNWaits
+            << " times for it" << FairLogger::endl;
+  delete writer;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void* FairRootManager::RunAsyncWriter(void* arg)
+{
+  FairRootManagerWriter* writer = static_cast<FairRootManagerWriter*>(arg);
+  writer->fMutex.Lock();
+  while (kTRUE) {
+    while (writer->fQueue.empty() && !writer->fStop) {
+      writer->fCondition.Wait();
+    }
+    if (writer->fQueue.empty()) {
+      break;
+    }
+    FairRootManagerWriterEvent* event = writer->fQueue.front();
+    writer->fQueue.pop_front();
+    writer->fBusy = kTRUE;
+    writer->fMutex.UnLock();
+
+    event->fSnapshot.SetReadMode();
+    event->fSnapshot.SetBufferOffset(0);
+    for (UInt_t i = 0; i < writer->fTargets.size(); i++) {
+      if (event->fArrays[i] != 0) {
+        static_cast<TClonesArray*>(writer->fTargets[i])->AbsorbObjects(event->fArrays[i]);
+      } else {
+        writer->fTargets[i]->Streamer(event->fSnapshot);
+      }
+    }
+    writer->fTree->Fill();
+    // move the objects back, deleting the array of the event deletes them
+    for (UInt_t i = 0; i < writer->fTargets.size(); i++) {
+      if (event->fArrays[i] != 0) {
+        event->fArrays[i]->AbsorbObjects(static_cast<TClonesArray*>(writer->fTargets[i]));
+        delete event->fArrays[i];
+        event->fArrays[i] = 0;
+      }
+    }
+
+    writer->fMutex.Lock();
+    writer->fNFilled++;
+    writer->fFree.push_back(event);
+    writer->fBusy = kFALSE;
+    writer->fCondition.Broadcast();
+  }
+  writer->fMutex.UnLock();
+  return 0;
 }
 //_____________________________________________________________________________
 
@@ -476,6 +891,7 @@ Int_t FairRootManager::Write(const char* name, Int_t option, Int_t bufsize)
 {
   /** Writes the tree in the file.*/
 
+  StopAsyncWriter();
   if(fOutTree!=0) {
     /** Get the file handle to the current output file from the tree.
       * If ROOT splits the file (due to the size of the file) the file
@@ -485,6 +901,11 @@ Int_t FairRootManager::Write(const char* name, Int_t option, Int_t bufsize)
     fOutFile = fOutTree->GetCurrentFile();
     fOutFile->cd();
     fOutTree->Write();
+    for (std::map<TString, FairTimeIndex*>::iterator it = fTimeIndexMap.begin(); it != fTimeIndexMap.end(); it++) {
+      if (it->second) {
+        it->second->Write(FairTimeIndex::GetIndexName(it->first), TObject::kSingleKey | TObject::kOverwrite);
+      }
+    }
   } else {
     LOG(INFO) << "No Output Tree" << FairLogger::endl;
   }
@@ -583,8 +1004,9 @@ Int_t FairRootManager::GetRunId()
 //_____________________________________________________________________________
 void FairRootManager::ReadBranchEvent(const char* BrName)
 {
-    if ( fSource )
-    fSource->ReadBranchEvent(BrName);
+    if ( fSource ) {
+      fSource->ReadBranchEvent(BrName);
+    }
 }
 //_____________________________________________________________________________
 
@@ -947,6 +1369,19 @@ Int_t FairRootManager::CheckBranch(const char* BrName)
 }
 //_____________________________________________________________________________
 
+//_____________________________________________________________________________
+Int_t FairRootManager::CheckBranchId(Int_t id)
+{
+  if (id < 0 || id >= static_cast<Int_t>(fBranchPersistency.size())) {
+    return 0;
+  }
+  if (fBranchPersistency[id] < 0) {
+    fBranchPersistency[id] = CheckBranch(fBranchNameIndex[id]->GetName());
+  }
+  return fBranchPersistency[id];
+}
+//_____________________________________________________________________________
+
 //_____________________________________________________________________________
 void  FairRootManager::SetBranchNameList(TList* list)
 {
@@ -955,6 +1390,7 @@ void  FairRootManager::SetBranchNameList(TList* list)
     fBranchNameList->AddAt(list->At(t),t);
     fBranchSeqId++;
   }
+  RebuildBranchIndex();
 }
 //_____________________________________________________________________________
 
@@ -1051,6 +1487,25 @@ void  FairRootManager::AddMemoryBranch( const char* fName, TObject* pObj )
   if(p!=fMap.end()) {
   } else {
     fMap.insert(pair<TString, TObject*> (BrName, pObj));
+    UpdateBranchPersistency(fName);
+  }
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairRootManager::UpdateBranchPersistency(const char* BrName)
+{
+  /** Registering a branch can change its persistency, so the map created
+   *  by CheckBranch and the value cached per branch id are refreshed*/
+  if (fBranchPerMap) {
+    fBrPerMap[BrName] = CheckBranchSt(BrName);
+  }
+  TObject* name = fBranchIdTable->FindObject(BrName);
+  if (name != 0) {
+    Int_t id = name->GetUniqueID();
+    if (id < static_cast<Int_t>(fBranchPersistency.size())) {
+      fBranchPersistency[id] = -1;
+    }
   }
 }
 //_____________________________________________________________________________
@@ -1251,6 +1706,53 @@ void FairRootManager::DeleteOldWriteoutBufferData()
 }
 //_____________________________________________________________________________
 
+//_____________________________________________________________________________
+void FairRootManager::CreateWorkerOutputFolder()
+{
+  if (fCbmout == 0) {
+    fCbmout = new TFolder("cbmout", "Worker Output Folder");
+  }
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairRootManager::MergeWorkerOutput(FairRootManager* worker)
+{
+  /** The objects are streamed through a buffer into the registered
+   *  objects of this manager, so the output tree sees exactly the same
+   *  data as if the event was processed by this manager.
+   */
+  if (fCbmout == 0 || worker == 0) {
+    return;
+  }
+  if (fMergeBuffer == 0) {
+    fMergeBuffer = new TBufferFile(TBuffer::kWrite);
+  }
+  TIter nextFolder(fCbmout->GetListOfFolders());
+  TObject* obj;
+  while ((obj = nextFolder())) {
+    TFolder* folder = dynamic_cast<TFolder*>(obj);
+    if (folder == 0) {
+      continue;
+    }
+    TIter nextObject(folder->GetListOfFolders());
+    TObject* target;
+    while ((target = nextObject())) {
+      TObject* source = worker->GetMemoryBranch(target->GetName());
+      if (source == 0 || source == target) {
+        continue;
+      }
+      fMergeBuffer->Reset();
+      fMergeBuffer->SetWriteMode();
+      source->Streamer(*fMergeBuffer);
+      fMergeBuffer->SetReadMode();
+      fMergeBuffer->SetBufferOffset(0);
+      target->Streamer(*fMergeBuffer);
+    }
+  }
+}
+//_____________________________________________________________________________
+
 ClassImp(FairRootManager)
 
 
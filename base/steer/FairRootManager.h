@@ -21,22 +21,29 @@
 #include <list>                         // for list
 #include <map>                          // for map, multimap, etc
 #include <queue>                        // for queue
+#include <vector>                       // for vector
 #include "FairSource.h"
 class BinaryFunctor;
 class FairFileHeader;
 class FairGeoNode;
 class FairLink;
 class FairLogger;
+struct FairRootManagerWriter;
 class FairTSBufferFunctional;
+class FairTimeIndex;
+class FairTimeSlice;
 class FairWriteoutBuffer;
 class TArrayI;
 class TBranch;
+class TBufferFile;
 class TClonesArray;
 class TCollection;
 class TF1;
+class THashTable;
 class TFolder;
 class TList;
 class TNamed;
+class TObjString;
 class TTree;
 class TRefArray;
 class TIterator;
@@ -67,6 +74,8 @@ class FairRootManager : public TObject
     2 : Memory Branch
     0 : Branch does not exist   */
     Int_t               CheckBranch(const char* BrName);
+    /** Same as CheckBranch for the branch with the given id, the result is cached per id*/
+    Int_t               CheckBranchId(Int_t id);
 
     
     void                CloseOutFile() { if(fOutFile) { fOutFile->Close(); }}
@@ -74,6 +83,19 @@ class FairRootManager : public TObject
     void                CreateGeometryFile(const char* geofile);
     void                Fill();
     void                LastFill();
+    /**Fill the output tree on a background thread. Fill() moves the objects
+     * of the persistent TClonesArrays to the writer thread without copying
+     * them and only streams the other persistent objects, compression and
+     * writing is done by the writer thread. At most nEvents events are
+     * queued, if the writer falls behind Fill() waits for it.
+     * 0 (default) fills the tree synchronously. Has to be set before the first Fill()
+     * The persistent TClonesArrays are empty after Fill(), tasks must not
+     * read their output after Fill(), e.g. in FinishEvent.
+     * Needs ROOT::EnableThreadSafety() of ROOT 6.06, with older versions the
+     * tree is filled synchronously.*/
+    void                SetAsyncWrite(Int_t nEvents = 4) { fAsyncQueueDepth = nEvents; }
+    /**Wait until all queued events are filled into the output tree*/
+    void                FlushAsyncWrite();
     TClonesArray*       GetEmptyTClonesArray(TString branchName);
     TClonesArray*       GetTClonesArray(TString branchName);
     /**Update the list of Memory branches from the source used*/
@@ -83,6 +105,8 @@ class FairRootManager : public TObject
     TString             GetBranchName(Int_t id);
     /**Return Id of a branch named */
     Int_t               GetBranchId(TString BrName);
+    /**Return Id of the MCTrack branch, -1 if there is none*/
+    Int_t               GetMCTrackBranchId() const {return fMCTrackBranchId;}
     /**Return a TList of TObjString of branch names available in this session*/
     TList*              GetBranchNameList() {return fBranchNameList;}
     /** Return a pointer to the output Tree of type TTree */
@@ -116,6 +140,27 @@ class FairRootManager : public TObject
     void TerminateAllTSBuffer();
     FairTSBufferFunctional*   GetTSBuffer(TString branchName) {return fTSBufferMap[branchName];}
 
+    /**Cut the time based input branches into slices of the given length (ns), the
+     * data of each slice is handed to the tasks together with the data of the
+     * following overlap (ns). See FairRunAna::RunTimeSlices*/
+    void                SetTimeSlices(Double_t length, Double_t overlap = 0.) { fTimeSliceLength = length; fTimeSliceOverlap = overlap; }
+    Double_t            GetTimeSliceLength() const { return fTimeSliceLength; }
+    Double_t            GetTimeSliceOverlap() const { return fTimeSliceOverlap; }
+    /**Start time of slice 0, set by GetNTimeSlices*/
+    void                SetTimeSliceOrigin(Double_t time) { fTimeSliceOrigin = time; }
+    Double_t            GetTimeSliceOrigin() const { return fTimeSliceOrigin; }
+    /**Number of time slices needed for the data of all time based input branches*/
+    Int_t               GetNTimeSlices();
+    /**Make slice i the current time slice, the data is read when it is requested*/
+    Int_t               ReadTimeSlice(Int_t i);
+    /**Current time slice, NULL if no slice was read*/
+    FairTimeSlice*      GetTimeSlice() { return fTimeSlice; }
+    /**Leave the time slice mode after the last slice*/
+    void                ResetTimeSlice();
+    /**Data of a time based input branch in the current time slice including the overlap
+     * region. The array does not own the data and is valid until the next slice is read*/
+    TObjArray*          GetTimeSliceData(TString branchName);
+
     /** static access method */
     static FairRootManager* Instance();
 
@@ -221,6 +266,16 @@ class FairRootManager : public TObject
 
     void SetFinishRun(Bool_t val = kTRUE){ fFinishRun = val;}
     Bool_t FinishRun() {return fFinishRun;}
+
+    /** Number of registered FairWriteoutBuffers*/
+    Int_t GetNWriteoutBuffers() const { return fWriteoutBufferMap.size(); }
+    /**Prepare this manager for a worker thread of FairRunAna: persistent
+     * objects are registered in a private output folder which is not
+     * attached to gROOT, no output file is opened*/
+    void CreateWorkerOutputFolder();
+    /**Copy the content of the persistent output objects of a worker manager
+     * into the objects registered under the same name in this manager*/
+    void MergeWorkerOutput(FairRootManager* worker);
   private:
     /**private methods*/
     FairRootManager(const FairRootManager&);
@@ -229,6 +284,10 @@ class FairRootManager : public TObject
         a TObject pointer, the user have to cast this pointer to the right type.*/
     TObject*            ActivateBranch(const char* BrName);
     void                AddFriends( );
+    /**Add the time range of the current entry of each time based output branch to its FairTimeIndex*/
+    void                FillTimeIndex();
+    /**TSBuffer of a time based input branch for the time slices, NULL if the branch is not in the input*/
+    FairTSBufferFunctional* GetTimeSliceBuffer(TString branchName);
     /**Add a branch to memory, it will not be written to the output files*/
     void                AddMemoryBranch(const char*, TObject* );
     /** Internal Check if Branch persistence or not (Memory branch)
@@ -245,6 +304,22 @@ class FairRootManager : public TObject
 
     FairWriteoutBuffer* GetWriteoutBuffer(TString branchName);
 
+    /**Add a branch name of fBranchNameList with the given id to the lookup tables*/
+    void                AddBranchToIndex(TObjString* name, Int_t id);
+    /**Recreate the lookup tables from fBranchNameList*/
+    void                RebuildBranchIndex();
+    /**Refresh the cached persistency of a branch after it was registered*/
+    void                UpdateBranchPersistency(const char* BrName);
+
+    /**Bind the output tree to writer owned copies of the persistent objects
+     * and start the writer thread, return kFALSE if this is not possible*/
+    Bool_t              StartAsyncWriter();
+    /**Write all queued events, stop the writer thread and bind the
+     * output tree to the registered objects again*/
+    void                StopAsyncWriter();
+    /**Main function of the writer thread*/
+    static void*        RunAsyncWriter(void* arg);
+
 
     Int_t       fOldEntryNr;
 //_____________________________________________________________________
@@ -286,6 +361,8 @@ class FairRootManager : public TObject
     /** Internally used to read time ordered data from branches*/
     std::map<TString, FairTSBufferFunctional*> fTSBufferMap; //!
     std::map<TString, FairWriteoutBuffer* > fWriteoutBufferMap; //!
+    /** Time index of the time based output branches, written next to the output tree*/
+    std::map<TString, FairTimeIndex*> fTimeIndexMap; //!
     std::map<Int_t, TBranch*> fInputBranchMap; //!    //Map of input branch ID with TBranch pointer
     /**if kTRUE Read data according to time and not entries*/
     Bool_t                              fTimeStamps;
@@ -320,6 +397,27 @@ class FairRootManager : public TObject
     TRefArray* fListOfNonTimebasedBranches; //!
     /** Iterator for the list of branches used with no-time stamp in time-based session */
     TIterator* fListOfNonTimebasedBranchesIter; //!
+    /** Buffer used to copy the output objects of worker managers */
+    TBufferFile* fMergeBuffer; //!
+    /** Maximal number of events queued for the writer thread, 0 means synchronous filling */
+    Int_t fAsyncQueueDepth; //!
+    /** State of the writer thread */
+    FairRootManagerWriter* fAsyncWriter; //!
+    /** Branch names of fBranchNameList hashed by name, the unique id of each entry is the branch id */
+    THashTable* fBranchIdTable; //!
+    /** Branch names of fBranchNameList indexed by branch id */
+    std::vector<TObjString*> fBranchNameIndex; //!
+    /** Cached result of CheckBranch per branch id, -1 if not yet checked */
+    std::vector<Int_t> fBranchPersistency; //!
+    /** Id of the MCTrack branch */
+    Int_t fMCTrackBranchId; //!
+    /** Length and overlap of the time slices in ns, no time slices if the length is 0 */
+    Double_t fTimeSliceLength; //!
+    Double_t fTimeSliceOverlap; //!
+    /** Start time of the first time slice */
+    Double_t fTimeSliceOrigin; //!
+    /** Current time slice */
+    FairTimeSlice* fTimeSlice; //!
 
     ClassDef(FairRootManager,11) // Root IO manager
 };
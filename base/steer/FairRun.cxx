@@ -68,8 +68,8 @@ FairRun::~FairRun()
     delete fTask;  // There is another tasklist in MCApplication,
   }
   // but this should be independent
-  if (fRtdb) {
-    delete fRtdb;  // who is responsible for the RuntimeDataBase
+  if (fRtdb && fIsMaster) {
+    delete fRtdb;  // who is responsible for the RuntimeDataBase, workers share it
   }
   if (fRootManager) {
     delete fRootManager; // who is responsible
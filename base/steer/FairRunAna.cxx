@@ -18,6 +18,7 @@
 #include "FairField.h"                  // for FairField
 #include "FairFieldFactory.h"           // for FairFieldFactory
 #include "FairFileHeader.h"             // for FairFileHeader
+#include "FairLinkManager.h"            // for FairLinkManager
 #include "FairLogger.h"                 // for FairLogger, MESSAGE_ORIGIN
 #include "FairParIo.h"                  // for FairParIo
 #include "FairParSet.h"                 // for FairParSet
@@ -46,12 +47,16 @@
 #include "TSeqCollection.h"             // for TSeqCollection
 #include "TSystem.h"                    // for TSystem, gSystem
 #include "TTree.h"                      // for TTree
+#include "TThread.h"                    // for TThread
+#include "TMutex.h"                     // for TMutex
+#include "TCondition.h"                 // for TCondition
 
 #include <stdlib.h>                     // for NULL, exit
 #include "signal.h"
 #include <string.h>                     // for strcmp
 #include <iostream>                     // for operator<<, basic_ostream, etc
 #include <list>                         // for list
+#include <vector>                       // for vector
 
 using std::cout;
 using std::endl;
@@ -76,8 +81,8 @@ FairRunAna* FairRunAna::Instance()
   return fgRinstance;
 }
 //_____________________________________________________________________________
-FairRunAna::FairRunAna()
-  :FairRun(),
+FairRunAna::FairRunAna(Bool_t isMaster)
+  :FairRun(isMaster),
    fRunInfo(),
    fIsInitialized(kFALSE),
    fInputGeoFile(0),
@@ -95,9 +100,12 @@ FairRunAna::FairRunAna()
    fFinishProcessingLMDFile(kFALSE)
   ,fFileSource(0)
   ,fMixedSource(0)
+  ,fNThreads(1)
 {
 
-  fgRinstance=this;
+  if ( isMaster ) {
+    fgRinstance=this;
+  }
   fAna=kTRUE;
 }
 //_____________________________________________________________________________
@@ -106,6 +114,10 @@ FairRunAna::FairRunAna()
 FairRunAna::~FairRunAna()
 {
   //  delete fFriendFileList;
+  // field and geometry are shared with the worker runs
+  if ( !fIsMaster ) {
+    return;
+  }
   if (fField) {
     delete fField;
   }
@@ -297,7 +309,9 @@ void FairRunAna::Run(Int_t Ev_start, Int_t Ev_end)
 {
   gFRAIsInterrupted = kFALSE;
 
-  if (fTimeStamps) {
+  if (fRootManager->GetTimeSliceLength() > 0.) {
+    RunTimeSlices(Ev_start, Ev_end);
+  } else if (fTimeStamps) {
     RunTSBuffers();
   } else {
     UInt_t tmpId =0;
@@ -335,6 +349,12 @@ void FairRunAna::Run(Int_t Ev_start, Int_t Ev_end)
     else {
       LOG(INFO) << "FairRunAna::Run() continue running without stop" << FairLogger::endl;
     }
+
+    if ( fNThreads > 1 && MaxAllowed != -1 ) {
+      if ( RunMultiThreaded(Ev_start, Ev_end) ) {
+        return;
+      }
+    }
     
     if (fGenerateRunInfo) {
       fRunInfo.Reset();
@@ -397,6 +417,281 @@ void FairRunAna::Run(Int_t Ev_start, Int_t Ev_end)
 }
 //_____________________________________________________________________________
 
+//_____________________________________________________________________________
+/** State shared between FairRunAna::RunMultiThreaded and the worker threads*/
+struct FairRunAnaShared
+{
+  FairRunAnaShared() : fMutex(), fCondition(&fMutex), fNReady(0), fStart(kFALSE), fStop(kFALSE), fFinished(kFALSE) {}
+  TMutex     fMutex;
+  TCondition fCondition;
+  Int_t      fNReady;    // number of initialized workers
+  Bool_t     fStart;     // all workers are initialized, start processing
+  Bool_t     fStop;      // stop processing after the current event
+  Bool_t     fFinished;  // the worker tasks are merged, workers can clean up
+};
+
+/** One worker thread of FairRunAna::RunMultiThreaded*/
+struct FairRunAnaWorker
+{
+  FairRunAnaShared* fShared;
+  FairRunAna*       fMaster;
+  FairRunAna*       fRun;     // worker run, created on the worker thread
+  FairSource*       fSource;
+  FairTask*         fTask;
+  TThread*          fThread;
+  Int_t             fFirst;   // first entry processed by this worker
+  Int_t             fLast;    // processing stops before this entry
+  Int_t             fStep;    // entries are distributed round robin
+  Int_t             fEntry;   // entry waiting to be merged, -1 if none
+  Int_t             fStatus;  // return value of ReadEvent for fEntry
+  Bool_t            fTimeSlices; // the entries are time slices
+  Bool_t            fDone;
+};
+
+//_____________________________________________________________________________
+Bool_t FairRunAna::RunMultiThreaded(Int_t Ev_start, Int_t Ev_end, Bool_t timeSlices)
+{
+  /**
+   * The events are distributed round robin over the workers. Each worker
+   * reads and processes its next event and waits until the main thread
+   * has merged the output of this event into the output tree, so the
+   * output tree is filled in the same order as in the serial mode.
+   */
+  if ( fRootManager->GetNWriteoutBuffers() > 0 ) {
+    LOG(WARNING) << "FairRunAna::Run() FairWriteoutBuffers need the events in order, running on one thread" << FairLogger::endl;
+    return kFALSE;
+  }
+  if ( NULL != FairTrajFilter::Instance() ) {
+    LOG(WARNING) << "FairRunAna::Run() FairTrajFilter is not thread safe, running on one thread" << FairLogger::endl;
+    return kFALSE;
+  }
+  if ( !fRootManager->GetSource() ) {
+    return kFALSE;
+  }
+  Int_t nEvents = Ev_end - Ev_start;
+  Int_t nWorkers = fNThreads < nEvents ? fNThreads : nEvents;
+  if ( nWorkers < 2 ) {
+    return kFALSE;
+  }
+
+  TThread::Initialize();
+
+  FairRunAnaShared shared;
+  std::vector<FairRunAnaWorker*> workers;
+  for (Int_t k = 0; k < nWorkers; k++) {
+    FairSource* source = fRootManager->GetSource()->CloneForWorker();
+    if ( !source ) {
+      LOG(WARNING) << "FairRunAna::Run() The source can not be cloned for worker threads, running on one thread" << FairLogger::endl;
+      for (UInt_t j = 0; j < workers.size(); j++) {
+        delete workers[j]->fSource;
+        delete workers[j]->fTask;
+        delete workers[j];
+      }
+      return kFALSE;
+    }
+    FairRunAnaWorker* worker = new FairRunAnaWorker();
+    worker->fShared = &shared;
+    worker->fMaster = this;
+    worker->fRun    = 0;
+    worker->fSource = source;
+    worker->fTask   = dynamic_cast<FairTask*>(fTask->Clone());
+    worker->fThread = 0;
+    worker->fFirst  = Ev_start + k;
+    worker->fLast   = Ev_end;
+    worker->fStep   = nWorkers;
+    worker->fEntry  = -1;
+    worker->fStatus = 0;
+    worker->fTimeSlices = timeSlices;
+    worker->fDone   = kFALSE;
+    workers.push_back(worker);
+  }
+
+  if ( !fStatic ) {
+    LOG(WARNING) << "FairRunAna::Run() Parameter containers are shared by the worker threads and are not reinitialized on run id changes" << FairLogger::endl;
+  }
+  LOG(INFO) << "FairRunAna::Run() Processing " << (timeSlices ? "time slices " : "events ") << Ev_start << " to " << Ev_end
+            << " on " << nWorkers << " threads" << FairLogger::endl;
+
+  for (Int_t k = 0; k < nWorkers; k++) {
+    workers[k]->fThread = new TThread(Form("FairRunAnaWorker_%d", k), &FairRunAna::RunWorker, workers[k]);
+    workers[k]->fThread->Run();
+  }
+
+  shared.fMutex.Lock();
+  while ( shared.fNReady < nWorkers ) {
+    shared.fCondition.Wait();
+  }
+  shared.fStart = kTRUE;
+  shared.fCondition.Broadcast();
+  shared.fMutex.UnLock();
+
+  if (fGenerateRunInfo) {
+    fRunInfo.Reset();
+  }
+
+  UInt_t tmpId = 0;
+  for (Int_t i = Ev_start; i < Ev_end; i++) {
+
+    gSystem->IgnoreInterrupt();
+    signal(SIGINT, FRA_handler_ctrlc);
+
+    if ( gFRAIsInterrupted ) {
+      LOG(WARNING) << "FairRunAna::Run() Event loop was interrupted by the user!" << FairLogger::endl;
+      break;
+    }
+
+    FairRunAnaWorker* worker = workers[(i - Ev_start) % nWorkers];
+    shared.fMutex.Lock();
+    while ( worker->fEntry != i && !worker->fDone ) {
+      shared.fCondition.Wait();
+    }
+    Bool_t isReady = ( worker->fEntry == i );
+    Int_t readEventReturn = worker->fStatus;
+    shared.fMutex.UnLock();
+
+    if ( !isReady ) {
+      break;
+    }
+    if ( readEventReturn != 0 ) {
+      LOG(WARNING) << "FairRunAna::Run() ReadEvent(" << i << ") returned " << readEventReturn << " on a worker thread. Breaking the event loop" << FairLogger::endl;
+      break;
+    }
+
+    fRootManager->MergeWorkerOutput(worker->fRun->fRootManager);
+
+    tmpId = fEvtHeader->GetRunId();
+    if ( tmpId != fRunId ) {
+      fRunId = tmpId;
+    }
+
+    Fill();
+
+    if (fGenerateRunInfo) {
+      fRunInfo.StoreInfo();
+    }
+
+    shared.fMutex.Lock();
+    worker->fEntry = -1;
+    shared.fCondition.Broadcast();
+    shared.fMutex.UnLock();
+  }
+
+  shared.fMutex.Lock();
+  shared.fStop = kTRUE;
+  shared.fCondition.Broadcast();
+  for (Int_t k = 0; k < nWorkers; k++) {
+    while ( !workers[k]->fDone ) {
+      shared.fCondition.Wait();
+    }
+  }
+  shared.fMutex.UnLock();
+
+  // The results which the task clones accumulated on the workers are added
+  // to the task tree of this run, which is then finished once as in the
+  // serial mode.
+  for (Int_t k = 0; k < nWorkers; k++) {
+    fTask->MergeWorkerTask(workers[k]->fTask);
+  }
+  fTask->FinishTask();
+
+  shared.fMutex.Lock();
+  shared.fFinished = kTRUE;
+  shared.fCondition.Broadcast();
+  shared.fMutex.UnLock();
+
+  for (Int_t k = 0; k < nWorkers; k++) {
+    workers[k]->fThread->Join();
+    delete workers[k]->fThread;
+    delete workers[k];
+  }
+
+  if (fGenerateRunInfo) {
+    fRunInfo.WriteInfo();
+  }
+  fRootManager->LastFill();
+  fRootManager->Write();
+
+  return kTRUE;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void* FairRunAna::RunWorker(void* arg)
+{
+  FairRunAnaWorker* worker = static_cast<FairRunAnaWorker*>(arg);
+  FairRunAnaShared* shared = worker->fShared;
+  FairRunAna* master = worker->fMaster;
+
+  // The workers are initialized one after the other, the ROOT folders
+  // and the FairMonitor are not protected against concurrent access.
+  // FairRun, FairRootManager and FairLinkManager instances are thread local.
+  shared->fMutex.Lock();
+  FairRunAna* run = new FairRunAna(kFALSE);
+  run->fRootManager = new FairRootManager();
+  run->fRootManager->CreateWorkerOutputFolder();
+  run->fRootManager->SetUseFairLinks(master->fRootManager->GetUseFairLinks());
+  run->fRootManager->SetSource(worker->fSource);
+  run->fInFileIsOpen = run->fRootManager->InitSource();
+  if ( worker->fTimeSlices ) {
+    run->fRootManager->SetTimeSlices(master->fRootManager->GetTimeSliceLength(), master->fRootManager->GetTimeSliceOverlap());
+    run->fRootManager->SetTimeSliceOrigin(master->fRootManager->GetTimeSliceOrigin());
+  }
+  run->fField = master->fField;
+  run->fRunId = master->fRunId;
+  run->fStatic = kTRUE;
+  run->fEvtHeader = dynamic_cast<FairEventHeader*>(master->fEvtHeader->Clone());
+  run->fEvHead = run->fEvtHeader;
+  run->fEvtHeader->Register();
+  run->SetTask(worker->fTask);
+  worker->fTask->InitTask();
+  worker->fRun = run;
+
+  shared->fNReady++;
+  shared->fCondition.Broadcast();
+  while ( !shared->fStart && !shared->fStop ) {
+    shared->fCondition.Wait();
+  }
+  Bool_t isRunning = !shared->fStop;
+  shared->fMutex.UnLock();
+
+  for (Int_t i = worker->fFirst; isRunning && i < worker->fLast; i += worker->fStep) {
+    Int_t readEventReturn = worker->fTimeSlices ? run->fRootManager->ReadTimeSlice(i) : run->fRootManager->ReadEvent(i);
+    if ( readEventReturn == 0 ) {
+      run->fRootManager->FillEventHeader(run->fEvtHeader);
+      worker->fTask->ExecuteWorkerTask("");
+    }
+
+    // hand the event to the main thread and wait until it is merged
+    shared->fMutex.Lock();
+    worker->fStatus = readEventReturn;
+    worker->fEntry = i;
+    shared->fCondition.Broadcast();
+    while ( worker->fEntry != -1 && !shared->fStop ) {
+      shared->fCondition.Wait();
+    }
+    isRunning = ( readEventReturn == 0 && !shared->fStop );
+    shared->fMutex.UnLock();
+
+    if ( readEventReturn == 0 ) {
+      worker->fTask->FinishEvent();
+    }
+  }
+
+  shared->fMutex.Lock();
+  worker->fDone = kTRUE;
+  shared->fCondition.Broadcast();
+  while ( !shared->fFinished ) {
+    shared->fCondition.Wait();
+  }
+  // deleting the worker run resets the thread local instances of this thread
+  delete run;
+  delete FairLinkManager::Instance();
+  shared->fMutex.UnLock();
+
+  return 0;
+}
+//_____________________________________________________________________________
+
 //_____________________________________________________________________________
 void FairRunAna::RunEventReco(Int_t Ev_start, Int_t Ev_end)
 {
@@ -571,6 +866,76 @@ void FairRunAna::RunTSBuffers()
   fRootManager->Write();
 }
 //_____________________________________________________________________________
+//_____________________________________________________________________________
+void FairRunAna::RunTimeSlices(Int_t Ev_start, Int_t Ev_end)
+{
+  /**
+   * The slices are cut from the time indices of the time based input
+   * branches, the tasks request the data of the branches they need with
+   * FairRootManager::GetTimeSliceData. Each entry of a branch is read once,
+   * as long as it overlaps with the following slices it is kept in its
+   * TSBuffer. Data of FairWriteoutBuffers older than the start of the
+   * slice is written out before the tasks are executed.
+   */
+  if (!fInFileIsOpen) {
+    LOG(ERROR) << "FairRunAna::RunTimeSlices() No input file is open, the time slices are cut from the time based input branches" << FairLogger::endl;
+    return;
+  }
+  Int_t nSlices = fRootManager->GetNTimeSlices();
+  if (Ev_end == 0 || Ev_end > nSlices) {
+    Ev_end = nSlices;
+  }
+  LOG(INFO) << "FairRunAna::RunTimeSlices() Processing time slices " << Ev_start << " to " << Ev_end << " of "
+            << fRootManager->GetTimeSliceLength() << " ns with an overlap of " << fRootManager->GetTimeSliceOverlap()
+            << " ns" << FairLogger::endl;
+
+  if ( fNThreads > 1 ) {
+    if ( RunMultiThreaded(Ev_start, Ev_end, kTRUE) ) {
+      return;
+    }
+  }
+
+  if (fGenerateRunInfo) {
+    fRunInfo.Reset();
+  }
+
+  for (Int_t i = Ev_start; i < Ev_end; i++) {
+
+    gSystem->IgnoreInterrupt();
+    signal(SIGINT, FRA_handler_ctrlc);
+
+    if ( gFRAIsInterrupted ) {
+      LOG(WARNING) << "FairRunAna::RunTimeSlices() Loop over the time slices was interrupted by the user!" << FairLogger::endl;
+      break;
+    }
+
+    fRootManager->ReadTimeSlice(i);
+    fRootManager->StoreWriteoutBufferData(fRootManager->GetEventTime());
+    fTask->ExecuteTask("");
+    fRootManager->FillEventHeader(fEvtHeader);
+    Fill();
+    fRootManager->DeleteOldWriteoutBufferData();
+    fTask->FinishEvent();
+
+    if (fGenerateRunInfo) {
+      fRunInfo.StoreInfo();
+    }
+    if (NULL !=  FairTrajFilter::Instance()) {
+      FairTrajFilter::Instance()->Reset();
+    }
+  }
+  fRootManager->ResetTimeSlice();
+
+  fRootManager->StoreAllWriteoutBufferData();
+  fTask->FinishTask();
+  if (fGenerateRunInfo) {
+    fRunInfo.WriteInfo();
+  }
+  fRootManager->LastFill();
+  fRootManager->Write();
+}
+//_____________________________________________________________________________
+
 //_____________________________________________________________________________
 
 void FairRunAna::RunOnLmdFiles(UInt_t NStart, UInt_t NStop)
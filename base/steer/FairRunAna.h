@@ -40,7 +40,7 @@ class FairRunAna : public FairRun
 
     static FairRunAna* Instance();
     virtual ~FairRunAna();
-    FairRunAna();
+    FairRunAna(Bool_t isMaster = kTRUE);
     /**initialize the run manager*/
     void        Init();
     /**Run from event number NStart to event number NStop */
@@ -53,6 +53,9 @@ class FairRunAna : public FairRun
     void        RunEventReco(Int_t NStart ,Int_t NStop);
     /**Run over all TSBuffers until the data is processed*/
     void        RunTSBuffers();
+    /**Run over the time slices NStart to NStop of the time based input branches,
+     * NStop=0 runs up to the last slice. Run(Int_t, Int_t) calls it if SetTimeSlices was used*/
+    void        RunTimeSlices(Int_t NStart=0, Int_t NStop=0);
     /** the dummy run does not check the evt header or the parameters!! */
     void        DummyRun(Int_t NStart ,Int_t NStop);
     /** This methode is only needed and used with ZeroMQ
@@ -149,6 +152,14 @@ class FairRunAna : public FairRun
     Bool_t      IsTimeStamp() {
       return fTimeStamps;
     }
+    /** Process the time based input branches in slices of length ns instead of
+     *  events. The tasks get the slices via FairTask::ExecTimeSlice, the data of a
+     *  slice includes the data of the following overlap ns. Independent slices
+     *  are processed in parallel with SetNumberOfThreads.
+     */
+    void        SetTimeSlices(Double_t length, Double_t overlap = 0.) {
+      fRootManager->SetTimeSlices(length, overlap);
+    }
 
     /** Set the flag for proccessing lmd files */
     void StopProcessingLMD( void ) {
@@ -159,6 +170,21 @@ class FairRunAna : public FairRun
       return fFinishProcessingLMDFile;
     }
 
+    /** Process the events of Run(Int_t, Int_t) in parallel on nThreads
+     *  worker threads. Each worker owns a clone of the task tree and its own
+     *  FairRootManager and source; the output of the workers is merged in
+     *  event order into the output tree of this run. After the event loop
+     *  the clones are merged into the tasks of this run with
+     *  FairTask::MergeWorker and only the tasks of this run are finished.
+     *  nThreads <= 1 means serial processing (default).
+     */
+    void SetNumberOfThreads(Int_t nThreads) {
+      fNThreads = nThreads;
+    }
+    Int_t GetNumberOfThreads() const {
+      return fNThreads;
+    }
+
   protected:
     /**
      * Virtual function which calls the Fill function of the IOManager.
@@ -175,6 +201,13 @@ class FairRunAna : public FairRun
 
     FairRunInfo fRunInfo;//!
 
+    /** Event parallel version of Run(Int_t, Int_t), returns kFALSE if the
+     *  setup does not allow it and nothing was processed. With timeSlices
+     *  the entries are the time slices of RunTimeSlices*/
+    Bool_t RunMultiThreaded(Int_t Ev_start, Int_t Ev_end, Bool_t timeSlices = kFALSE);
+    /** Entry point of the worker threads started by RunMultiThreaded */
+    static void* RunWorker(void* arg);
+
   protected:
     /** This variable became true after Init is called*/
     Bool_t                                  fIsInitialized;
@@ -204,6 +237,8 @@ class FairRunAna : public FairRun
     FairFileSource*                         fFileSource;  //! 
     /** Temporary member to preserve old functionality without setting source in macro */
     FairMixedSource*                        fMixedSource; //! 
+    /** Number of worker threads used in Run(Int_t, Int_t)*/
+    Int_t                                   fNThreads; //!
 
     ClassDef(FairRunAna ,5)
 
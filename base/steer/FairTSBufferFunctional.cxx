@@ -9,14 +9,18 @@
 
 #include "FairLink.h"                   // for FairLink
 #include "FairRootManager.h"            // for FairRootManager
+#include "FairTimeIndex.h"              // for FairTimeIndex
 #include "FairTimeStamp.h"              // for FairTimeStamp
 
 #include "TBranch.h"                    // for TBranch
 #include "TClass.h"                     // for TClass
 #include "TClonesArray.h"               // for TClonesArray
+#include "TFile.h"                      // for TFile
+#include "TObjArray.h"                  // for TObjArray
 #include "TTree.h"                      // for TTree
 
 #include <stddef.h>                     // for NULL
+#include <limits>                       // for numeric_limits
 
 ClassImp(FairTSBufferFunctional);
 
@@ -30,6 +34,13 @@ FairTSBufferFunctional::FairTSBufferFunctional(TString branchName, TTree* source
    fStopFunction (stopFunction),
    fBranch(NULL),
    fBranchIndex(-1),
+   fTimeIndex(NULL),
+   fSliceChunks(),
+   fFreeSliceChunks(),
+   fSliceEntry(0),
+   fSliceStartTime(-std::numeric_limits<Double_t>::max()),
+   fSliceStopTime(-std::numeric_limits<Double_t>::max()),
+   fSliceData(NULL),
    fTerminate(kFALSE),
    fVerbose(0)
 {
@@ -42,6 +53,28 @@ FairTSBufferFunctional::FairTSBufferFunctional(TString branchName, TTree* source
   fBufferArray = new TClonesArray(fInputArray->GetClass()->GetName());
   fOutputArray = new TClonesArray(fInputArray->GetClass()->GetName());
 
+  TFile* file = sourceTree->GetCurrentFile();
+  if (file != 0 && fBranch != 0) {
+    fTimeIndex = dynamic_cast<FairTimeIndex*>(file->Get(FairTimeIndex::GetIndexName(branchName)));
+    if (fTimeIndex != 0 && fTimeIndex->GetNEntries() != fBranch->GetEntries()) {
+      std::cout << "-W- FairTSBufferFunctional::FairTSBufferFunctional Time index of " << branchName
+                << " does not fit to the branch, it will be rebuilt" << std::endl;
+      delete fTimeIndex;
+      fTimeIndex = NULL;
+    }
+  }
+}
+
+FairTSBufferFunctional::~FairTSBufferFunctional()
+{
+  delete fTimeIndex;
+  while (!fSliceChunks.empty()) {
+    ReleaseSliceChunk();
+  }
+  for (size_t i = 0; i < fFreeSliceChunks.size(); i++) {
+    delete fFreeSliceChunks[i];
+  }
+  delete fSliceData;
 }
 
 TClonesArray* FairTSBufferFunctional::GetData(Double_t stopParameter)
@@ -144,6 +177,10 @@ TClonesArray* FairTSBufferFunctional::GetData(Double_t startParameter, Double_t
 
 Int_t FairTSBufferFunctional::FindStartIndex(Double_t startParameter)
 {
+  if (fStartFunction->IsTimeThreshold()) {
+    return FindStartIndexFromTimeIndex(startParameter);
+  }
+
   FairTimeStamp* dataPoint;
   Int_t tempIndex = fBranchIndex;
   Bool_t runBackwards = kTRUE;
@@ -205,6 +242,133 @@ Int_t FairTSBufferFunctional::FindStartIndex(Double_t startParameter)
 }
 
 
+TObjArray* FairTSBufferFunctional::GetTimeSliceData(Double_t startTime, Double_t stopTime)
+{
+  if (fSliceData == 0) {
+    fSliceData = new TObjArray();
+  } else if (startTime == fSliceStartTime && stopTime == fSliceStopTime) {
+    return fSliceData;
+  }
+  fSliceData->Clear();
+  FairTimeIndex* timeIndex = GetTimeIndex();
+
+  if (startTime < fSliceStartTime) {
+    /** Going back in time, older entries than the kept ones can be needed */
+    while (!fSliceChunks.empty()) {
+      ReleaseSliceChunk();
+    }
+    fSliceEntry = 0;
+  }
+  fSliceStartTime = startTime;
+  fSliceStopTime = stopTime;
+
+  /** Entries with only older data are not needed by this or any later slice */
+  while (!fSliceChunks.empty() && timeIndex->GetMaxTime(fSliceChunks.front().first) < startTime) {
+    ReleaseSliceChunk();
+  }
+
+  Int_t firstEntry = timeIndex->FindFirstEntryFrom(startTime);
+  if (fSliceEntry < firstEntry) {
+    fSliceEntry = firstEntry;
+  }
+  while (fSliceEntry < timeIndex->GetNEntries() && timeIndex->GetMinTimeFrom(fSliceEntry) < stopTime) {
+    if (!timeIndex->IsEmpty(fSliceEntry)) {
+      ReadInEntry(fSliceEntry);
+      if (fInputArray->GetEntriesFast() > 0) {
+        TClonesArray* chunk;
+        if (fFreeSliceChunks.empty()) {
+          chunk = new TClonesArray(fInputArray->GetClass()->GetName());
+        } else {
+          chunk = fFreeSliceChunks.back();
+          fFreeSliceChunks.pop_back();
+        }
+        chunk->AbsorbObjects(fInputArray, 0, fInputArray->GetEntriesFast() - 1);
+        fSliceChunks.push_back(std::make_pair(fSliceEntry, chunk));
+      }
+    }
+    fSliceEntry++;
+  }
+
+  for (std::deque<std::pair<Int_t, TClonesArray*> >::const_iterator it = fSliceChunks.begin(); it != fSliceChunks.end(); it++) {
+    Double_t minTime = timeIndex->GetMinTime(it->first);
+    Double_t maxTime = timeIndex->GetMaxTime(it->first);
+    if (maxTime < startTime || minTime >= stopTime) {
+      continue;
+    }
+    TClonesArray* chunk = it->second;
+    Int_t nData = chunk->GetEntriesFast();
+    if (minTime >= startTime && maxTime < stopTime) {
+      /** The entry is completely inside of the range, no need to look at the time stamps */
+      for (Int_t i = 0; i < nData; i++) {
+        fSliceData->AddLast(chunk->At(i));
+      }
+      continue;
+    }
+    for (Int_t i = 0; i < nData; i++) {
+      Double_t time = static_cast<FairTimeStamp*>(chunk->At(i))->GetTimeStamp();
+      if (time >= startTime && time < stopTime) {
+        fSliceData->AddLast(chunk->At(i));
+      }
+    }
+  }
+  if (fVerbose > 1) {
+    std::cout << "-I- FairTSBufferFunctional::GetTimeSliceData " << fSliceData->GetEntriesFast() << " data in [" << startTime << ", " << stopTime
+              << ") from " << fSliceChunks.size() << " entries" << std::endl;
+  }
+  return fSliceData;
+}
+
+void FairTSBufferFunctional::ReleaseSliceChunk()
+{
+  TClonesArray* chunk = fSliceChunks.front().second;
+  fSliceChunks.pop_front();
+  chunk->Delete();
+  fFreeSliceChunks.push_back(chunk);
+}
+
+FairTimeIndex* FairTSBufferFunctional::GetTimeIndex()
+{
+  if (fTimeIndex == 0) {
+    InitTimeIndex();
+  }
+  return fTimeIndex;
+}
+
+void FairTSBufferFunctional::InitTimeIndex()
+{
+  /** Files written without index: read the branch once */
+  fTimeIndex = new FairTimeIndex();
+  for (Int_t i = 0; i < fBranch->GetEntries(); i++) {
+    ReadInEntry(i);
+    fTimeIndex->AddEntry(fInputArray);
+  }
+  fInputArray->Delete();
+  if (fVerbose > 0) {
+    std::cout << "-I- FairTSBufferFunctional::InitTimeIndex built time index of " << fBranch->GetName() << " with " << fTimeIndex->GetNEntries() << " entries" << std::endl;
+  }
+}
+
+Int_t FairTSBufferFunctional::FindStartIndexFromTimeIndex(Double_t startParameter)
+{
+  if (fTimeIndex == 0) {
+    InitTimeIndex();
+  }
+  Int_t entry = fTimeIndex->FindFirstEntryAfter(startParameter);
+  if (entry >= fTimeIndex->GetNEntries()) {
+    fBranchIndex = fTimeIndex->GetNEntries() - 1;
+    return -1;
+  }
+
+  fBranchIndex = entry;
+  ReadInEntry(entry);
+  for (Int_t i = 0; i < fInputArray->GetEntriesFast(); i++) {
+    if ((*fStartFunction)((FairTimeStamp*)fInputArray->At(i), startParameter)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 void FairTSBufferFunctional::ReadInNextFilledEntry()
 {
   fInputArray->Delete();
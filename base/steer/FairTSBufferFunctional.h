@@ -15,11 +15,16 @@
 #include "TObject.h"                    // for TObject
 #include "TString.h"                    // for TString
 
+#include <deque>                        // for deque
 #include <functional>                   // for binary_function
 #include <iostream>                     // for operator<<, basic_ostream, etc
+#include <utility>                      // for pair
+#include <vector>                       // for vector
 
+class FairTimeIndex;
 class TBranch;
 class TClonesArray;
+class TObjArray;
 class TTree;
 
 
@@ -42,6 +47,8 @@ class BinaryFunctor : public std::binary_function<FairTimeStamp* ,double, bool>
     virtual bool Call(FairTimeStamp* a, double b) = 0;
     virtual bool TimeOut() {return false;}
     virtual void ResetTimeOut() {};
+    /** true if Call(a, b) holds exactly for the data with a time stamp later than b. FairTSBufferFunctional can then use the time index of the branch to find the start. */
+    virtual bool IsTimeThreshold() const {return false;}
 
     virtual ~BinaryFunctor() {};
 
@@ -87,6 +94,8 @@ class StopTime : public BinaryFunctor
 
     void ResetTimeOut() {fSameTimeRequestCounter = 0;}
 
+    bool IsTimeThreshold() const {return true;}
+
   private :
     double fRequestTime;
     double fOldTime;
@@ -145,6 +154,11 @@ class TimeGap : public BinaryFunctor
  *
  * Addition: This is not true anymore. GetData(Double_t, Double_t) is able to get also data which is older but this only works if you request a fixed time
  * via StopTime functor. For other functors the behavior is unpredictable.
+ * With a StopTime start functor the start entry is found with the FairTimeIndex of the branch. It is read from the input file,
+ * for files without index it is built once from all entries of the branch.
+ *
+ * GetTimeSliceData does not use the functors. It selects the entries of a time range with the time index and
+ * keeps them as long as they overlap with later ranges.
  *
  *  Created on: Feb 18, 201
  *      Author: stockman
@@ -156,7 +170,7 @@ class FairTSBufferFunctional : public TObject
   public:
     FairTSBufferFunctional(TString branchName, TTree* sourceTree, BinaryFunctor* stopFunction, BinaryFunctor* startFunction = 0);
 
-    virtual ~FairTSBufferFunctional() {};
+    virtual ~FairTSBufferFunctional();
     TClonesArray* GetData(Double_t stopParameter);
     TClonesArray* GetData(Double_t startParameter, Double_t stopParameter);
     Int_t GetBranchIndex() {return fBranchIndex;}
@@ -184,13 +198,24 @@ class FairTSBufferFunctional : public TObject
 
     Int_t FindStartIndex(Double_t startParameter);
 
+    /** Data with startTime <= time stamp < stopTime. The ranges of consecutive calls should increase,
+     *  then each entry of the branch is read once. The returned array does not own the data and
+     *  is valid until the next call.
+     */
+    TObjArray* GetTimeSliceData(Double_t startTime, Double_t stopTime);
+    /** Time index of the branch, built on first use if the input file has none */
+    FairTimeIndex* GetTimeIndex();
+
 
   private:
+    void InitTimeIndex();
+    Int_t FindStartIndexFromTimeIndex(Double_t startParameter);
     void ReadInNextFilledEntry();
     Int_t ReadInPreviousFilledEntry(Int_t startEntry);
     void ReadInNextEntry();   //** used only if no function is given and input data is directly passed through to the OutputArray
     void ReadInEntry(Int_t number);
     void AbsorbDataBufferArray(); //< Absorbs the complete data from fInputArray to fBufferArray
+    void ReleaseSliceChunk();     //< Drops the oldest entry kept for the time slices
 
     TClonesArray* fOutputArray;
     TClonesArray* fBufferArray;
@@ -201,6 +226,14 @@ class FairTSBufferFunctional : public TObject
 
     TBranch* fBranch;
     Int_t fBranchIndex;
+    FairTimeIndex* fTimeIndex; //! entry -> time range of the branch, owned
+
+    std::deque<std::pair<Int_t, TClonesArray*> > fSliceChunks; //! entries which can overlap with the next time slice
+    std::vector<TClonesArray*> fFreeSliceChunks; //! arrays of released entries
+    Int_t fSliceEntry;         //! next entry to read for the time slices
+    Double_t fSliceStartTime;  //! range of fSliceData
+    Double_t fSliceStopTime;   //!
+    TObjArray* fSliceData;     //! view of the current time slice
 
     Bool_t fTerminate;
 
@@ -14,6 +14,8 @@
 
 #include "FairLogger.h"                 // for FairLogger, MESSAGE_ORIGIN
 #include "FairMonitor.h"                // for FairMonitor
+#include "FairRuntimeDb.h"              // for FairRuntimeDb
+#include "FairTimeSlice.h"              // for FairTimeSlice
 
 #include "TCollection.h"                // for TIter
 #include "TList.h"                      // for TList
@@ -30,6 +32,9 @@ FairTask::FairTask()
     fVerbose(0),
     fInputPersistance(-1),
     fLogger(FairLogger::GetLogger()),
+    fMonitorSlot(-1),
+    fParContainers(),
+    fTimeSliceWarned(kFALSE),
     fOutputPersistance()
 {
 }
@@ -43,6 +48,9 @@ FairTask::FairTask(const char* name, Int_t iVerbose)
     fVerbose(iVerbose),
     fInputPersistance(-1),
     fLogger(FairLogger::GetLogger()),
+    fMonitorSlot(-1),
+    fParContainers(),
+    fTimeSliceWarned(kFALSE),
     fOutputPersistance()
 {
 
@@ -52,7 +60,10 @@ FairTask::FairTask(const char* name, Int_t iVerbose)
 
 
 // -----   Destructor   ----------------------------------------------------
-FairTask::~FairTask() { }
+FairTask::~FairTask()
+{
+  FairMonitor::GetMonitor()->RemoveTask(this);
+}
 // -------------------------------------------------------------------------
 
 
@@ -61,6 +72,7 @@ FairTask::~FairTask() { }
 void FairTask::InitTask()
 {
   FairMonitor::GetMonitor()->SetCurrentTask(this);
+  fMonitorSlot = FairMonitor::GetMonitor()->GetSlot(this,"EXEC");
   if ( ! fActive ) { return; }
   InitStatus tStat = Init();
   if ( tStat == kFATAL ) {
@@ -93,11 +105,35 @@ void FairTask::ReInitTask()
 void FairTask::SetParTask()
 {
   if ( ! fActive ) { return; }
+  FairRuntimeDb* rtdb = FairRuntimeDb::instance();
+  fParContainers.Clear();
+  rtdb->recordRequestedContainers(&fParContainers);
   SetParContainers();
+  rtdb->recordRequestedContainers(0);
   SetParTasks();
 }
 // -------------------------------------------------------------------------
 
+
+
+// -----   Protected method ParContainersChanged   -------------------------
+Bool_t FairTask::ParContainersChanged()
+{
+  // compares the pointers only, containers removed from the runtime
+  // database in the meantime are not touched
+  TIter nextChanged(FairRuntimeDb::instance()->getChangedContainers());
+  TObject* changed;
+  while ( ( changed = nextChanged() ) ) {
+    TIter next(&fParContainers);
+    TObject* cont;
+    while ( ( cont = next() ) ) {
+      if ( cont == changed ) { return kTRUE; }
+    }
+  }
+  return kFALSE;
+}
+// -------------------------------------------------------------------------
+
 // -----    Public method FinishEvent -------------------------------------
 void FairTask::FinishEvent()
 {
@@ -164,9 +200,10 @@ void FairTask::ExecuteTask(Option_t *option)
    if (gDebug > 1) {
      LOG(INFO)<<"Execute task:"<<GetName()<<" : "<<GetTitle()<<FairLogger::endl;
    }
-   FairMonitor::GetMonitor()->StartMonitoring(this,"EXEC");
-   Exec(option);
-   FairMonitor::GetMonitor()->StopMonitoring(this,"EXEC");
+   if ( fMonitorSlot < 0 ) { fMonitorSlot = FairMonitor::GetMonitor()->GetSlot(this,"EXEC"); }
+   FairMonitor::GetMonitor()->StartMonitoring(fMonitorSlot);
+   ExecOrTimeSlice(option);
+   FairMonitor::GetMonitor()->StopMonitoring(fMonitorSlot);
 
 
    fHasExecuted = kTRUE;
@@ -205,9 +242,10 @@ void FairTask::ExecuteTasks(Option_t *option)
       if (gDebug > 1) {
 	LOG(INFO)<<"Execute task:"<<task->GetName()<<" : "<<task->GetTitle()<<FairLogger::endl;
       }
-      FairMonitor::GetMonitor()->StartMonitoring(task,"EXEC");
-      task->Exec(option);
-      FairMonitor::GetMonitor()->StopMonitoring(task,"EXEC");
+      if ( task->fMonitorSlot < 0 ) { task->fMonitorSlot = FairMonitor::GetMonitor()->GetSlot(task,"EXEC"); }
+      FairMonitor::GetMonitor()->StartMonitoring(task->fMonitorSlot);
+      task->ExecOrTimeSlice(option);
+      FairMonitor::GetMonitor()->StopMonitoring(task->fMonitorSlot);
 
       task->fHasExecuted = kTRUE;
       task->ExecuteTasks(option);
@@ -222,6 +260,87 @@ void FairTask::ExecuteTasks(Option_t *option)
 // -------------------------------------------------------------------------
 
 
+//______________________________________________________________________________
+void FairTask::ExecTimeSlice(const FairTimeSlice&)
+{
+   if (!fTimeSliceWarned) {
+      LOG(WARNING) << "FairTask " << GetName() << " has no ExecTimeSlice, Exec is called for each time slice."
+                   << " Branches which are not time based are not read in this mode and keep their old content."
+                   << FairLogger::endl;
+      fTimeSliceWarned = kTRUE;
+   }
+   Exec(fOption);
+}
+// -------------------------------------------------------------------------
+
+//______________________________________________________________________________
+void FairTask::ExecOrTimeSlice(Option_t *option)
+{
+   FairRootManager* ioman = FairRootManager::Instance();
+   FairTimeSlice* slice = ioman ? ioman->GetTimeSlice() : 0;
+   if (slice) {
+      fOption = option;
+      ExecTimeSlice(*slice);
+   } else {
+      Exec(option);
+   }
+}
+// -------------------------------------------------------------------------
+
+//______________________________________________________________________________
+void FairTask::ExecuteWorkerTask(Option_t *option)
+{
+   // Execute main task and its subtasks on a worker thread.
+   // TTask::ExecuteTask keeps the running task and the break point in
+   // static members, which several clones of the task tree running in
+   // parallel would overwrite. Break points are not supported here.
+
+   if (!IsActive()) return;
+
+   fOption = option;
+   ExecOrTimeSlice(option);
+   fHasExecuted = kTRUE;
+   ExecuteWorkerTasks(option);
+
+   CleanTasks();
+}
+// -------------------------------------------------------------------------
+
+//______________________________________________________________________________
+void FairTask::ExecuteWorkerTasks(Option_t *option)
+{
+   // Execute all the subtasks of a task on a worker thread.
+
+   TIter next(fTasks);
+   FairTask *task;
+   while((task=(FairTask*)next())) {
+      if (!task->IsActive()) continue;
+      if (!task->fHasExecuted) {
+         task->ExecOrTimeSlice(option);
+         task->fHasExecuted = kTRUE;
+      }
+      task->ExecuteWorkerTasks(option);
+   }
+}
+// -------------------------------------------------------------------------
+
+
+// -----   Public method MergeWorkerTask   ---------------------------------
+void FairTask::MergeWorkerTask(FairTask* workerTask)
+{
+  if ( ! fActive || ! workerTask ) { return; }
+  MergeWorker(workerTask);
+  // the worker tree is a clone, the subtasks are in the same order
+  TIter next(GetListOfTasks());
+  TIter nextWorker(workerTask->GetListOfTasks());
+  FairTask* task;
+  while( ( task=dynamic_cast<FairTask*>(next()) ) ) {
+    task->MergeWorkerTask(dynamic_cast<FairTask*>(nextWorker()));
+  }
+}
+// -------------------------------------------------------------------------
+
+
 // -----   Protected method ReInitTasks   ----------------------------------
 void FairTask::ReInitTasks()
 {
@@ -27,11 +27,13 @@
 #include "FairRootManager.h"            // for FairRootManager
 
 #include "Rtypes.h"                     // for Int_t, FairTask::Class, etc
+#include "TList.h"                      // for TList
 #include "TString.h"                    // for TString
 
 #include <map>
 
 class FairLogger;
+class FairTimeSlice;
 
 enum InitStatus {kSUCCESS, kERROR, kFATAL};
 
@@ -86,6 +88,19 @@ class FairTask : public TTask
 
     virtual void  ExecuteTask(Option_t *option="0");  // *MENU*
 
+    /** Execute this task and all of its subtasks without using the static
+     *  bookkeeping of TTask and without monitoring. Used by the worker
+     *  threads of FairRunAna, which each own a clone of the task tree.
+    **/
+    void ExecuteWorkerTask(Option_t *option="0");
+
+    /** Add the results of workerTask, the clone of this task tree on a
+     *  worker thread of FairRunAna, to this task tree. Called for every
+     *  worker after the event loop, FinishTask is then called once on
+     *  this task tree only.
+    **/
+    void MergeWorkerTask(FairTask* workerTask);
+
     /** Set persistency of branch with given name true or false
      *  In case is is set to false the branch will not be written to the output.
     **/   
@@ -101,6 +116,9 @@ class FairTask : public TTask
     Int_t        fVerbose;  //  Verbosity level
     Int_t        fInputPersistance; ///< Indicates if input branch is persistant
     FairLogger*  fLogger; //!
+    Int_t        fMonitorSlot; //! FairMonitor slot of the EXEC measurement
+    TList        fParContainers; //! containers requested from the FairRuntimeDb in SetParContainers
+    Bool_t       fTimeSliceWarned; //! default ExecTimeSlice has warned
 
     /** Intialisation at begin of run. To be implemented in the derived class.
     *@value  Success   If not kSUCCESS, task will be set inactive.
@@ -114,6 +132,13 @@ class FairTask : public TTask
     virtual InitStatus ReInit() { return kSUCCESS; };
 
 
+    /** Returns kTRUE if one of the parameter containers requested in
+     *  SetParContainers was read again for the new run, i.e. if ReInit
+     *  has to update anything which depends on the parameters.
+    **/
+    Bool_t ParContainersChanged();
+
+
     /** Intialise parameter containers.
         To be implemented in the derived class.
     **/
@@ -123,6 +148,23 @@ class FairTask : public TTask
     /** Action after each event. To be implemented in the derived class **/
     virtual void Finish() { };
 
+
+    /** Called instead of Exec for each time slice in the time slice mode of
+     *  FairRunAna, the data of the slice is available via
+     *  FairRootManager::GetTimeSliceData. The default calls Exec with the
+     *  option of the task and warns once, because the branches which are
+     *  not time based are not read in this mode.
+    **/
+    virtual void ExecTimeSlice(const FairTimeSlice& slice);
+
+
+    /** Add the results which the clone workerTask accumulated on a worker
+     *  thread in the multi-threaded mode of FairRunAna, e.g. histograms or
+     *  counters written in Finish. To be implemented in the derived class,
+     *  only this task and not its clones is finished.
+    **/
+    virtual void MergeWorker(FairTask* /*workerTask*/) { };
+
     //  /** Action after each event. To be implemented in the derived class **/
     //  virtual void FinishTask() { };
 
@@ -135,6 +177,12 @@ class FairTask : public TTask
 
     virtual void  ExecuteTasks(Option_t *option);
 
+    /** Recursive execution of subtasks on a worker thread **/
+    void ExecuteWorkerTasks(Option_t *option);
+
+    /** Exec or ExecTimeSlice, depending on the current time slice of the FairRootManager **/
+    void ExecOrTimeSlice(Option_t *option);
+
     /** Recursive parameter initialisation for subtasks **/
     void SetParTasks();
 
@@ -0,0 +1,119 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairTimeIndex.h"
+
+#include "FairTimeStamp.h"              // for FairTimeStamp
+
+#include "TClonesArray.h"               // for TClonesArray
+
+#include <algorithm>                    // for lower_bound, upper_bound
+#include <limits>                       // for numeric_limits
+
+ClassImp(FairTimeIndex);
+
+//_____________________________________________________________________________
+FairTimeIndex::FairTimeIndex()
+  : TObject(),
+    fMinTime(),
+    fMaxTime(),
+    fMaxTimeUpTo(),
+    fMinTimeFrom()
+{
+}
+//_____________________________________________________________________________
+
+FairTimeIndex::~FairTimeIndex()
+{
+}
+//_____________________________________________________________________________
+
+void FairTimeIndex::AddEntry(TClonesArray* data)
+{
+  Int_t nData = data ? data->GetEntriesFast() : 0;
+  if (nData == 0) {
+    AddEmptyEntry();
+    return;
+  }
+  Double_t minTime = std::numeric_limits<Double_t>::max();
+  Double_t maxTime = -std::numeric_limits<Double_t>::max();
+  for (Int_t i = 0; i < nData; i++) {
+    FairTimeStamp* timeStamp = static_cast<FairTimeStamp*>(data->At(i));
+    if (timeStamp == 0) {
+      continue;
+    }
+    Double_t time = timeStamp->GetTimeStamp();
+    if (time < minTime) { minTime = time; }
+    if (time > maxTime) { maxTime = time; }
+  }
+  AddEntry(minTime, maxTime);
+}
+//_____________________________________________________________________________
+
+void FairTimeIndex::AddEntry(Double_t minTime, Double_t maxTime)
+{
+  fMinTime.push_back(minTime);
+  fMaxTime.push_back(maxTime);
+}
+//_____________________________________________________________________________
+
+void FairTimeIndex::AddEmptyEntry()
+{
+  AddEntry(std::numeric_limits<Double_t>::max(), -std::numeric_limits<Double_t>::max());
+}
+//_____________________________________________________________________________
+
+Int_t FairTimeIndex::FindFirstEntryAfter(Double_t time)
+{
+  /** The running maximum is sorted even if the entries overlap in time.
+   *  All entries before the first one which raises it above time contain
+   *  only older data, empty entries never raise it.
+   */
+  UpdateRunningTimes();
+  return std::upper_bound(fMaxTimeUpTo.begin(), fMaxTimeUpTo.end(), time) - fMaxTimeUpTo.begin();
+}
+//_____________________________________________________________________________
+
+Int_t FairTimeIndex::FindFirstEntryFrom(Double_t time)
+{
+  UpdateRunningTimes();
+  return std::lower_bound(fMaxTimeUpTo.begin(), fMaxTimeUpTo.end(), time) - fMaxTimeUpTo.begin();
+}
+//_____________________________________________________________________________
+
+Double_t FairTimeIndex::GetMinTimeFrom(Int_t entry)
+{
+  UpdateRunningTimes();
+  return fMinTimeFrom[entry];
+}
+//_____________________________________________________________________________
+
+Double_t FairTimeIndex::GetMaxTimeUpTo(Int_t entry)
+{
+  UpdateRunningTimes();
+  return fMaxTimeUpTo[entry];
+}
+//_____________________________________________________________________________
+
+void FairTimeIndex::UpdateRunningTimes()
+{
+  if (fMaxTimeUpTo.size() != fMaxTime.size()) {
+    size_t first = fMaxTimeUpTo.size();
+    fMaxTimeUpTo.resize(fMaxTime.size());
+    for (size_t i = first; i < fMaxTime.size(); i++) {
+      fMaxTimeUpTo[i] = (i == 0 || fMaxTime[i] > fMaxTimeUpTo[i - 1]) ? fMaxTime[i] : fMaxTimeUpTo[i - 1];
+    }
+  }
+  if (fMinTimeFrom.size() != fMinTime.size()) {
+    // a new entry can lower the minimum of all entries before it
+    fMinTimeFrom.resize(fMinTime.size());
+    for (size_t i = fMinTime.size(); i-- > 0;) {
+      fMinTimeFrom[i] = (i + 1 == fMinTime.size() || fMinTime[i] < fMinTimeFrom[i + 1]) ? fMinTime[i] : fMinTimeFrom[i + 1];
+    }
+  }
+}
+//_____________________________________________________________________________
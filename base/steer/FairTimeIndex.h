@@ -0,0 +1,67 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#ifndef FAIRTIMEINDEX_H_
+#define FAIRTIMEINDEX_H_
+
+#include "TObject.h"                    // for TObject
+
+#include "Rtypes.h"                     // for Int_t, Double_t, etc
+#include "TString.h"                    // for TString
+
+#include <vector>                       // for vector
+
+class TClonesArray;
+
+/**
+ * \class FairTimeIndex
+ * \brief Smallest and largest time stamp of each entry of a time based branch
+ *
+ * FairRootManager fills one index per time based output branch and writes it
+ * next to the tree under GetIndexName(branchName). FairTSBufferFunctional uses it to
+ * find the first entry with data after a given time by binary search instead of
+ * reading the entries one by one.
+ */
+class FairTimeIndex : public TObject
+{
+  public:
+    FairTimeIndex();
+    virtual ~FairTimeIndex();
+
+    /** Adds the next entry with the FairTimeStamp objects in data */
+    void AddEntry(TClonesArray* data);
+    void AddEntry(Double_t minTime, Double_t maxTime);
+    void AddEmptyEntry();
+
+    Int_t GetNEntries() const { return fMinTime.size(); }
+    Bool_t IsEmpty(Int_t entry) const { return fMinTime[entry] > fMaxTime[entry]; }
+    Double_t GetMinTime(Int_t entry) const { return fMinTime[entry]; }
+    Double_t GetMaxTime(Int_t entry) const { return fMaxTime[entry]; }
+
+    /** First entry which contains data later than time, GetNEntries() if there is none */
+    Int_t FindFirstEntryAfter(Double_t time);
+    /** First entry which contains data at time or later, GetNEntries() if there is none */
+    Int_t FindFirstEntryFrom(Double_t time);
+    /** Smallest time stamp of the entry and all later entries */
+    Double_t GetMinTimeFrom(Int_t entry);
+    /** Largest time stamp of the entry and all earlier entries */
+    Double_t GetMaxTimeUpTo(Int_t entry);
+
+    static TString GetIndexName(const TString& branchName) { return "TimeIndex_" + branchName; }
+
+  private:
+    std::vector<Double_t> fMinTime;
+    std::vector<Double_t> fMaxTime;
+    std::vector<Double_t> fMaxTimeUpTo; //! largest time stamp up to the entry, rebuilt after reading
+    std::vector<Double_t> fMinTimeFrom; //! smallest time stamp from the entry on, rebuilt after reading
+
+    void UpdateRunningTimes();
+
+    ClassDef(FairTimeIndex, 1);
+};
+
+#endif /* FAIRTIMEINDEX_H_ */
@@ -0,0 +1,36 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairTimeSlice.h"
+
+ClassImp(FairTimeSlice);
+
+//_____________________________________________________________________________
+FairTimeSlice::FairTimeSlice()
+  : TObject(),
+    fIndex(-1),
+    fStartTime(0.),
+    fEndTime(0.),
+    fOverlap(0.)
+{
+}
+//_____________________________________________________________________________
+
+FairTimeSlice::FairTimeSlice(Int_t index, Double_t startTime, Double_t endTime, Double_t overlap)
+  : TObject(),
+    fIndex(index),
+    fStartTime(startTime),
+    fEndTime(endTime),
+    fOverlap(overlap)
+{
+}
+//_____________________________________________________________________________
+
+FairTimeSlice::~FairTimeSlice()
+{
+}
+//_____________________________________________________________________________
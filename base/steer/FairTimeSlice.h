@@ -0,0 +1,50 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#ifndef FAIRTIMESLICE_H_
+#define FAIRTIMESLICE_H_
+
+#include "TObject.h"                    // for TObject
+
+#include "Rtypes.h"                     // for Int_t, Double_t, etc
+
+/**
+ * \class FairTimeSlice
+ * \brief Time interval processed in one step of the time slice mode of FairRunAna
+ *
+ * The slice owns the data with start time <= time stamp < end time (the core). The
+ * data in [end time, end time + overlap) belongs to the core of the next slice but is
+ * handed to the tasks as well, e.g. to finish clusters which cross the slice border.
+ * The data of a time based input branch is available via FairRootManager::GetTimeSliceData.
+ */
+class FairTimeSlice : public TObject
+{
+  public:
+    FairTimeSlice();
+    FairTimeSlice(Int_t index, Double_t startTime, Double_t endTime, Double_t overlap);
+    virtual ~FairTimeSlice();
+
+    Int_t GetIndex() const { return fIndex; }
+    Double_t GetStartTime() const { return fStartTime; }
+    Double_t GetEndTime() const { return fEndTime; }
+    Double_t GetOverlap() const { return fOverlap; }
+    /** End of the overlap region, all data handed to the tasks is older */
+    Double_t GetOverlapEndTime() const { return fEndTime + fOverlap; }
+
+    Bool_t IsInCore(Double_t time) const { return time >= fStartTime && time < fEndTime; }
+    Bool_t IsInOverlap(Double_t time) const { return time >= fEndTime && time < fEndTime + fOverlap; }
+
+  private:
+    Int_t fIndex;
+    Double_t fStartTime;
+    Double_t fEndTime;
+    Double_t fOverlap;
+
+    ClassDef(FairTimeSlice, 1);
+};
+
+#endif /* FAIRTIMESLICE_H_ */
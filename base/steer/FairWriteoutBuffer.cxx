@@ -130,14 +130,15 @@ std::vector<FairTimeStamp*> FairWriteoutBuffer::GetRemoveOldData(double time)
 {
   typedef std::multimap<double, FairTimeStamp*>::iterator DTMapIter;
   std::vector<FairTimeStamp*> result;
-  for(DTMapIter it = fDeadTime_map.begin(); it != fDeadTime_map.lower_bound(time); it++) {
+  DTMapIter stopTime = fDeadTime_map.lower_bound(time);
+  for(DTMapIter it = fDeadTime_map.begin(); it != stopTime; it++) {
     if (fVerbose > 1) {
       std::cout << "-I- GetRemoveOldData: DeadTime: " << it->first << " Data: " << it->second << std::endl;
     }
     result.push_back(it->second);
     EraseDataFromDataMap(it->second);
   }
-  fDeadTime_map.erase(fDeadTime_map.begin(), fDeadTime_map.lower_bound(time));
+  fDeadTime_map.erase(fDeadTime_map.begin(), stopTime);
   return result;
 }
 //_____________________________________________________________________________
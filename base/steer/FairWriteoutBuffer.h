@@ -25,7 +25,8 @@
  * The data which should be stored in the buffer has to be derived from FairTimeStamp.
  * It needs an operator< and a method equal if the same detector element is hit.
  *
- * To use this buffer one has to derive his own buffer class from FairWriteoutBuffer and overwrite the pure virtual functions.
+ * To use this buffer one has to derive his own buffer class from FairWriteoutBuffer and overwrite the pure virtual functions,
+ * or use FairWriteoutBufferT with a functor returning the detector element of the data.
  */
 
 #ifndef FairWriteoutBuffer_H_
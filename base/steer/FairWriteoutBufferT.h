@@ -0,0 +1,256 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * @class FairWriteoutBufferT
+ *
+ * @brief FairWriteoutBuffer for one data class, without the search maps of the derived classes
+ *
+ * TData is the stored data class (derived from FairTimeStamp, with a copy constructor and
+ * an assignment operator). TChannelId is a functor which returns the detector element of
+ * the data, e.g. the pixel, as a hashable value and defines its type as result_type:
+ *
+ *   struct MyPixelId {
+ *     typedef Long64_t result_type;
+ *     Long64_t operator()(const MyDigi& digi) const { return digi.GetSensorId() * 100000 + digi.GetPixel(); }
+ *   };
+ *   FairWriteoutBufferT<MyDigi, MyPixelId>* buffer = new FairWriteoutBufferT<MyDigi, MyPixelId>("MyDigi", "MyDet", kTRUE);
+ *
+ * The busy detector elements are kept in a hash map, the start and dead times in two
+ * binary heaps. The data is copied into recycled slots when it is filled and copy
+ * constructed into the TClonesArray of the branch when it is written out.
+ *
+ * If data of a busy detector element arrives, ModifyData is called instead of Modify.
+ * By default the new data is ignored (pile-up).
+ */
+
+#ifndef FairWriteoutBufferT_H_
+#define FairWriteoutBufferT_H_
+
+#include "FairWriteoutBuffer.h"         // for FairWriteoutBuffer
+
+#include "FairRootManager.h"            // for FairRootManager
+#include "FairTimeStamp.h"              // for FairTimeStamp
+
+#include "Rtypes.h"                     // for UInt_t, etc
+#include "TClonesArray.h"               // for TClonesArray
+#include "TString.h"                    // for TString
+
+#include <boost/unordered_map.hpp>      // for unordered_map
+
+#include <iostream>                     // for cout
+#include <limits>                       // for numeric_limits
+#include <queue>                        // for priority_queue
+#include <vector>                       // for vector
+
+template <class TData, class TChannelId>
+class FairWriteoutBufferT : public FairWriteoutBuffer
+{
+  public:
+    typedef typename TChannelId::result_type ChannelId;
+
+    FairWriteoutBufferT(TChannelId channelId = TChannelId())
+      : FairWriteoutBuffer(), fChannelId(channelId), fSlots(), fFreeSlots(), fActive(),
+        fStartQueue(), fDeadQueue(), fSequence(0) {}
+    FairWriteoutBufferT(TString branchName, TString folderName, Bool_t persistance, TChannelId channelId = TChannelId())
+      : FairWriteoutBuffer(branchName, TData::Class_Name(), folderName, persistance), fChannelId(channelId),
+        fSlots(), fFreeSlots(), fActive(), fStartQueue(), fDeadQueue(), fSequence(0) {}
+
+    virtual ~FairWriteoutBufferT() {
+      for (size_t i = 0; i < fSlots.size(); i++) {
+        delete fSlots[i].fData;
+      }
+    }
+
+    virtual void FillNewData(FairTimeStamp* data, double startTime, double activeTime) {
+      if (!fActivateBuffering) {
+        AddNewDataToTClonesArray(data);
+        return;
+      }
+      if (fVerbose > 0) {
+        std::cout << "StartTime: " << startTime << std::endl;
+      }
+      UInt_t slot = NewSlot(*static_cast<TData*>(data), activeTime);
+      fStartQueue.push(QueueEntry(startTime, fSequence++, slot, fSlots[slot].fGeneration));
+    }
+
+    virtual Int_t GetNData() {
+      return fActive.size();
+    }
+
+    /// The returned data is owned by the caller
+    virtual std::vector<FairTimeStamp*> GetRemoveOldData(double time) {
+      std::vector<FairTimeStamp*> result;
+      UInt_t slot;
+      while (PopExpired(time, slot)) {
+        result.push_back(new TData(*fSlots[slot].fData));
+        FreeSlot(slot);
+      }
+      return result;
+    }
+    virtual std::vector<FairTimeStamp*> GetAllData() {
+      return GetRemoveOldData(std::numeric_limits<double>::max());
+    }
+
+    virtual void WriteOutData(double time) {
+      if (!fActivateBuffering) {
+        FairWriteoutBuffer::WriteOutData(time);
+        return;
+      }
+      MoveDataFromStartTimeMapToDeadTimeMap(time);
+      WriteOutDataDeadTimeMap(time);
+    }
+    virtual void WriteOutAllData() {
+      WriteOutData(std::numeric_limits<double>::max());
+    }
+
+  protected:
+    /// Called if newData hits a detector element which is still busy with activeData.
+    /// activeData and its activeTime can be changed, newData is dropped afterwards.
+    virtual void ModifyData(TData& activeData, double& activeTime, const TData& newData, double newActiveTime) {}
+
+    virtual void AddNewDataToTClonesArray(FairTimeStamp* data) {
+      TClonesArray* myArray = FairRootManager::Instance()->GetTClonesArray(fBranchName);
+      new ((*myArray)[myArray->GetEntriesFast()]) TData(*static_cast<TData*>(data));
+    }
+    virtual double FindTimeForData(FairTimeStamp* data) {
+      typename ActiveMap::const_iterator it = fActive.find(fChannelId(*static_cast<TData*>(data)));
+      return it == fActive.end() ? -1 : fSlots[it->second].fActiveTime;
+    }
+    // the hash map is filled by the buffer itself
+    virtual void FillDataMap(FairTimeStamp*, double) {}
+    virtual void EraseDataFromDataMap(FairTimeStamp*) {}
+
+    virtual void MoveDataFromStartTimeMapToDeadTimeMap(double time) {
+      while (!fStartQueue.empty() && fStartQueue.top().fTime < time) {
+        UInt_t slot = fStartQueue.top().fSlot;
+        fStartQueue.pop();
+        Activate(slot);
+      }
+    }
+
+    virtual void WriteOutDataDeadTimeMap(double time) {
+      if (fVerbose > 0) {
+        std::cout << "-I- FairWriteoutBufferT::WriteOutData for time: " << time << std::endl;
+      }
+      TClonesArray* myArray = 0;
+      if (fTreeSave) {
+        myArray = FairRootManager::Instance()->GetTClonesArray(fBranchName);
+        if (!myArray) {
+          std::cout << "-E- FairWriteoutBufferT::WriteOutData " << fBranchName << " array is not available!" << std::endl;
+        }
+      }
+      UInt_t slot;
+      while (PopExpired(time, slot)) {
+        if (myArray) {
+          new ((*myArray)[myArray->GetEntriesFast()]) TData(*fSlots[slot].fData);
+        }
+        FreeSlot(slot);
+      }
+    }
+
+    virtual void PrintStartTimeMap() {
+      std::cout << "StartTimeQueue: " << fStartQueue.size() << " entries" << std::endl;
+    }
+    virtual void PrintDeadTimeMap() {
+      std::cout << "DeadTimeQueue: " << fActive.size() << " active entries" << std::endl;
+    }
+
+  private:
+    struct Slot {
+      Slot(TData* data, double activeTime) : fData(data), fActiveTime(activeTime), fGeneration(0) {}
+      TData* fData;
+      double fActiveTime;
+      UInt_t fGeneration;  ///< changed whenever a queue entry of the slot becomes invalid
+    };
+
+    struct QueueEntry {
+      QueueEntry(double time, ULong64_t sequence, UInt_t slot, UInt_t generation)
+        : fTime(time), fSequence(sequence), fSlot(slot), fGeneration(generation) {}
+      double fTime;
+      ULong64_t fSequence; ///< keeps the filling order for equal times like the multimaps did
+      UInt_t fSlot;
+      UInt_t fGeneration;
+    };
+
+    /// orders the priority queues by ascending time
+    struct Later {
+      bool operator()(const QueueEntry& a, const QueueEntry& b) const {
+        return a.fTime > b.fTime || (a.fTime == b.fTime && a.fSequence > b.fSequence);
+      }
+    };
+
+    typedef boost::unordered_map<ChannelId, UInt_t> ActiveMap;
+    typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, Later> TimeQueue;
+
+    UInt_t NewSlot(const TData& data, double activeTime) {
+      if (fFreeSlots.empty()) {
+        fSlots.push_back(Slot(new TData(data), activeTime));
+        return fSlots.size() - 1;
+      }
+      UInt_t slot = fFreeSlots.back();
+      fFreeSlots.pop_back();
+      *fSlots[slot].fData = data;
+      fSlots[slot].fActiveTime = activeTime;
+      return slot;
+    }
+
+    void FreeSlot(UInt_t slot) {
+      fSlots[slot].fGeneration++;
+      fFreeSlots.push_back(slot);
+    }
+
+    /// Makes the data of the slot block its detector element until its active time
+    void Activate(UInt_t slot) {
+      Slot& newData = fSlots[slot];
+      std::pair<typename ActiveMap::iterator, bool> inserted = fActive.insert(std::make_pair(fChannelId(*newData.fData), slot));
+      if (inserted.second) {
+        fDeadQueue.push(QueueEntry(newData.fActiveTime, fSequence++, slot, newData.fGeneration));
+        return;
+      }
+
+      Slot& oldData = fSlots[inserted.first->second];
+      double oldTime = oldData.fActiveTime;
+      if (fVerbose > 1) {
+        std::cout << " OldData found! " << oldTime << std::endl;
+      }
+      ModifyData(*oldData.fData, oldData.fActiveTime, *newData.fData, newData.fActiveTime);
+      if (oldData.fActiveTime != oldTime) {
+        oldData.fGeneration++;
+        fDeadQueue.push(QueueEntry(oldData.fActiveTime, fSequence++, inserted.first->second, oldData.fGeneration));
+      }
+      FreeSlot(slot);
+    }
+
+    /// Takes the next valid entry with a dead time before time from the dead time queue
+    bool PopExpired(double time, UInt_t& slot) {
+      while (!fDeadQueue.empty() && fDeadQueue.top().fTime < time) {
+        QueueEntry entry = fDeadQueue.top();
+        fDeadQueue.pop();
+        if (entry.fGeneration != fSlots[entry.fSlot].fGeneration) {
+          continue;
+        }
+        fActive.erase(fChannelId(*fSlots[entry.fSlot].fData));
+        slot = entry.fSlot;
+        return true;
+      }
+      return false;
+    }
+
+    TChannelId fChannelId;
+    std::vector<Slot> fSlots;
+    std::vector<UInt_t> fFreeSlots;
+    ActiveMap fActive;         ///< busy detector elements and their slots
+    TimeQueue fStartQueue;     ///< filled data by start time
+    TimeQueue fDeadQueue;      ///< active data by the end of its active time
+    ULong64_t fSequence;
+
+    FairWriteoutBufferT(const FairWriteoutBufferT&);
+    FairWriteoutBufferT& operator=(const FairWriteoutBufferT&);
+};
+
+#endif /* FairWriteoutBufferT_H_ */
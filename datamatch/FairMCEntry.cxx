@@ -30,12 +30,10 @@ FairMCEntry::~FairMCEntry()
 
 void FairMCEntry::RemoveType(Int_t type)
 {
- // std::set<FairLink>::iterator endIter = fLinks.end();
-  std::set<FairLink>::iterator it = fLinks.begin();
+  std::vector<FairCompactLink>::iterator it = fLinks.begin();
   for (; it!=fLinks.end();) {
-    if (it->GetType() == type) {
-      fLinks.erase(it);
-      it = fLinks.begin();
+    if (it->fType == type) {
+      it = fLinks.erase(it);
     } else {
       it++;
     }
@@ -31,9 +31,11 @@ int main(int argc, char** argv)
         
         // sampler-specific commandline configuration
         std::string filename;
+        std::string aggregation;
         po::options_description sampler_options("Sampler options");
         sampler_options.add_options()
             ("input-file-name", po::value<std::string>(&filename), "Path to the input file")
+            ("aggregation", po::value<std::string>(&aggregation)->default_value("subevent"), "Send every 'subevent' or gather the sub-events of an 'event' or of an MBS 'buffer'")
         ;
 
         short type;
@@ -64,6 +66,19 @@ int main(int argc, char** argv)
 
         FairMQLmdSampler sampler;
         sampler.AddFile(filename);
+        if (aggregation == "event")
+        {
+            sampler.SetAggregationMode(FairMQLmdSampler::kEvent);
+        }
+        else if (aggregation == "buffer")
+        {
+            sampler.SetAggregationMode(FairMQLmdSampler::kBuffer);
+        }
+        else if (aggregation != "subevent")
+        {
+            LOG(ERROR) << "Unknown aggregation mode '" << aggregation << "', use subevent, event or buffer";
+            return 1;
+        }
         // combination of sub-event header value = one special channel
         // this channel MUST be defined in the json file for the MQ configuration
         sampler.AddSubEvtKey(type, subType, procId, subCrate, control, chanName);
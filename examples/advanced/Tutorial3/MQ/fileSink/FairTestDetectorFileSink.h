@@ -27,6 +27,7 @@
 
 #include "FairMQDevice.h"
 #include "FairMQLogger.h"
+#include "FairMQMessageStreamBuf.h"
 
 #include "FairTestDetectorPayload.h"
 #include "FairTestDetectorHit.h"
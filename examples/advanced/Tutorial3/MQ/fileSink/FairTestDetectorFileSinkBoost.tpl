@@ -24,12 +24,12 @@ void FairTestDetectorFileSink<TIn, TPayloadIn>::Run()
             if (dataInChannel.Receive(msg) > 0)
             {
                 receivedMsgs++;
-                string msgStr(static_cast<char*>(msg->GetData()), msg->GetSize());
-                istringstream ibuffer(msgStr);
-                TPayloadIn InputArchive(ibuffer);
+                FairMQMessageInBuf inBuf(msg);
+                istream ibuffer(&inBuf);
 
                 try
                 {
+                    TPayloadIn InputArchive(ibuffer);
                     InputArchive >> fHitVector;
                 }
                 catch (boost::archive::archive_exception& e)
@@ -27,6 +27,7 @@
 #include "FairMQLogger.h"
 #include "FairMQProcessorTask.h"
 #include "FairMQMessage.h"
+#include "FairMQMessageStreamBuf.h"
 
 #include "FairTestDetectorRecoTask.h"
 #include "FairTestDetectorPayload.h"
@@ -50,6 +51,7 @@ class FairTestDetectorMQRecoTask : public FairMQProcessorTask
         : fRecoTask(NULL)
         , fDigiVector()
         , fHitVector()
+        , fOutBuf()
         , fHasBoostSerialization(false)
     {
         using namespace baseMQ::tools::resolve;
@@ -82,6 +84,7 @@ class FairTestDetectorMQRecoTask : public FairMQProcessorTask
         : fRecoTask(NULL)
         , fDigiVector()
         , fHitVector()
+        , fOutBuf()
         , fHasBoostSerialization(false)
     {
         using namespace baseMQ::tools::resolve;
@@ -174,6 +177,7 @@ class FairTestDetectorMQRecoTask : public FairMQProcessorTask
     friend class boost::serialization::access;
     vector<TIn> fDigiVector;
     vector<TOut> fHitVector;
+    FairMQMessageOutBuf fOutBuf;
 #endif // for BOOST serialization
 
     /// Copy Constructor
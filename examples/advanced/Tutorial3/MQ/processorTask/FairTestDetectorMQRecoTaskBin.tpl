@@ -37,7 +37,7 @@ void FairTestDetectorMQRecoTask<FairTestDetectorDigi, FairTestDetectorHit, TestD
     int numOutput = numInput;
     int outputSize = numOutput * sizeof(TestDetectorPayload::Hit);
 
-    fPayload->Rebuild(outputSize);
+    fPayload->RebuildPooled(outputSize);
     TestDetectorPayload::Hit* output = static_cast<TestDetectorPayload::Hit*>(fPayload->GetData());
 
     if (inputSize > 0)
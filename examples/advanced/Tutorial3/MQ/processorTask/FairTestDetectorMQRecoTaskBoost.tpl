@@ -14,12 +14,12 @@ void FairTestDetectorMQRecoTask<TIn, TOut, TPayloadIn, TPayloadOut>::Exec(Option
     {
         int inputSize = fPayload->GetSize();
 
-        // prepare boost input archive
-        string msgStr(static_cast<char*>(fPayload->GetData()), fPayload->GetSize());
-        istringstream ibuffer(msgStr);
-        TPayloadIn InputArchive(ibuffer);
+        // prepare boost input archive, reading the message in place
+        FairMQMessageInBuf inBuf(fPayload);
+        istream ibuffer(&inBuf);
         try
         {
+            TPayloadIn InputArchive(ibuffer);
             InputArchive >> fDigiVector; // get input Archive
         }
         catch (boost::archive::archive_exception& e)
@@ -54,13 +54,13 @@ void FairTestDetectorMQRecoTask<TIn, TOut, TPayloadIn, TPayloadOut>::Exec(Option
             }
         }
 
-        // prepare boost output archive
-        ostringstream obuffer;
-        TPayloadOut OutputArchive(obuffer);
-        OutputArchive << fHitVector;
-        int outputSize = obuffer.str().length();
-        fPayload->Rebuild(outputSize);
-        memcpy(fPayload->GetData(), obuffer.str().c_str(), outputSize);
+        // prepare boost output archive, written directly into the buffer of the new payload
+        {
+            ostream obuffer(&fOutBuf);
+            TPayloadOut OutputArchive(obuffer);
+            OutputArchive << fHitVector;
+        }
+        fOutBuf.Finish(fPayload);
         if (fDigiVector.size() > 0)
         {
             fDigiVector.clear();
@@ -0,0 +1,161 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * runTestDetectorBoostBenchmark.cxx
+ *
+ * Compares the boost serialization of the Tutorial3 digi and hit payloads through
+ * std::ostringstream/std::istringstream (as done before) with BoostSerializer and
+ * BoostDeSerializer, which write into and read from the message buffers directly.
+ * Both ways have to give the same bytes.
+ *
+ * Usage: testDetectorBoostBenchmark [objects per message] [messages]
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TClonesArray.h"
+#include "TStopwatch.h"
+#include "TVector3.h"
+
+#include "FairMQLogger.h"
+#include "FairMQMessage.h"
+
+#ifdef NANOMSG
+#include "nanomsg/FairMQTransportFactoryNN.h"
+#else
+#include "zeromq/FairMQTransportFactoryZMQ.h"
+#endif
+
+#include "BoostSerializer.h"
+
+#include "FairTestDetectorDigi.h"
+#include "FairTestDetectorHit.h"
+
+using namespace std;
+
+/// Serialization as it was done before: copy into a vector, stage in an ostringstream, copy into the message
+template <typename T>
+void SerializeStaged(TClonesArray* array, FairMQMessage* msg)
+{
+    vector<T> dataVector;
+    for (Int_t i = 0; i < array->GetEntriesFast(); ++i)
+    {
+        T* data = static_cast<T*>(array->At(i));
+        if (data)
+        {
+            dataVector.push_back(*data);
+        }
+    }
+    ostringstream buffer;
+    BoostBinArchOut OutputArchive(buffer);
+    OutputArchive << dataVector;
+    int size = buffer.str().length();
+    msg->Rebuild(size);
+    memcpy(msg->GetData(), buffer.str().c_str(), size);
+}
+
+/// Deserialization as it was done before: copy the message into a string for an istringstream
+template <typename T>
+void DeserializeStaged(FairMQMessage* msg, vector<T>& dataVector)
+{
+    dataVector.clear();
+    string msgStr(static_cast<char*>(msg->GetData()), msg->GetSize());
+    istringstream buffer(msgStr);
+    BoostBinArchIn InputArchive(buffer);
+    InputArchive >> dataVector;
+}
+
+template <typename T>
+bool RunBenchmark(const string& name, TClonesArray* array, FairMQTransportFactory* transportFactory, int nMessages)
+{
+    unique_ptr<FairMQMessage> stagedMsg(transportFactory->CreateMessage());
+    unique_ptr<FairMQMessage> directMsg(transportFactory->CreateMessage());
+    BoostSerializer<T> serializer;
+    serializer.SetMessage(directMsg.get());
+    BoostDeSerializer<T> deserializer;
+    vector<T> stagedVector;
+
+    TStopwatch timer;
+    timer.Start();
+    for (int i = 0; i < nMessages; ++i)
+    {
+        SerializeStaged<T>(array, stagedMsg.get());
+    }
+    double stagedSerialization = timer.RealTime();
+
+    timer.Start();
+    for (int i = 0; i < nMessages; ++i)
+    {
+        serializer.SerializeMsg(array);
+    }
+    double directSerialization = timer.RealTime();
+
+    timer.Start();
+    for (int i = 0; i < nMessages; ++i)
+    {
+        DeserializeStaged<T>(stagedMsg.get(), stagedVector);
+    }
+    double stagedDeserialization = timer.RealTime();
+
+    timer.Start();
+    size_t nDeserialized = 0;
+    for (int i = 0; i < nMessages; ++i)
+    {
+        nDeserialized = deserializer.DeserializeMsg(directMsg.get()).size();
+    }
+    double directDeserialization = timer.RealTime();
+
+    bool same = stagedMsg->GetSize() == directMsg->GetSize()
+             && memcmp(stagedMsg->GetData(), directMsg->GetData(), stagedMsg->GetSize()) == 0
+             && nDeserialized == stagedVector.size();
+
+    LOG(INFO) << name << ": " << nMessages << " messages of " << directMsg->GetSize() << " bytes";
+    LOG(INFO) << "  serialization   ostringstream: " << stagedSerialization << " s, in place: " << directSerialization
+              << " s, speedup " << stagedSerialization / directSerialization;
+    LOG(INFO) << "  deserialization istringstream: " << stagedDeserialization << " s, in place: " << directDeserialization
+              << " s, speedup " << stagedDeserialization / directDeserialization;
+    if (!same)
+    {
+        LOG(ERROR) << name << ": the serialized data differs";
+    }
+    return same;
+}
+
+int main(int argc, char** argv)
+{
+    int nObjects = argc > 1 ? atoi(argv[1]) : 10000;
+    int nMessages = argc > 2 ? atoi(argv[2]) : 1000;
+
+#ifdef NANOMSG
+    FairMQTransportFactory* transportFactory = new FairMQTransportFactoryNN();
+#else
+    FairMQTransportFactory* transportFactory = new FairMQTransportFactoryZMQ();
+#endif
+
+    TClonesArray digis("FairTestDetectorDigi");
+    TClonesArray hits("FairTestDetectorHit");
+    for (int i = 0; i < nObjects; ++i)
+    {
+        new (digis[i]) FairTestDetectorDigi(i % 100, i % 101, i % 102, 10. * i);
+        TVector3 pos(0.1 * i, 0.2 * i, 0.3 * i);
+        TVector3 dpos(0.01, 0.02, 0.03);
+        new (hits[i]) FairTestDetectorHit(i % 10, i, pos, dpos);
+    }
+
+    bool ok = RunBenchmark<FairTestDetectorDigi>("FairTestDetectorDigi", &digis, transportFactory, nMessages);
+    ok = RunBenchmark<FairTestDetectorHit>("FairTestDetectorHit", &hits, transportFactory, nMessages) && ok;
+
+    delete transportFactory;
+    return ok ? 0 : 1;
+}
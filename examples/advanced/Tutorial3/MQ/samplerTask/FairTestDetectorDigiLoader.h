@@ -29,6 +29,7 @@
 
 #include "FairMQSamplerTask.h"
 #include "FairMQLogger.h"
+#include "FairMQMessageStreamBuf.h"
 
 #include "baseMQtools.h"
 
@@ -41,6 +42,7 @@ class FairTestDetectorDigiLoader : public FairMQSamplerTask
     FairTestDetectorDigiLoader()
         : FairMQSamplerTask("Load class T1")
         , fDigiVector()
+        , fOutBuf()
         , fHasBoostSerialization(false)
     {
         using namespace baseMQ::tools::resolve;
@@ -73,6 +75,7 @@ class FairTestDetectorDigiLoader : public FairMQSamplerTask
   private:
     friend class boost::serialization::access;
     vector<T1> fDigiVector;
+    FairMQMessageOutBuf fOutBuf;
     bool fHasBoostSerialization;
 };
 
@@ -15,8 +15,6 @@ void FairTestDetectorDigiLoader<T1, T2>::Exec(Option_t* opt)
 
     if (fHasBoostSerialization)
     {
-        ostringstream buffer;
-        T2 OutputArchive(buffer);
         for (Int_t i = 0; i < fInput->GetEntriesFast(); ++i)
         {
             T1* digi = static_cast<T1*>(fInput->At(i));
@@ -27,10 +25,14 @@ void FairTestDetectorDigiLoader<T1, T2>::Exec(Option_t* opt)
             fDigiVector.push_back(*digi);
         }
 
-        OutputArchive << fDigiVector;
-        int size = buffer.str().length();
-        fOutput = fTransportFactory->CreateMessage(size);
-        memcpy(fOutput->GetData(), buffer.str().c_str(), size);
+        // the archive is written directly into the buffer of the message
+        {
+            ostream buffer(&fOutBuf);
+            T2 OutputArchive(buffer);
+            OutputArchive << fDigiVector;
+        }
+        fOutput = fTransportFactory->CreateMessage();
+        fOutBuf.Finish(fOutput);
 
         // delete the vector content
         if (fDigiVector.size() > 0)
@@ -29,3 +29,9 @@ FairTimeStamp* FairTestDetectorDigiRingSorter::CreateElement(FairTimeStamp* data
 {
     return new FairTestDetectorDigi(*(FairTestDetectorDigi*)data);
 }
+
+FairTimeStamp* FairTestDetectorDigiRingSorter::CopyElement(FairTimeStamp* data, FairTimeStamp* recycled)
+{
+    *static_cast<FairTestDetectorDigi*>(recycled) = *static_cast<FairTestDetectorDigi*>(data);
+    return recycled;
+}
@@ -25,10 +25,15 @@ class FairTestDetectorDigiRingSorter : public FairRingSorter
 {
   public:
     FairTestDetectorDigiRingSorter(int size = 100, double width = 10)
-        : FairRingSorter(size, width) {};
+        : FairRingSorter(size, width)
+    {
+        // FairTestDetectorDigiSorterTask copies the sorted digis into its output array
+        SetRecycleElements(kTRUE);
+    };
     virtual ~FairTestDetectorDigiRingSorter();
 
     virtual FairTimeStamp* CreateElement(FairTimeStamp* data);
+    virtual FairTimeStamp* CopyElement(FairTimeStamp* data, FairTimeStamp* recycled);
 
     ClassDef(FairTestDetectorDigiRingSorter, 1);
 };
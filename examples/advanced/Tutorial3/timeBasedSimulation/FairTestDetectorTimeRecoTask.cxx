@@ -13,9 +13,11 @@
 #include "FairTSBufferFunctional.h" // for StopTime
 #include "FairTestDetectorDigi.h"   // for FairTestDetectorDigi
 #include "FairTestDetectorHit.h"    // for FairTestDetectorHit
+#include "FairTimeSlice.h"          // for FairTimeSlice
 #include "FairLogger.h"
 
 #include "TClonesArray.h" // for TClonesArray
+#include "TObjArray.h"    // for TObjArray
 #include "TMath.h"        // for Sqrt
 #include "TVector3.h"     // for TVector3
 
@@ -117,4 +119,36 @@ void FairTestDetectorTimeRecoTask::Exec(Option_t* opt)
 }
 // -------------------------------------------------------------------------
 
+// -----   Public method ExecTimeSlice   -----------------------------------
+void FairTestDetectorTimeRecoTask::ExecTimeSlice(const FairTimeSlice& slice)
+{
+    fHitArray->Delete();
+
+    TObjArray* digis = FairRootManager::Instance()->GetTimeSliceData("FairTestDetectorSortedDigi");
+    if (!digis)
+    {
+        return;
+    }
+
+    Int_t nHits = 0;
+    for (int ipnt = 0; ipnt < digis->GetEntriesFast(); ipnt++)
+    {
+        FairTestDetectorDigi* digi = (FairTestDetectorDigi*)digis->At(ipnt);
+        if (!slice.IsInCore(digi->GetTimeStamp()))
+        {
+            continue;
+        }
+
+        TVector3 pos(digi->GetX() + 0.5, digi->GetY() + 0.5, digi->GetZ() + 0.5);
+        TVector3 dpos(1 / TMath::Sqrt(12), 1 / TMath::Sqrt(12), 1 / TMath::Sqrt(12));
+
+        FairTestDetectorHit* hit = new ((*fHitArray)[nHits++]) FairTestDetectorHit(-1, -1, pos, dpos);
+        hit->SetTimeStamp(digi->GetTimeStamp());
+        hit->SetTimeStampError(digi->GetTimeStampError());
+        hit->SetLink(digi->GetEntryNr());
+    }
+    fHitArray->Sort();
+}
+// -------------------------------------------------------------------------
+
 ClassImp(FairTestDetectorTimeRecoTask)
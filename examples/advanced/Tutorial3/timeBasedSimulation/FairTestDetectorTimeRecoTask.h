@@ -13,6 +13,7 @@
 #include "Rtypes.h" // for ClassDef
 
 class BinaryFunctor;
+class FairTimeSlice;
 class TClonesArray;
 
 class FairTestDetectorTimeRecoTask : public FairTask
@@ -31,6 +32,9 @@ class FairTestDetectorTimeRecoTask : public FairTask
     /** Virtual method Exec **/
     virtual void Exec(Option_t* opt);
 
+    /** Hits of the digis in the core of the time slice, the overlap belongs to the next slice **/
+    virtual void ExecTimeSlice(const FairTimeSlice& slice);
+
   private:
     TClonesArray* fDigiArray;
     TClonesArray* fHitArray;
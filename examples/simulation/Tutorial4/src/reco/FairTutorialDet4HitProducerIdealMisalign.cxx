@@ -65,6 +65,9 @@ void FairTutorialDet4HitProducerIdealMisalign::SetParContainers()
 InitStatus FairTutorialDet4HitProducerIdealMisalign::ReInit()
 {
 
+  // The shifts only change with a new version of the parameters
+  if ( ! ParContainersChanged() ) { return kSUCCESS; }
+
   // Get Base Container
   FairRunAna* ana = FairRunAna::Instance();
   FairRuntimeDb* rtdb=ana->GetRuntimeDb();
@@ -425,40 +425,45 @@ int FairMQChannel::SendPartAsync(const unique_ptr<FairMQMessage>& msg) const
     return fSocket->Send(msg.get(), fSndMoreFlag|fNoBlockFlag);
 }
 
-// int FairMQChannel::SendParts(initializer_list<unique_ptr<FairMQMessage>> partsList) const
-// {
-//     int totalSize = 0;
-//     initializer_list<unique_ptr<FairMQMessage>>::iterator it = partsList.end();
-//     auto &last = --it;
-//     for (auto &p : partsList)
-//     {
-//         if (&p != last)
-//         {
-//             int nbytes = SendPart(p);
-//             if (nbytes >= 0)
-//             {
-//                 totalSize += nbytes;
-//             }
-//             else
-//             {
-//                 return nbytes;
-//             }
-//         }
-//         else
-//         {
-//             int nbytes = Send(p);
-//             if (nbytes >= 0)
-//             {
-//                 totalSize += nbytes;
-//             }
-//             else
-//             {
-//                 return nbytes;
-//             }
-//         }
-//     }
-//     return totalSize;
-// }
+int64_t FairMQChannel::SendParts(const vector<unique_ptr<FairMQMessage>>& parts) const
+{
+    fPoller->Poll(fSndTimeoutInMs);
+
+    if (fPoller->CheckInput(0))
+    {
+        HandleUnblock();
+        return -2;
+    }
+
+    if (fPoller->CheckOutput(1))
+    {
+        return fSocket->Send(parts, 0);
+    }
+
+    return -2;
+}
+
+int64_t FairMQChannel::SendBatch(const vector<unique_ptr<FairMQMessage>>& msgs, size_t nMsgs) const
+{
+    int64_t totalSize = 0;
+
+    for (size_t i = 0; i < nMsgs; ++i)
+    {
+        int nbytes = fSocket->Send(msgs[i].get(), fNoBlockFlag);
+        if (nbytes == -2)
+        {
+            // queue is full, wait for it like a blocking send (this also handles the commands)
+            nbytes = Send(msgs[i]);
+        }
+        if (nbytes < 0)
+        {
+            return nbytes;
+        }
+        totalSize += nbytes;
+    }
+
+    return totalSize;
+}
 
 int FairMQChannel::Receive(const unique_ptr<FairMQMessage>& msg) const
 {
@@ -483,6 +488,67 @@ int FairMQChannel::ReceiveAsync(const unique_ptr<FairMQMessage>& msg) const
     return fSocket->Receive(msg.get(), fNoBlockFlag);
 }
 
+int64_t FairMQChannel::ReceiveParts(vector<unique_ptr<FairMQMessage>>& parts) const
+{
+    fPoller->Poll(fRcvTimeoutInMs);
+
+    if (fPoller->CheckInput(0))
+    {
+        HandleUnblock();
+        return -2;
+    }
+
+    if (fPoller->CheckInput(1))
+    {
+        return fSocket->Receive(parts, 0);
+    }
+
+    return -2;
+}
+
+int FairMQChannel::ReceiveBatch(vector<unique_ptr<FairMQMessage>>& msgs, size_t maxMsgs) const
+{
+    fPoller->Poll(fRcvTimeoutInMs);
+
+    if (fPoller->CheckInput(0))
+    {
+        HandleUnblock();
+        return -2;
+    }
+
+    if (!fPoller->CheckInput(1))
+    {
+        return -2;
+    }
+
+    return ReceiveBatchAsync(msgs, maxMsgs);
+}
+
+int FairMQChannel::ReceiveBatchAsync(vector<unique_ptr<FairMQMessage>>& msgs, size_t maxMsgs) const
+{
+    while (msgs.size() < maxMsgs)
+    {
+        msgs.push_back(unique_ptr<FairMQMessage>(fTransportFactory->CreateMessage()));
+    }
+
+    size_t nReceived = 0;
+    while (nReceived < maxMsgs)
+    {
+        int nbytes = fSocket->Receive(msgs[nReceived].get(), fNoBlockFlag);
+        if (nbytes < 0)
+        {
+            if (nbytes == -2 || nReceived > 0)
+            {
+                break;
+            }
+            return nbytes;
+        }
+        ++nReceived;
+    }
+
+    return nReceived > 0 ? nReceived : -2;
+}
+
 int FairMQChannel::Send(FairMQMessage* msg, const string& flag) const
 {
     if (flag == "")
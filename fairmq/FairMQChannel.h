@@ -16,7 +16,9 @@
 #define FAIRMQCHANNEL_H_
 
 #include <string>
+#include <vector>
 #include <memory> // unique_ptr
+#include <cstdint>
 
 #include <boost/thread/mutex.hpp>
 
@@ -130,11 +132,23 @@ class FairMQChannel
     /// @return Returns the number of bytes that have been queued. -2 If queueing was not possible. In case of errors, returns -1.
     int SendPartAsync(const std::unique_ptr<FairMQMessage>& msg) const;
 
-    // /// Sends the messages provided as arguments as a multi-part message.
-    // /// 
-    // /// @param partsList Initializer list of FairMQMessages
-    // /// @return Returns the number of bytes that have been queued. -2 If queueing was not possible. In case of errors, returns -1.
-    // int SendParts(std::initializer_list<std::unique_ptr<FairMQMessage>> partsList) const;
+    /// Sends the messages of the vector as one multi-part message.
+    /// @details The command socket is polled once for the whole message, not once per part.
+    /// nanomsg has no multi-part messages, the nanomsg transport packs the parts into one
+    /// message, which the peer has to read with ReceiveParts (Receive returns the packed buffer).
+    ///
+    /// @param parts Constant reference to a vector of unique_ptr to FairMQMessages
+    /// @return Returns the number of bytes that have been queued. -2 If queueing was not possible or timed out. In case of errors, returns -1.
+    int64_t SendParts(const std::vector<std::unique_ptr<FairMQMessage>>& parts) const;
+
+    /// Sends the first nMsgs messages of the vector as individual messages.
+    /// @details The messages are queued without blocking, the socket is only polled
+    /// (and the device can only be interrupted by a command) when the queue is full.
+    ///
+    /// @param msgs Constant reference to a vector of unique_ptr to FairMQMessages
+    /// @param nMsgs Number of messages from the front of the vector to send
+    /// @return Returns the number of bytes that have been queued. -2 If queueing was not possible or timed out. In case of errors, returns -1.
+    int64_t SendBatch(const std::vector<std::unique_ptr<FairMQMessage>>& msgs, size_t nMsgs) const;
 
     /// Receives a message from the socket queue.
     /// @details Receive method attempts to receive a message from the input queue.
@@ -153,6 +167,33 @@ class FairMQChannel
     /// In case of errors, returns -1.
     int ReceiveAsync(const std::unique_ptr<FairMQMessage>& msg) const;
 
+    /// Receives all parts of one multi-part message.
+    /// @details Blocks like Receive(), the parts are appended to the vector.
+    /// With the nanomsg transport only messages sent with SendParts can be received, others fail with -1.
+    ///
+    /// @param parts Reference to a vector of unique_ptr to FairMQMessages
+    /// @return Returns the number of bytes that have been received. -2 If reading from the queue was not possible or timed out. In case of errors, returns -1.
+    int64_t ReceiveParts(std::vector<std::unique_ptr<FairMQMessage>>& parts) const;
+
+    /// Receives up to maxMsgs individual messages with a single poll.
+    /// @details Blocks like Receive() until the first message is available, then drains the
+    /// input queue without blocking. Missing message objects are added to the vector, so the
+    /// same vector can be reused in the next call. Only the first messages (the returned count) hold data.
+    ///
+    /// @param msgs Reference to a vector of unique_ptr to FairMQMessages
+    /// @param maxMsgs Maximum number of messages to receive
+    /// @return Returns the number of received messages. -2 If reading from the queue was not possible or timed out. In case of errors, returns -1.
+    int ReceiveBatch(std::vector<std::unique_ptr<FairMQMessage>>& msgs, size_t maxMsgs) const;
+
+    /// Receives up to maxMsgs individual messages without polling and without blocking.
+    /// @details For devices which have polled the channel already, e.g. with their own poller
+    /// over several channels. The vector is handled like in ReceiveBatch().
+    ///
+    /// @param msgs Reference to a vector of unique_ptr to FairMQMessages
+    /// @param maxMsgs Maximum number of messages to receive
+    /// @return Returns the number of received messages. If the queue is empty, returns -2. In case of errors, returns -1.
+    int ReceiveBatchAsync(std::vector<std::unique_ptr<FairMQMessage>>& msgs, size_t maxMsgs) const;
+
     // DEPRECATED socket method wrappers with raw pointers and flag checks
     int Send(FairMQMessage* msg, const std::string& flag = "") const;
     int Send(FairMQMessage* msg, const int flags) const;
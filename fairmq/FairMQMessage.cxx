@@ -11,3 +11,13 @@
  * @since 2012-12-05
  * @author D. Klein, A. Rybalchenko
  */
+
+#include "FairMQMessage.h"
+#include "FairMQMessagePool.h"
+
+void FairMQMessage::RebuildPooled(size_t size)
+{
+    void* hint = NULL;
+    void* data = FairMQMessagePool::Instance().Allocate(size, hint);
+    Rebuild(data, size, &FairMQMessagePool::Release, hint);
+}
@@ -26,6 +26,8 @@ class FairMQMessage
     virtual void Rebuild() = 0;
     virtual void Rebuild(size_t size) = 0;
     virtual void Rebuild(void* data, size_t size, fairmq_free_fn *ffn = NULL, void* hint = NULL) = 0;
+    /// Rebuild with a buffer of the given size taken from FairMQMessagePool instead of the heap
+    virtual void RebuildPooled(size_t size);
 
     virtual void* GetMessage() = 0;
     virtual void* GetData() = 0;
@@ -0,0 +1,115 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQMessagePool.cxx
+ */
+
+#include <cstdlib>
+
+#include "FairMQMessagePool.h"
+#include "FairMQLogger.h"
+
+using namespace std;
+
+FairMQMessagePool& FairMQMessagePool::Instance()
+{
+    static FairMQMessagePool* pool = new FairMQMessagePool();
+    return *pool;
+}
+
+FairMQMessagePool::FairMQMessagePool()
+    : fClasses()
+    , fMaxCached(256)
+    , fNAllocated(0)
+    , fNReused(0)
+{
+    for (int i = 0; i <= kMaxClass - kMinClass; ++i)
+    {
+        fClasses[i].fSize = static_cast<size_t>(1) << (kMinClass + i);
+        fClasses[i].fPool = this;
+    }
+}
+
+void* FairMQMessagePool::Allocate(size_t size, void*& hint)
+{
+    int iClass = 0;
+    while (iClass <= kMaxClass - kMinClass && fClasses[iClass].fSize < size)
+    {
+        ++iClass;
+    }
+
+    if (iClass > kMaxClass - kMinClass)
+    {
+        hint = NULL;
+        ++fNAllocated;
+        return malloc(size);
+    }
+
+    SizeClass& sizeClass = fClasses[iClass];
+    hint = &sizeClass;
+    {
+        lock_guard<mutex> lock(sizeClass.fMutex);
+        if (!sizeClass.fFree.empty())
+        {
+            void* data = sizeClass.fFree.back();
+            sizeClass.fFree.pop_back();
+            ++fNReused;
+            return data;
+        }
+    }
+
+    void* data = malloc(sizeClass.fSize);
+    if (!data)
+    {
+        LOG(ERROR) << "FairMQMessagePool: failed allocating buffer of " << sizeClass.fSize << " bytes";
+    }
+    ++fNAllocated;
+    return data;
+}
+
+void FairMQMessagePool::Release(void* data, void* hint)
+{
+    if (!hint)
+    {
+        free(data);
+        return;
+    }
+
+    SizeClass* sizeClass = static_cast<SizeClass*>(hint);
+    sizeClass->fPool->Push(*sizeClass, data);
+}
+
+void FairMQMessagePool::Push(SizeClass& sizeClass, void* data)
+{
+    if (!data)
+    {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(sizeClass.fMutex);
+        if (sizeClass.fFree.size() < fMaxCached)
+        {
+            sizeClass.fFree.push_back(data);
+            return;
+        }
+    }
+
+    free(data);
+}
+
+FairMQMessagePool::~FairMQMessagePool()
+{
+    for (int i = 0; i <= kMaxClass - kMinClass; ++i)
+    {
+        for (size_t j = 0; j < fClasses[i].fFree.size(); ++j)
+        {
+            free(fClasses[i].fFree[j]);
+        }
+    }
+}
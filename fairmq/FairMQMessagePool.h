@@ -0,0 +1,73 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQMessagePool.h
+ *
+ * Process wide pool of message buffers, sorted in power of two size classes.
+ * Buffers are handed to the transport together with FairMQMessagePool::Release
+ * as the free function, so they come back to the pool once the transport is done
+ * with them instead of being returned to the heap.
+ */
+
+#ifndef FAIRMQMESSAGEPOOL_H_
+#define FAIRMQMESSAGEPOOL_H_
+
+#include <cstddef> // for size_t
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+class FairMQMessagePool
+{
+  public:
+    /// The pool is never destroyed, buffers may be released by transport threads after the device is gone.
+    static FairMQMessagePool& Instance();
+
+    /// Returns a buffer of at least size bytes, hint has to be passed to Release together with the buffer.
+    void* Allocate(size_t size, void*& hint);
+    /// Free function to be given to FairMQTransportFactory::CreateMessage/FairMQMessage::Rebuild.
+    static void Release(void* data, void* hint);
+
+    /// Maximum number of idle buffers kept per size class.
+    void SetMaxCached(size_t maxCached) { fMaxCached = maxCached; }
+    size_t GetMaxCached() const { return fMaxCached; }
+
+    /// Number of buffers taken from the heap and number of buffers served from the pool.
+    unsigned long GetNAllocated() const { return fNAllocated; }
+    unsigned long GetNReused() const { return fNReused; }
+
+  private:
+    static const int kMinClass = 6;   // 64 B
+    static const int kMaxClass = 27;  // 128 MB, larger buffers are not pooled
+
+    struct SizeClass
+    {
+        SizeClass() : fSize(0), fPool(NULL), fMutex(), fFree() {}
+
+        size_t fSize;
+        FairMQMessagePool* fPool;
+        std::mutex fMutex;
+        std::vector<void*> fFree;
+    };
+
+    FairMQMessagePool();
+    ~FairMQMessagePool();
+
+    void Push(SizeClass& sizeClass, void* data);
+
+    SizeClass fClasses[kMaxClass - kMinClass + 1];
+    std::atomic<size_t> fMaxCached;
+    std::atomic<unsigned long> fNAllocated;
+    std::atomic<unsigned long> fNReused;
+
+    /// Copy Constructor
+    FairMQMessagePool(const FairMQMessagePool&);
+    FairMQMessagePool operator=(const FairMQMessagePool&);
+};
+
+#endif /* FAIRMQMESSAGEPOOL_H_ */
@@ -0,0 +1,117 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQMessageStreamBuf.cxx
+ */
+
+#include <cstring>
+
+#include "FairMQMessageStreamBuf.h"
+#include "FairMQMessagePool.h"
+
+using namespace std;
+
+FairMQMessageOutBuf::FairMQMessageOutBuf(size_t initialSize)
+    : fData(NULL)
+    , fHint(NULL)
+    , fCapacity(0)
+    , fNextSize(initialSize)
+{
+}
+
+FairMQMessageOutBuf::~FairMQMessageOutBuf()
+{
+    if (fData)
+    {
+        FairMQMessagePool::Release(fData, fHint);
+    }
+}
+
+void FairMQMessageOutBuf::Finish(FairMQMessage* msg)
+{
+    size_t size = GetSize();
+    if (!fData)
+    {
+        msg->Rebuild(size);
+        return;
+    }
+
+    msg->Rebuild(fData, size, &FairMQMessagePool::Release, fHint);
+    if (size > fNextSize)
+    {
+        fNextSize = size;
+    }
+    fData = NULL;
+    fHint = NULL;
+    fCapacity = 0;
+    setp(NULL, NULL);
+}
+
+void FairMQMessageOutBuf::Reset()
+{
+    setp(fData, fData + fCapacity);
+}
+
+void FairMQMessageOutBuf::Grow(size_t minSize)
+{
+    size_t capacity = fCapacity > 0 ? 2 * fCapacity : fNextSize;
+    while (capacity < minSize)
+    {
+        capacity *= 2;
+    }
+
+    void* hint = NULL;
+    char* data = static_cast<char*>(FairMQMessagePool::Instance().Allocate(capacity, hint));
+    size_t size = GetSize();
+    if (fData)
+    {
+        memcpy(data, fData, size);
+        FairMQMessagePool::Release(fData, fHint);
+    }
+
+    fData = data;
+    fHint = hint;
+    fCapacity = capacity;
+    setp(fData, fData + fCapacity);
+    pbump(static_cast<int>(size));
+}
+
+FairMQMessageOutBuf::int_type FairMQMessageOutBuf::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        return traits_type::not_eof(c);
+    }
+    Grow(GetSize() + 1);
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+streamsize FairMQMessageOutBuf::xsputn(const char* s, streamsize n)
+{
+    if (epptr() - pptr() < n)
+    {
+        Grow(GetSize() + n);
+    }
+    memcpy(pptr(), s, n);
+    pbump(static_cast<int>(n));
+    return n;
+}
+
+streamsize FairMQMessageInBuf::xsgetn(char* s, streamsize n)
+{
+    streamsize available = egptr() - gptr();
+    if (n > available)
+    {
+        n = available;
+    }
+    memcpy(s, gptr(), n);
+    gbump(static_cast<int>(n));
+    return n;
+}
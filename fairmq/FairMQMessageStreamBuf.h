@@ -0,0 +1,81 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQMessageStreamBuf.h
+ *
+ * Stream buffers to serialize directly into and out of FairMQMessages.
+ *
+ * FairMQMessageOutBuf writes into a growing buffer of the FairMQMessagePool, Finish()
+ * hands the buffer over to a message (Rebuild with FairMQMessagePool::Release as free
+ * function), so the serialized data is not copied again. The next buffer starts with
+ * the size of the last message.
+ *
+ * FairMQMessageInBuf reads the data of a message in place.
+ */
+
+#ifndef FAIRMQMESSAGESTREAMBUF_H_
+#define FAIRMQMESSAGESTREAMBUF_H_
+
+#include <cstddef> // for size_t
+#include <streambuf>
+
+#include "FairMQMessage.h"
+
+class FairMQMessageOutBuf : public std::streambuf
+{
+  public:
+    explicit FairMQMessageOutBuf(size_t initialSize = 4096);
+    virtual ~FairMQMessageOutBuf();
+
+    /// Rebuilds msg with the data written so far, the buffer is empty afterwards
+    void Finish(FairMQMessage* msg);
+    /// Drops the data written so far
+    void Reset();
+    size_t GetSize() const { return pptr() - pbase(); }
+
+  protected:
+    virtual int_type overflow(int_type c);
+    virtual std::streamsize xsputn(const char* s, std::streamsize n);
+
+  private:
+    /// Moves the data to a buffer of at least minSize bytes
+    void Grow(size_t minSize);
+
+    char* fData;
+    void* fHint;
+    size_t fCapacity;
+    size_t fNextSize; // capacity of the next buffer
+
+    /// Copy Constructor
+    FairMQMessageOutBuf(const FairMQMessageOutBuf&);
+    FairMQMessageOutBuf operator=(const FairMQMessageOutBuf&);
+};
+
+class FairMQMessageInBuf : public std::streambuf
+{
+  public:
+    FairMQMessageInBuf() {}
+    explicit FairMQMessageInBuf(FairMQMessage* msg) { SetMessage(msg); }
+
+    /// Reads the data of msg, which has to stay alive while it is read
+    void SetMessage(FairMQMessage* msg)
+    {
+        char* data = static_cast<char*>(msg->GetData());
+        setg(data, data, data + msg->GetSize());
+    }
+
+  protected:
+    virtual std::streamsize xsgetn(char* s, std::streamsize n);
+
+  private:
+    /// Copy Constructor
+    FairMQMessageInBuf(const FairMQMessageInBuf&);
+    FairMQMessageInBuf operator=(const FairMQMessageInBuf&);
+};
+
+#endif /* FAIRMQMESSAGESTREAMBUF_H_ */
@@ -16,6 +16,9 @@
 #define FAIRMQSOCKET_H_
 
 #include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
 
 #include "FairMQMessage.h"
 
@@ -41,6 +44,12 @@ class FairMQSocket
     virtual int Send(FairMQMessage* msg, const int flags = 0) = 0;
     virtual int Receive(FairMQMessage* msg, const std::string& flag = "") = 0;
     virtual int Receive(FairMQMessage* msg, const int flags = 0) = 0;
+    /// Sends all messages of msgVec as the parts of one multi-part message.
+    /// With a non-blocking flag -2 is returned only if no part has been sent
+    virtual int64_t Send(const std::vector<std::unique_ptr<FairMQMessage>>& msgVec, const int flags = 0) = 0;
+    /// Receives all parts of one multi-part message and appends them to msgVec,
+    /// msgVec is left unchanged on failure
+    virtual int64_t Receive(std::vector<std::unique_ptr<FairMQMessage>>& msgVec, const int flags = 0) = 0;
 
     virtual void* GetSocket() const = 0;
     virtual int GetSocket(int nothing) const = 0;
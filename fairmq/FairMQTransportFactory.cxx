@@ -11,3 +11,48 @@
  * @since 2014-01-20
  * @author: A. Rybalchenko
  */
+
+#include "FairMQTransportFactory.h"
+#include "FairMQMessagePool.h"
+#include "FairMQTransportFactoryZMQ.h"
+#include "FairMQTransportFactorySHM.h"
+#ifdef NANOMSG
+#include "FairMQTransportFactoryNN.h"
+#endif
+
+FairMQMessage* FairMQTransportFactory::CreatePooledMessage(size_t size)
+{
+    void* hint = NULL;
+    void* data = FairMQMessagePool::Instance().Allocate(size, hint);
+    return CreateMessage(data, size, &FairMQMessagePool::Release, hint);
+}
+
+FairMQTransportFactory* FairMQTransportFactory::CreateTransportFactory(const std::string& transport)
+{
+    if (transport == "zeromq")
+    {
+        return new FairMQTransportFactoryZMQ();
+    }
+    if (transport == "shmem")
+    {
+        return new FairMQTransportFactorySHM();
+    }
+#ifdef NANOMSG
+    if (transport == "nanomsg" || transport == "")
+    {
+        return new FairMQTransportFactoryNN();
+    }
+#else
+    if (transport == "")
+    {
+        return new FairMQTransportFactoryZMQ();
+    }
+#endif
+
+    LOG(ERROR) << "Unknown transport '" << transport << "', available: zeromq"
+#ifdef NANOMSG
+               << ", nanomsg"
+#endif
+               << ", shmem";
+    return NULL;
+}
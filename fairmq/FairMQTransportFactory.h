@@ -33,6 +33,8 @@ class FairMQTransportFactory
     virtual FairMQMessage* CreateMessage() = 0;
     virtual FairMQMessage* CreateMessage(size_t size) = 0;
     virtual FairMQMessage* CreateMessage(void* data, size_t size, fairmq_free_fn *ffn = NULL, void* hint = NULL) = 0;
+    /// Message with a buffer of the given size from FairMQMessagePool, the buffer returns to the pool when the transport releases it
+    virtual FairMQMessage* CreatePooledMessage(size_t size);
 
     virtual FairMQSocket* CreateSocket(const std::string& type, const std::string& name, int numIoThreads) = 0;
 
@@ -41,6 +43,10 @@ class FairMQTransportFactory
     virtual FairMQPoller* CreatePoller(FairMQSocket& cmdSocket, FairMQSocket& dataSocket) = 0;
 
     virtual ~FairMQTransportFactory() {};
+
+    /// Creates the factory of the given transport: "zeromq", "nanomsg" (if FairMQ was built with nanomsg) or "shmem".
+    /// An empty string selects the default transport of the build. Returns NULL for unknown transports.
+    static FairMQTransportFactory* CreateTransportFactory(const std::string& transport);
 };
 
 #endif /* FAIRMQTRANSPORTFACTORY_H_ */
@@ -37,16 +37,16 @@ void FairMQBenchmarkSampler::Run()
 {
     boost::thread resetEventCounter(boost::bind(&FairMQBenchmarkSampler::ResetEventCounter, this));
 
-    void* buffer = operator new[](fEventSize);
-
-    unique_ptr<FairMQMessage> baseMsg(fTransportFactory->CreateMessage(buffer, fEventSize));
+    unique_ptr<FairMQMessage> baseMsg(fTransportFactory->CreatePooledMessage(fEventSize));
 
     // store the channel reference to avoid traversing the map on every loop iteration
     const FairMQChannel& dataChannel = fChannels.at("data-out").at(0);
 
+    // the message object is reused, every copy shares the buffer of baseMsg
+    unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
+
     while (CheckCurrentState(RUNNING))
     {
-        unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
         msg->Copy(baseMsg);
 
         dataChannel.Send(msg);
@@ -30,10 +30,11 @@ void FairMQBuffer::Run()
     const FairMQChannel& dataInChannel = fChannels.at("data-in").at(0);
     const FairMQChannel& dataOutChannel = fChannels.at("data-out").at(0);
 
+    // the message object is reused, every receive replaces its content
+    std::unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
+
     while (CheckCurrentState(RUNNING))
     {
-        std::unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
-
         if (dataInChannel.Receive(msg) > 0)
         {
             dataOutChannel.Send(msg);
@@ -41,10 +41,12 @@ void FairMQMerger::Run()
 
     int numInputs = fChannels.at("data-in").size();
 
+    // messages are received and forwarded in batches, the message objects are reused
+    const size_t maxBatchSize = 64;
+    std::vector<std::unique_ptr<FairMQMessage>> batch;
+
     while (CheckCurrentState(RUNNING))
     {
-        std::unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
-
         poller->Poll(100);
 
         // Loop over the data input channels.
@@ -53,19 +55,20 @@ void FairMQMerger::Run()
             // Check if the channel has data ready to be received.
             if (poller->CheckInput(i))
             {
-                // Try receiving the data.
-                if (dataInChannels[i]->Receive(msg) > 0)
+                // Drain up to maxBatchSize messages from the channel, it has been polled above.
+                int numReceived = dataInChannels[i]->ReceiveBatchAsync(batch, maxBatchSize);
+                if (numReceived > 0)
                 {
                     // If data was received, send it to output.
-                    if (dataOutChannel.Send(msg) < 0)
+                    if (dataOutChannel.SendBatch(batch, numReceived) < 0)
                     {
                         LOG(DEBUG) << "Blocking send interrupted by a command";
                         break;
                     }
                 }
-                else
+                else if (numReceived == -1)
                 {
-                    LOG(DEBUG) << "Blocking receive interrupted by a command";
+                    LOG(DEBUG) << "Receive failed";
                     break;
                 }
             }
@@ -27,10 +27,11 @@ void FairMQSink::Run()
     // store the channel reference to avoid traversing the map on every loop iteration
     const FairMQChannel& dataChannel = fChannels.at("data-in").at(0);
 
+    // the message object is reused, every receive replaces its content
+    std::unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
+
     while (CheckCurrentState(RUNNING))
     {
-        std::unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
-
         dataChannel.Receive(msg);
     }
 }
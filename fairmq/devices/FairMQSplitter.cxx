@@ -39,13 +39,21 @@ void FairMQSplitter::Run()
         dataOutChannels[i] = &(fChannels.at("data-out").at(i));
     }
 
+    // messages are received in batches, the message objects are reused
+    const size_t maxBatchSize = 64;
+    std::vector<std::unique_ptr<FairMQMessage>> batch;
+
     while (CheckCurrentState(RUNNING))
     {
-        std::unique_ptr<FairMQMessage> msg(fTransportFactory->CreateMessage());
+        int numReceived = dataInChannel.ReceiveBatch(batch, maxBatchSize);
 
-        if (dataInChannel.Receive(msg) > 0)
+        for (int i = 0; i < numReceived; ++i)
         {
-            dataOutChannels[direction]->Send(msg);
+            // queue without blocking, poll the output only if its queue is full
+            if (dataOutChannels[direction]->SendAsync(batch[i]) == -2)
+            {
+                dataOutChannels[direction]->Send(batch[i]);
+            }
             ++direction;
             if (direction >= numOutputs)
             {
@@ -116,6 +116,12 @@ void FairMQMessageNN::Rebuild(void* data, size_t size, fairmq_free_fn *ffn, void
     }
 }
 
+void FairMQMessageNN::RebuildPooled(size_t size)
+{
+    // see FairMQTransportFactoryNN::CreatePooledMessage
+    Rebuild(size);
+}
+
 void* FairMQMessageNN::GetMessage()
 {
     return fMessage;
@@ -183,6 +189,11 @@ void FairMQMessageNN::Copy(const unique_ptr<FairMQMessage>& msg)
 
 inline void FairMQMessageNN::Clear()
 {
+    if (!fMessage)
+    {
+        fSize = 0;
+        return;
+    }
     if (nn_freemsg(fMessage) < 0)
     {
         LOG(ERROR) << "failed freeing message, reason: " << nn_strerror(errno);
@@ -196,7 +207,8 @@ inline void FairMQMessageNN::Clear()
 
 FairMQMessageNN::~FairMQMessageNN()
 {
-    if (fReceiving)
+    // a sent buffer belongs to nanomsg and is not referenced anymore, all others are ours
+    if (fMessage)
     {
         int rc = nn_freemsg(fMessage);
         if (rc < 0)
@@ -29,6 +29,7 @@ class FairMQMessageNN : public FairMQMessage
     virtual void Rebuild();
     virtual void Rebuild(size_t size);
     virtual void Rebuild(void* data, size_t size, fairmq_free_fn *ffn = NULL, void* hint = NULL);
+    virtual void RebuildPooled(size_t size);
 
     virtual void* GetMessage();
     virtual void* GetData();
@@ -13,6 +13,7 @@
  */
 
 #include <sstream>
+#include <cstring>
 
 #include "FairMQSocketNN.h"
 #include "FairMQMessageNN.h"
@@ -102,7 +103,10 @@ int FairMQSocketNN::Send(FairMQMessage* msg, const string& flag)
     {
         fBytesTx += nbytes;
         ++fMessagesTx;
+        // the buffer belongs to nanomsg now, the message object can be reused for the next receive
         static_cast<FairMQMessageNN*>(msg)->fReceiving = false;
+        static_cast<FairMQMessageNN*>(msg)->fMessage = NULL;
+        static_cast<FairMQMessageNN*>(msg)->fSize = 0;
         return nbytes;
     }
     if (nn_errno() == EAGAIN)
@@ -126,7 +130,10 @@ int FairMQSocketNN::Send(FairMQMessage* msg, const int flags)
     {
         fBytesTx += nbytes;
         ++fMessagesTx;
+        // the buffer belongs to nanomsg now, the message object can be reused for the next receive
         static_cast<FairMQMessageNN*>(msg)->fReceiving = false;
+        static_cast<FairMQMessageNN*>(msg)->fMessage = NULL;
+        static_cast<FairMQMessageNN*>(msg)->fSize = 0;
         return nbytes;
     }
     if (nn_errno() == EAGAIN)
@@ -193,6 +200,126 @@ int FairMQSocketNN::Receive(FairMQMessage* msg, const int flags)
     return nbytes;
 }
 
+/* nanomsg has no multi-part messages. The parts are packed into one nanomsg message:
+ * a marker, the number of parts, the size of every part and then the part buffers,
+ * all header words as uint64_t. Such a message can only be read with the multi-part
+ * Receive, a peer receiving single messages gets the packed buffer. The marker lets
+ * the multi-part Receive reject single messages.
+ */
+namespace
+{
+const uint64_t kMultiPartMarker = 0x5354524150514d46ULL; // "FMQPARTS"
+}
+
+int64_t FairMQSocketNN::Send(const vector<unique_ptr<FairMQMessage>>& msgVec, const int flags)
+{
+    const unsigned int vecSize = msgVec.size();
+    size_t headerSize = (vecSize + 2) * sizeof(uint64_t);
+    size_t totalSize = 0;
+    for (unsigned int i = 0; i < vecSize; ++i)
+    {
+        totalSize += msgVec[i]->GetSize();
+    }
+
+    void* ptr = nn_allocmsg(headerSize + totalSize, 0);
+    if (!ptr)
+    {
+        LOG(ERROR) << "failed allocating message, reason: " << nn_strerror(errno);
+        return -1;
+    }
+
+    uint64_t* header = static_cast<uint64_t*>(ptr);
+    char* data = static_cast<char*>(ptr) + headerSize;
+    header[0] = kMultiPartMarker;
+    header[1] = vecSize;
+    for (unsigned int i = 0; i < vecSize; ++i)
+    {
+        size_t size = msgVec[i]->GetSize();
+        header[i + 2] = size;
+        memcpy(data, msgVec[i]->GetData(), size);
+        data += size;
+    }
+
+    int nbytes = nn_send(fSocket, &ptr, NN_MSG, flags);
+    if (nbytes >= 0)
+    {
+        fBytesTx += totalSize;
+        ++fMessagesTx;
+        return totalSize;
+    }
+    nn_freemsg(ptr);
+    if (nn_errno() == EAGAIN)
+    {
+        return -2;
+    }
+    if (nn_errno() == ETERM)
+    {
+        LOG(INFO) << "terminating socket " << fId;
+        return -1;
+    }
+    LOG(ERROR) << "Failed sending on socket " << fId << ", reason: " << nn_strerror(errno);
+    return nbytes;
+}
+
+int64_t FairMQSocketNN::Receive(vector<unique_ptr<FairMQMessage>>& msgVec, const int flags)
+{
+    void* ptr = NULL;
+    int nbytes = nn_recv(fSocket, &ptr, NN_MSG, flags);
+    if (nbytes < 0)
+    {
+        if (nn_errno() == EAGAIN)
+        {
+            return -2;
+        }
+        if (nn_errno() == ETERM)
+        {
+            LOG(INFO) << "terminating socket " << fId;
+            return -1;
+        }
+        LOG(ERROR) << "Failed receiving on socket " << fId << ", reason: " << nn_strerror(errno);
+        return nbytes;
+    }
+
+    size_t received = nbytes;
+    const uint64_t* header = static_cast<const uint64_t*>(ptr);
+    bool marked = (received >= 2 * sizeof(uint64_t)) && header[0] == kMultiPartMarker;
+    uint64_t vecSize = marked ? header[1] : 0;
+    size_t headerSize = (vecSize + 2) * sizeof(uint64_t);
+    if (vecSize == 0 || vecSize > received / sizeof(uint64_t) || headerSize > received)
+    {
+        LOG(ERROR) << "Received message on socket " << fId << " is not a multi-part message";
+        nn_freemsg(ptr);
+        return -1;
+    }
+
+    const char* data = static_cast<const char*>(ptr) + headerSize;
+    size_t left = received - headerSize;
+    int64_t totalSize = 0;
+    const size_t initialSize = msgVec.size();
+    for (uint64_t i = 0; i < vecSize; ++i)
+    {
+        size_t size = header[i + 2];
+        if (size > left)
+        {
+            LOG(ERROR) << "Received multi-part message on socket " << fId << " is truncated";
+            msgVec.resize(initialSize);
+            nn_freemsg(ptr);
+            return -1;
+        }
+        unique_ptr<FairMQMessage> part(new FairMQMessageNN(size));
+        memcpy(part->GetData(), data, size);
+        msgVec.push_back(move(part));
+        data += size;
+        left -= size;
+        totalSize += size;
+    }
+    nn_freemsg(ptr);
+
+    fBytesRx += totalSize;
+    ++fMessagesRx;
+    return totalSize;
+}
+
 void FairMQSocketNN::Close()
 {
     nn_close(fSocket);
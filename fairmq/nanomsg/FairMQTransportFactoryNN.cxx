@@ -36,6 +36,13 @@ FairMQMessage* FairMQTransportFactoryNN::CreateMessage(void* data, size_t size,
     return new FairMQMessageNN(data, size, ffn, hint);
 }
 
+FairMQMessage* FairMQTransportFactoryNN::CreatePooledMessage(size_t size)
+{
+    // nanomsg takes over the buffers allocated with nn_allocmsg on send and cannot
+    // send foreign buffers without a copy, the pool would only add a memcpy here.
+    return new FairMQMessageNN(size);
+}
+
 FairMQSocket* FairMQTransportFactoryNN::CreateSocket(const string& type, const std::string& name, int numIoThreads)
 {
     return new FairMQSocketNN(type, name, numIoThreads);
@@ -30,6 +30,7 @@ class FairMQTransportFactoryNN : public FairMQTransportFactory
     virtual FairMQMessage* CreateMessage();
     virtual FairMQMessage* CreateMessage(size_t size);
     virtual FairMQMessage* CreateMessage(void* data, size_t size, fairmq_free_fn *ffn = NULL, void* hint = NULL);
+    virtual FairMQMessage* CreatePooledMessage(size_t size);
 
     virtual FairMQSocket* CreateSocket(const std::string& type, const std::string& name, int numIoThreads);
 
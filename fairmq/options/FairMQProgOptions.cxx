@@ -130,17 +130,20 @@ void FairMQProgOptions::InitOptionDescription()
     {
         fMQOptionsInCmd.add_options()
             ("id",             po::value<string>(),                       "Device ID (required argument).")
-            ("io-threads",     po::value<int>()->default_value(1),        "Number of I/O threads.");
+            ("io-threads",     po::value<int>()->default_value(1),        "Number of I/O threads.")
+            ("transport",      po::value<string>()->default_value(""),    "Transport (zeromq/nanomsg/shmem), empty for the default of the build.");
 
         fMQOptionsInCfg.add_options()
             ("id",             po::value<string>()->required(),           "Device ID (required argument).")
-            ("io-threads",     po::value<int>()->default_value(1),        "Number of I/O threads.");
+            ("io-threads",     po::value<int>()->default_value(1),        "Number of I/O threads.")
+            ("transport",      po::value<string>()->default_value(""),    "Transport (zeromq/nanomsg/shmem), empty for the default of the build.");
     }
     else
     {
         fMQOptionsInCmd.add_options()
             ("id",             po::value<string>()->required(),           "Device ID (required argument)")
-            ("io-threads",     po::value<int>()->default_value(1),        "Number of I/O threads");
+            ("io-threads",     po::value<int>()->default_value(1),        "Number of I/O threads")
+            ("transport",      po::value<string>()->default_value(""),    "Transport (zeromq/nanomsg/shmem), empty for the default of the build");
     }
 
     fMQParserOptions.add_options()
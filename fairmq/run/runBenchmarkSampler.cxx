@@ -22,11 +22,7 @@
 #include "FairMQProgOptions.h"
 #include "FairMQBenchmarkSampler.h"
 
-#ifdef NANOMSG
-#include "FairMQTransportFactoryNN.h"
-#else
-#include "FairMQTransportFactoryZMQ.h"
-#endif
+#include "FairMQTransportFactory.h"
 
 using namespace std;
 using namespace FairMQParser;
@@ -65,11 +61,12 @@ int main(int argc, char** argv)
 
         LOG(INFO) << "PID: " << getpid();
 
-#ifdef NANOMSG
-        sampler.SetTransport(new FairMQTransportFactoryNN());
-#else
-        sampler.SetTransport(new FairMQTransportFactoryZMQ());
-#endif
+        FairMQTransportFactory* transportFactory = FairMQTransportFactory::CreateTransportFactory(config.GetValue<string>("transport"));
+        if (!transportFactory)
+        {
+            return 1;
+        }
+        sampler.SetTransport(transportFactory);
 
         sampler.SetProperty(FairMQBenchmarkSampler::Id, id);
         sampler.SetProperty(FairMQBenchmarkSampler::EventSize, eventSize);
@@ -21,11 +21,7 @@
 #include "FairMQProgOptions.h"
 #include "FairMQSink.h"
 
-#ifdef NANOMSG
-#include "FairMQTransportFactoryNN.h"
-#else
-#include "FairMQTransportFactoryZMQ.h"
-#endif
+#include "FairMQTransportFactory.h"
 
 using namespace std;
 using namespace FairMQParser;
@@ -55,11 +51,11 @@ int main(int argc, char** argv)
 
         LOG(INFO) << "PID: " << getpid();
 
-#ifdef NANOMSG
-        FairMQTransportFactory* transportFactory = new FairMQTransportFactoryNN();
-#else
-        FairMQTransportFactory* transportFactory = new FairMQTransportFactoryZMQ();
-#endif
+        FairMQTransportFactory* transportFactory = FairMQTransportFactory::CreateTransportFactory(config.GetValue<string>("transport"));
+        if (!transportFactory)
+        {
+            return 1;
+        }
 
         sink.SetTransport(transportFactory);
 
@@ -0,0 +1,168 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQMessageSHM.cxx
+ */
+
+#include <cstring>
+#include <cstdlib>
+
+#include "FairMQMessageSHM.h"
+#include "FairMQLogger.h"
+
+using namespace std;
+
+FairMQMessageSHM::FairMQMessageSHM()
+    : fBlock(NULL)
+{
+}
+
+FairMQMessageSHM::FairMQMessageSHM(size_t size)
+    : fBlock(NULL)
+{
+    Allocate(size);
+}
+
+/* A buffer outside of the segment cannot be shared with another process,
+ * it is copied into the segment and released right away.
+ * For zero copy create the message with the size and fill it directly.
+ */
+FairMQMessageSHM::FairMQMessageSHM(void* data, size_t size, fairmq_free_fn *ffn, void* hint)
+    : fBlock(NULL)
+{
+    AllocateCopy(data, size, ffn, hint);
+}
+
+void FairMQMessageSHM::Rebuild()
+{
+    CloseMessage();
+}
+
+void FairMQMessageSHM::Rebuild(size_t size)
+{
+    CloseMessage();
+    Allocate(size);
+}
+
+void FairMQMessageSHM::Rebuild(void* data, size_t size, fairmq_free_fn *ffn, void* hint)
+{
+    CloseMessage();
+    AllocateCopy(data, size, ffn, hint);
+}
+
+void FairMQMessageSHM::RebuildPooled(size_t size)
+{
+    // the segment allocator already recycles the payload memory
+    Rebuild(size);
+}
+
+void* FairMQMessageSHM::GetMessage()
+{
+    return fBlock;
+}
+
+void* FairMQMessageSHM::GetData()
+{
+    return fBlock ? fBlock->GetData() : NULL;
+}
+
+size_t FairMQMessageSHM::GetSize()
+{
+    return fBlock ? fBlock->fSize : 0;
+}
+
+void FairMQMessageSHM::SetMessage(void* data, size_t size)
+{
+    // dummy method to comply with the interface. functionality not allowed in shared memory transport.
+}
+
+void FairMQMessageSHM::CloseMessage()
+{
+    if (fBlock)
+    {
+        FairMQShmManager::Instance().Release(fBlock);
+        fBlock = NULL;
+    }
+}
+
+void FairMQMessageSHM::Copy(FairMQMessage* msg)
+{
+    // DEPRECATED: Use Copy(const unique_ptr<FairMQMessage>&)
+
+    // Shares the payload between msg and this message.
+    FairMQShmBlock* block = static_cast<FairMQShmBlock*>(msg->GetMessage());
+    if (block)
+    {
+        FairMQShmManager::Instance().AddRef(block);
+    }
+    CloseMessage();
+    fBlock = block;
+}
+
+void FairMQMessageSHM::Copy(const unique_ptr<FairMQMessage>& msg)
+{
+    Copy(msg.get());
+}
+
+void FairMQMessageSHM::Allocate(size_t size)
+{
+    fBlock = FairMQShmManager::Instance().Allocate(size);
+}
+
+void FairMQMessageSHM::AllocateCopy(void* data, size_t size, fairmq_free_fn *ffn, void* hint)
+{
+    Allocate(size);
+    if (fBlock)
+    {
+        memcpy(fBlock->GetData(), data, size);
+    }
+
+    if (ffn)
+    {
+        ffn(data, hint);
+    }
+    else
+    {
+        if (data) free(data);
+    }
+}
+
+FairMQShmDescriptor FairMQMessageSHM::GetDescriptor() const
+{
+    FairMQShmDescriptor desc;
+    if (fBlock)
+    {
+        desc.fHandle = FairMQShmManager::Instance().GetHandle(fBlock);
+        desc.fSize = fBlock->fSize;
+    }
+    else
+    {
+        desc.fHandle = FairMQShmManager::kNoHandle;
+        desc.fSize = 0;
+    }
+    return desc;
+}
+
+void FairMQMessageSHM::Detach()
+{
+    fBlock = NULL;
+}
+
+void FairMQMessageSHM::Adopt(const FairMQShmDescriptor& desc)
+{
+    CloseMessage();
+    if (desc.fHandle != FairMQShmManager::kNoHandle)
+    {
+        fBlock = FairMQShmManager::Instance().GetBlock(desc.fHandle);
+    }
+}
+
+FairMQMessageSHM::~FairMQMessageSHM()
+{
+    CloseMessage();
+}
@@ -0,0 +1,64 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQMessageSHM.h
+ */
+
+#ifndef FAIRMQMESSAGESHM_H_
+#define FAIRMQMESSAGESHM_H_
+
+#include <cstddef>
+
+#include "FairMQMessage.h"
+#include "FairMQShmManager.h"
+
+class FairMQMessageSHM : public FairMQMessage
+{
+    friend class FairMQSocketSHM;
+
+  public:
+    FairMQMessageSHM();
+    FairMQMessageSHM(size_t size);
+    FairMQMessageSHM(void* data, size_t size, fairmq_free_fn *ffn = NULL, void* hint = NULL);
+
+    virtual void Rebuild();
+    virtual void Rebuild(size_t size);
+    virtual void Rebuild(void* data, size_t size, fairmq_free_fn *ffn = NULL, void* hint = NULL);
+    virtual void RebuildPooled(size_t size);
+
+    virtual void* GetMessage();
+    virtual void* GetData();
+    virtual size_t GetSize();
+
+    virtual void SetMessage(void* data, size_t size);
+
+    virtual void CloseMessage();
+    virtual void Copy(FairMQMessage* msg);
+    virtual void Copy(const std::unique_ptr<FairMQMessage>& msg);
+
+    virtual ~FairMQMessageSHM();
+
+  private:
+    FairMQShmBlock* fBlock;
+
+    void Allocate(size_t size);
+    void AllocateCopy(void* data, size_t size, fairmq_free_fn *ffn, void* hint);
+
+    /// Descriptor for sending, the block stays referenced until Detach()
+    FairMQShmDescriptor GetDescriptor() const;
+    /// Hands the reference over to the receiver after a successful send
+    void Detach();
+    /// Takes over the reference that came with a received descriptor
+    void Adopt(const FairMQShmDescriptor& desc);
+
+    /// Copy Constructor
+    FairMQMessageSHM(const FairMQMessageSHM&);
+    FairMQMessageSHM operator=(const FairMQMessageSHM&);
+};
+
+#endif /* FAIRMQMESSAGESHM_H_ */
@@ -0,0 +1,44 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQPollerSHM.h
+ *
+ * The queues of the shared memory transport are ZeroMQ sockets,
+ * so they are polled exactly like the ZeroMQ transport does it.
+ */
+
+#ifndef FAIRMQPOLLERSHM_H_
+#define FAIRMQPOLLERSHM_H_
+
+#include <vector>
+#include <unordered_map>
+#include <initializer_list>
+
+#include "FairMQPollerZMQ.h"
+
+class FairMQPollerSHM : public FairMQPollerZMQ
+{
+    friend class FairMQTransportFactorySHM;
+
+  public:
+    FairMQPollerSHM(const std::vector<FairMQChannel>& channels)
+        : FairMQPollerZMQ(channels)
+    {}
+    FairMQPollerSHM(std::unordered_map<std::string, std::vector<FairMQChannel>>& channelsMap, std::initializer_list<std::string> channelList)
+        : FairMQPollerZMQ(channelsMap, channelList)
+    {}
+
+    virtual ~FairMQPollerSHM() {}
+
+  private:
+    FairMQPollerSHM(FairMQSocket& cmdSocket, FairMQSocket& dataSocket)
+        : FairMQPollerZMQ(cmdSocket, dataSocket)
+    {}
+};
+
+#endif /* FAIRMQPOLLERSHM_H_ */
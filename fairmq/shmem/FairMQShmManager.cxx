@@ -0,0 +1,112 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQShmManager.cxx
+ */
+
+#include <new>
+
+#include "FairMQShmManager.h"
+#include "FairMQLogger.h"
+
+using namespace std;
+namespace bipc = boost::interprocess;
+
+string FairMQShmManager::fSegmentName = "fairmq_shm_main";
+size_t FairMQShmManager::fSegmentSize = static_cast<size_t>(2000) * 1024 * 1024;
+bool FairMQShmManager::fShutdown = false;
+
+void FairMQShmManager::Configure(const string& name, size_t size)
+{
+    fSegmentName = name;
+    fSegmentSize = size;
+}
+
+FairMQShmManager& FairMQShmManager::Instance()
+{
+    // never destroyed, blocks may still be released by late message destructors at exit
+    static FairMQShmManager* manager = new FairMQShmManager();
+    return *manager;
+}
+
+bool FairMQShmManager::Remove()
+{
+    return bipc::shared_memory_object::remove(fSegmentName.c_str());
+}
+
+void FairMQShmManager::Shutdown()
+{
+    if (fShutdown)
+    {
+        return;
+    }
+    fShutdown = true;
+
+    // the mapping stays valid for this process after the removal, late message destructors can still release blocks
+    if (Instance().fUsers->fetch_sub(1) == 1)
+    {
+        LOG(DEBUG) << "Removing shared memory segment '" << fSegmentName << "'";
+        if (!Remove())
+        {
+            LOG(ERROR) << "Failed removing shared memory segment '" << fSegmentName << "'";
+        }
+    }
+}
+
+FairMQShmManager::FairMQShmManager()
+    : fSegment(bipc::open_or_create, fSegmentName.c_str(), fSegmentSize)
+    , fUsers(fSegment.find_or_construct<atomic<int32_t>>("fairmq_shm_users")(0))
+{
+    fUsers->fetch_add(1);
+    LOG(DEBUG) << "Opened shared memory segment '" << fSegmentName << "' of " << fSegment.get_size() << " bytes, "
+               << fSegment.get_free_memory() << " bytes free, used by " << fUsers->load() << " processes";
+}
+
+FairMQShmBlock* FairMQShmManager::Allocate(size_t size)
+{
+    void* ptr = fSegment.allocate(sizeof(FairMQShmBlock) + size, nothrow);
+    if (!ptr)
+    {
+        LOG(ERROR) << "Failed allocating " << size << " bytes in shared memory segment '" << fSegmentName
+                   << "', free memory: " << fSegment.get_free_memory();
+        return NULL;
+    }
+
+    FairMQShmBlock* block = static_cast<FairMQShmBlock*>(ptr);
+    new (&block->fRefCount) atomic<int32_t>(1);
+    block->fPadding = 0;
+    block->fSize = size;
+    return block;
+}
+
+void FairMQShmManager::AddRef(FairMQShmBlock* block)
+{
+    block->fRefCount.fetch_add(1);
+}
+
+void FairMQShmManager::Release(FairMQShmBlock* block)
+{
+    if (block->fRefCount.fetch_sub(1) == 1)
+    {
+        fSegment.deallocate(block);
+    }
+}
+
+uint64_t FairMQShmManager::GetHandle(FairMQShmBlock* block) const
+{
+    return fSegment.get_handle_from_address(block);
+}
+
+FairMQShmBlock* FairMQShmManager::GetBlock(uint64_t handle) const
+{
+    return static_cast<FairMQShmBlock*>(fSegment.get_address_from_handle(handle));
+}
+
+FairMQShmManager::~FairMQShmManager()
+{
+}
@@ -0,0 +1,85 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQShmManager.h
+ *
+ * Owner of the POSIX shared memory segment in which the payloads of the shared
+ * memory transport live. All devices on a node open the same segment, a payload
+ * is identified between processes by its offset (handle) within the segment.
+ */
+
+#ifndef FAIRMQSHMMANAGER_H_
+#define FAIRMQSHMMANAGER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <string>
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+
+/// Header in front of every payload in the segment, the payload follows directly.
+struct FairMQShmBlock
+{
+    std::atomic<int32_t> fRefCount; // number of message objects (in any process) referencing the block
+    uint32_t fPadding;
+    uint64_t fSize;
+
+    void* GetData() { return reinterpret_cast<char*>(this) + sizeof(FairMQShmBlock); }
+};
+
+/// What is sent through the queue instead of the payload.
+struct FairMQShmDescriptor
+{
+    uint64_t fHandle;
+    uint64_t fSize;
+};
+
+class FairMQShmManager
+{
+  public:
+    static const uint64_t kNoHandle = ~static_cast<uint64_t>(0);
+
+    /// Name and size of the segment, only effective before the first call of Instance().
+    static void Configure(const std::string& name, size_t size);
+    static FairMQShmManager& Instance();
+    /// Removes the segment from the system, to be called when no device uses it anymore.
+    static bool Remove();
+    /// Called once by every process at shutdown. The processes using the segment are
+    /// counted in the segment, the last one removes it. Blocks that are still referenced
+    /// by messages which were never received (e.g. the receiver died) are freed with it.
+    static void Shutdown();
+
+    /// New block with reference count 1
+    FairMQShmBlock* Allocate(size_t size);
+    void AddRef(FairMQShmBlock* block);
+    /// Drops one reference, the block is deallocated when the last reference is gone
+    void Release(FairMQShmBlock* block);
+
+    uint64_t GetHandle(FairMQShmBlock* block) const;
+    FairMQShmBlock* GetBlock(uint64_t handle) const;
+
+    size_t GetFreeMemory() const { return fSegment.get_free_memory(); }
+
+  private:
+    FairMQShmManager();
+    ~FairMQShmManager();
+
+    static std::string fSegmentName;
+    static size_t fSegmentSize;
+    static bool fShutdown;
+
+    boost::interprocess::managed_shared_memory fSegment;
+    std::atomic<int32_t>* fUsers; // number of processes which opened the segment
+
+    /// Copy Constructor
+    FairMQShmManager(const FairMQShmManager&);
+    FairMQShmManager operator=(const FairMQShmManager&);
+};
+
+#endif /* FAIRMQSHMMANAGER_H_ */
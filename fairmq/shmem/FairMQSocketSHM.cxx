@@ -0,0 +1,211 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQSocketSHM.cxx
+ */
+
+#include <cstring>
+
+#include "FairMQSocketSHM.h"
+#include "FairMQLogger.h"
+
+using namespace std;
+
+FairMQSocketSHM::FairMQSocketSHM(const string& type, const string& name, int numIoThreads)
+    : FairMQSocketZMQ(type, name, numIoThreads)
+    , fInline(type == "pub" || type == "xpub" || type == "sub" || type == "xsub")
+{
+}
+
+int FairMQSocketSHM::SendMessage(FairMQMessageSHM* msg, const int flags)
+{
+    if (fInline)
+    {
+        int nbytes = zmq_send(fSocket, msg->GetData(), msg->GetSize(), flags);
+        if (nbytes < 0)
+        {
+            return HandleError("sending");
+        }
+        return nbytes;
+    }
+
+    FairMQShmDescriptor desc = msg->GetDescriptor();
+    if (zmq_send(fSocket, &desc, sizeof(desc), flags) < 0)
+    {
+        return HandleError("sending");
+    }
+    return desc.fSize;
+}
+
+int FairMQSocketSHM::ReceiveMessage(FairMQMessageSHM* msg, const int flags, bool& more)
+{
+    zmq_msg_t queued;
+    zmq_msg_init(&queued);
+
+    int nbytes = zmq_msg_recv(&queued, fSocket, flags);
+    if (nbytes < 0)
+    {
+        zmq_msg_close(&queued);
+        more = false;
+        return HandleError("receiving");
+    }
+    more = zmq_msg_more(&queued);
+
+    if (fInline)
+    {
+        msg->Rebuild(nbytes);
+        if (nbytes > 0)
+        {
+            memcpy(msg->GetData(), zmq_msg_data(&queued), nbytes);
+        }
+    }
+    else
+    {
+        if (nbytes != sizeof(FairMQShmDescriptor))
+        {
+            LOG(ERROR) << "Received " << nbytes << " bytes on socket " << fId << ", expected a shared memory descriptor";
+            zmq_msg_close(&queued);
+            return -1;
+        }
+        FairMQShmDescriptor desc;
+        memcpy(&desc, zmq_msg_data(&queued), sizeof(desc));
+        msg->Adopt(desc);
+        nbytes = desc.fSize;
+    }
+
+    zmq_msg_close(&queued);
+    return nbytes;
+}
+
+void FairMQSocketSHM::DiscardParts(bool more)
+{
+    // the parts release their blocks when they go out of scope
+    while (more)
+    {
+        FairMQMessageSHM part;
+        ReceiveMessage(&part, 0, more);
+    }
+}
+
+int FairMQSocketSHM::HandleError(const char* action)
+{
+    if (zmq_errno() == EAGAIN)
+    {
+        return -2;
+    }
+    if (zmq_errno() == ETERM)
+    {
+        LOG(INFO) << "terminating socket " << fId;
+        return -1;
+    }
+    LOG(ERROR) << "Failed " << action << " on socket " << fId << ", reason: " << zmq_strerror(errno);
+    return -1;
+}
+
+int FairMQSocketSHM::Send(FairMQMessage* msg, const string& flag)
+{
+    return Send(msg, GetConstant(flag));
+}
+
+int FairMQSocketSHM::Send(FairMQMessage* msg, const int flags)
+{
+    int nbytes = SendMessage(static_cast<FairMQMessageSHM*>(msg), flags);
+    if (nbytes >= 0)
+    {
+        // the receiver owns the reference now
+        if (!fInline)
+        {
+            static_cast<FairMQMessageSHM*>(msg)->Detach();
+        }
+        fBytesTx += nbytes;
+        ++fMessagesTx;
+    }
+    return nbytes;
+}
+
+int FairMQSocketSHM::Receive(FairMQMessage* msg, const string& flag)
+{
+    return Receive(msg, GetConstant(flag));
+}
+
+int FairMQSocketSHM::Receive(FairMQMessage* msg, const int flags)
+{
+    bool more = false;
+    int nbytes = ReceiveMessage(static_cast<FairMQMessageSHM*>(msg), flags, more);
+    if (nbytes >= 0)
+    {
+        fBytesRx += nbytes;
+        ++fMessagesRx;
+    }
+    return nbytes;
+}
+
+int64_t FairMQSocketSHM::Send(const vector<unique_ptr<FairMQMessage>>& msgVec, const int flags)
+{
+    const unsigned int vecSize = msgVec.size();
+    int64_t totalSize = 0;
+
+    for (unsigned int i = 0; i < vecSize; ++i)
+    {
+        // only the first part can fail with EAGAIN, the others follow it (see FairMQSocketZMQ)
+        const int partFlags = (i == 0) ? flags : (flags & ~ZMQ_DONTWAIT);
+        int nbytes = SendMessage(static_cast<FairMQMessageSHM*>(msgVec[i].get()), (i < vecSize - 1) ? ZMQ_SNDMORE|partFlags : partFlags);
+        if (nbytes < 0)
+        {
+            // ZeroMQ drops an incomplete message, so all parts keep their references and are freed with msgVec
+            return nbytes;
+        }
+        totalSize += nbytes;
+    }
+
+    // the receiver owns the references of all parts now
+    if (!fInline)
+    {
+        for (unsigned int i = 0; i < vecSize; ++i)
+        {
+            static_cast<FairMQMessageSHM*>(msgVec[i].get())->Detach();
+        }
+    }
+
+    fBytesTx += totalSize;
+    ++fMessagesTx;
+    return totalSize;
+}
+
+int64_t FairMQSocketSHM::Receive(vector<unique_ptr<FairMQMessage>>& msgVec, const int flags)
+{
+    int64_t totalSize = 0;
+    bool firstPart = true;
+    bool more = true;
+    const size_t initialSize = msgVec.size();
+
+    while (more)
+    {
+        unique_ptr<FairMQMessage> part(new FairMQMessageSHM());
+        // only the first part can be missing, the following parts have arrived together with it
+        int nbytes = ReceiveMessage(static_cast<FairMQMessageSHM*>(part.get()), firstPart ? flags : 0, more);
+        if (nbytes < 0)
+        {
+            // free the blocks of the parts received so far and of the parts still queued
+            msgVec.resize(initialSize);
+            DiscardParts(more);
+            return nbytes;
+        }
+        firstPart = false;
+        msgVec.push_back(move(part));
+        totalSize += nbytes;
+    }
+
+    fBytesRx += totalSize;
+    ++fMessagesRx;
+    return totalSize;
+}
+
+FairMQSocketSHM::~FairMQSocketSHM()
+{
+}
@@ -0,0 +1,56 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQSocketSHM.h
+ *
+ * Socket of the shared memory transport. A ZeroMQ socket is used as the queue,
+ * but only the descriptors (handle and size) of the payloads in the shared memory
+ * segment travel through it. Publishing sockets cannot know how many subscribers
+ * take over a payload, their messages carry the payload itself.
+ */
+
+#ifndef FAIRMQSOCKETSHM_H_
+#define FAIRMQSOCKETSHM_H_
+
+#include <zmq.h>
+
+#include "FairMQSocketZMQ.h"
+#include "FairMQMessageSHM.h"
+
+class FairMQSocketSHM : public FairMQSocketZMQ
+{
+  public:
+    FairMQSocketSHM(const std::string& type, const std::string& name, int numIoThreads);
+
+    virtual int Send(FairMQMessage* msg, const std::string& flag = "");
+    virtual int Send(FairMQMessage* msg, const int flags = 0);
+    virtual int Receive(FairMQMessage* msg, const std::string& flag = "");
+    virtual int Receive(FairMQMessage* msg, const int flags = 0);
+    virtual int64_t Send(const std::vector<std::unique_ptr<FairMQMessage>>& msgVec, const int flags = 0);
+    virtual int64_t Receive(std::vector<std::unique_ptr<FairMQMessage>>& msgVec, const int flags = 0);
+
+    virtual ~FairMQSocketSHM();
+
+  private:
+    bool fInline; // payloads travel through the queue (fan-out sockets)
+
+    /// Queue one message, returns the payload size or a negative value like Send().
+    /// The caller detaches the block from msg once the whole message is queued.
+    int SendMessage(FairMQMessageSHM* msg, const int flags);
+    /// Take one message from the queue, returns the payload size or a negative value like Receive()
+    int ReceiveMessage(FairMQMessageSHM* msg, const int flags, bool& more);
+    /// Receive and free the remaining parts of a multi-part message if more is set
+    void DiscardParts(bool more);
+    int HandleError(const char* action);
+
+    /// Copy Constructor
+    FairMQSocketSHM(const FairMQSocketSHM&);
+    FairMQSocketSHM operator=(const FairMQSocketSHM&);
+};
+
+#endif /* FAIRMQSOCKETSHM_H_ */
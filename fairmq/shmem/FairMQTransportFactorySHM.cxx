@@ -0,0 +1,72 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQTransportFactorySHM.cxx
+ */
+
+#include "zmq.h"
+
+#include "FairMQTransportFactorySHM.h"
+
+using namespace std;
+
+FairMQTransportFactorySHM::FairMQTransportFactorySHM()
+{
+    int major, minor, patch;
+    zmq_version(&major, &minor, &patch);
+    LOG(DEBUG) << "Using shared memory transport, queues: ZeroMQ library, version: " << major << "." << minor << "." << patch;
+
+    // open the segment now and not with the first message
+    FairMQShmManager::Instance();
+}
+
+FairMQMessage* FairMQTransportFactorySHM::CreateMessage()
+{
+    return new FairMQMessageSHM();
+}
+
+FairMQMessage* FairMQTransportFactorySHM::CreateMessage(size_t size)
+{
+    return new FairMQMessageSHM(size);
+}
+
+FairMQMessage* FairMQTransportFactorySHM::CreateMessage(void* data, size_t size, fairmq_free_fn *ffn, void* hint)
+{
+    return new FairMQMessageSHM(data, size, ffn, hint);
+}
+
+FairMQMessage* FairMQTransportFactorySHM::CreatePooledMessage(size_t size)
+{
+    // the segment allocator already recycles the payload memory
+    return new FairMQMessageSHM(size);
+}
+
+FairMQSocket* FairMQTransportFactorySHM::CreateSocket(const string& type, const std::string& name, int numIoThreads)
+{
+    return new FairMQSocketSHM(type, name, numIoThreads);
+}
+
+FairMQPoller* FairMQTransportFactorySHM::CreatePoller(const vector<FairMQChannel>& channels)
+{
+    return new FairMQPollerSHM(channels);
+}
+
+FairMQPoller* FairMQTransportFactorySHM::CreatePoller(std::unordered_map<std::string, std::vector<FairMQChannel>>& channelsMap, std::initializer_list<std::string> channelList)
+{
+    return new FairMQPollerSHM(channelsMap, channelList);
+}
+
+FairMQPoller* FairMQTransportFactorySHM::CreatePoller(FairMQSocket& cmdSocket, FairMQSocket& dataSocket)
+{
+    return new FairMQPollerSHM(cmdSocket, dataSocket);
+}
+
+FairMQTransportFactorySHM::~FairMQTransportFactorySHM()
+{
+    FairMQShmManager::Shutdown();
+}
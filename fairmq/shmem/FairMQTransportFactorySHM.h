@@ -0,0 +1,45 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+/**
+ * FairMQTransportFactorySHM.h
+ *
+ * Transport for devices on the same node: message payloads are allocated in a
+ * shared memory segment, only their descriptors are queued between the devices.
+ */
+
+#ifndef FAIRMQTRANSPORTFACTORYSHM_H_
+#define FAIRMQTRANSPORTFACTORYSHM_H_
+
+#include <vector>
+
+#include "FairMQTransportFactory.h"
+#include "FairMQMessageSHM.h"
+#include "FairMQSocketSHM.h"
+#include "FairMQPollerSHM.h"
+
+class FairMQTransportFactorySHM : public FairMQTransportFactory
+{
+  public:
+    FairMQTransportFactorySHM();
+
+    virtual FairMQMessage* CreateMessage();
+    virtual FairMQMessage* CreateMessage(size_t size);
+    virtual FairMQMessage* CreateMessage(void* data, size_t size, fairmq_free_fn *ffn = NULL, void* hint = NULL);
+    virtual FairMQMessage* CreatePooledMessage(size_t size);
+
+    virtual FairMQSocket* CreateSocket(const std::string& type, const std::string& name, int numIoThreads);
+
+    virtual FairMQPoller* CreatePoller(const std::vector<FairMQChannel>& channels);
+    virtual FairMQPoller* CreatePoller(std::unordered_map<std::string, std::vector<FairMQChannel>>& channelsMap, std::initializer_list<std::string> channelList);
+    virtual FairMQPoller* CreatePoller(FairMQSocket& cmdSocket, FairMQSocket& dataSocket);
+
+    /// Releases the shared memory segment of this process, see FairMQShmManager::Shutdown()
+    virtual ~FairMQTransportFactorySHM();
+};
+
+#endif /* FAIRMQTRANSPORTFACTORYSHM_H_ */
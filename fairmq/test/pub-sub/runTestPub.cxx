@@ -17,22 +17,20 @@
 #include "FairMQLogger.h"
 #include "FairMQTestPub.h"
 
-#ifdef NANOMSG
-#include "FairMQTransportFactoryNN.h"
-#else
-#include "FairMQTransportFactoryZMQ.h"
-#endif
+#include "FairMQTransportFactory.h"
 
 int main(int argc, char** argv)
 {
     FairMQTestPub testPub;
     testPub.CatchSignals();
 
-#ifdef NANOMSG
-    testPub.SetTransport(new FairMQTransportFactoryNN());
-#else
-    testPub.SetTransport(new FairMQTransportFactoryZMQ());
-#endif
+    // the transport can be given as the first argument, default is the transport of the build
+    FairMQTransportFactory* transportFactory = FairMQTransportFactory::CreateTransportFactory(argc > 1 ? argv[1] : "");
+    if (!transportFactory)
+    {
+        return 1;
+    }
+    testPub.SetTransport(transportFactory);
 
     testPub.SetProperty(FairMQTestPub::Id, "testPub");
 
@@ -17,22 +17,20 @@
 #include "FairMQLogger.h"
 #include "FairMQTestSub.h"
 
-#ifdef NANOMSG
-#include "FairMQTransportFactoryNN.h"
-#else
-#include "FairMQTransportFactoryZMQ.h"
-#endif
+#include "FairMQTransportFactory.h"
 
 int main(int argc, char** argv)
 {
     FairMQTestSub testSub;
     testSub.CatchSignals();
 
-#ifdef NANOMSG
-    testSub.SetTransport(new FairMQTransportFactoryNN());
-#else
-    testSub.SetTransport(new FairMQTransportFactoryZMQ());
-#endif
+    // the transport can be given as the first argument, default is the transport of the build
+    FairMQTransportFactory* transportFactory = FairMQTransportFactory::CreateTransportFactory(argc > 1 ? argv[1] : "");
+    if (!transportFactory)
+    {
+        return 1;
+    }
+    testSub.SetTransport(transportFactory);
 
     testSub.SetProperty(FairMQTestSub::Id, "testSub_" + std::to_string(getpid()));
 
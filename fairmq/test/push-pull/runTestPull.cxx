@@ -15,22 +15,20 @@
 #include "FairMQLogger.h"
 #include "FairMQTestPull.h"
 
-#ifdef NANOMSG
-#include "FairMQTransportFactoryNN.h"
-#else
-#include "FairMQTransportFactoryZMQ.h"
-#endif
+#include "FairMQTransportFactory.h"
 
 int main(int argc, char** argv)
 {
     FairMQTestPull testPull;
     testPull.CatchSignals();
 
-#ifdef NANOMSG
-    testPull.SetTransport(new FairMQTransportFactoryNN());
-#else
-    testPull.SetTransport(new FairMQTransportFactoryZMQ());
-#endif
+    // the transport can be given as the first argument, default is the transport of the build
+    FairMQTransportFactory* transportFactory = FairMQTransportFactory::CreateTransportFactory(argc > 1 ? argv[1] : "");
+    if (!transportFactory)
+    {
+        return 1;
+    }
+    testPull.SetTransport(transportFactory);
 
     testPull.SetProperty(FairMQTestPull::Id, "testPull");
 
@@ -15,22 +15,20 @@
 #include "FairMQLogger.h"
 #include "FairMQTestPush.h"
 
-#ifdef NANOMSG
-#include "FairMQTransportFactoryNN.h"
-#else
-#include "FairMQTransportFactoryZMQ.h"
-#endif
+#include "FairMQTransportFactory.h"
 
 int main(int argc, char** argv)
 {
     FairMQTestPush testPush;
     testPush.CatchSignals();
 
-#ifdef NANOMSG
-    testPush.SetTransport(new FairMQTransportFactoryNN());
-#else
-    testPush.SetTransport(new FairMQTransportFactoryZMQ());
-#endif
+    // the transport can be given as the first argument, default is the transport of the build
+    FairMQTransportFactory* transportFactory = FairMQTransportFactory::CreateTransportFactory(argc > 1 ? argv[1] : "");
+    if (!transportFactory)
+    {
+        return 1;
+    }
+    testPush.SetTransport(transportFactory);
 
     testPush.SetProperty(FairMQTestPush::Id, "testPush");
 
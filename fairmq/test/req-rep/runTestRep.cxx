@@ -17,22 +17,20 @@
 #include "FairMQLogger.h"
 #include "FairMQTestRep.h"
 
-#ifdef NANOMSG
-#include "FairMQTransportFactoryNN.h"
-#else
-#include "FairMQTransportFactoryZMQ.h"
-#endif
+#include "FairMQTransportFactory.h"
 
 int main(int argc, char** argv)
 {
     FairMQTestRep testRep;
     testRep.CatchSignals();
 
-#ifdef NANOMSG
-    testRep.SetTransport(new FairMQTransportFactoryNN());
-#else
-    testRep.SetTransport(new FairMQTransportFactoryZMQ());
-#endif
+    // the transport can be given as the first argument, default is the transport of the build
+    FairMQTransportFactory* transportFactory = FairMQTransportFactory::CreateTransportFactory(argc > 1 ? argv[1] : "");
+    if (!transportFactory)
+    {
+        return 1;
+    }
+    testRep.SetTransport(transportFactory);
 
     testRep.SetProperty(FairMQTestRep::Id, "testRep");
 
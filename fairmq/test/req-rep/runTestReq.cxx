@@ -17,22 +17,20 @@
 #include "FairMQLogger.h"
 #include "FairMQTestReq.h"
 
-#ifdef NANOMSG
-#include "FairMQTransportFactoryNN.h"
-#else
-#include "FairMQTransportFactoryZMQ.h"
-#endif
+#include "FairMQTransportFactory.h"
 
 int main(int argc, char** argv)
 {
     FairMQTestReq testReq;
     testReq.CatchSignals();
 
-#ifdef NANOMSG
-    testReq.SetTransport(new FairMQTransportFactoryNN());
-#else
-    testReq.SetTransport(new FairMQTransportFactoryZMQ());
-#endif
+    // the transport can be given as the first argument, default is the transport of the build
+    FairMQTransportFactory* transportFactory = FairMQTransportFactory::CreateTransportFactory(argc > 1 ? argv[1] : "");
+    if (!transportFactory)
+    {
+        return 1;
+    }
+    testReq.SetTransport(transportFactory);
 
     testReq.SetProperty(FairMQTestReq::Id, "testReq");
 
@@ -17,11 +17,7 @@
 #include "boost/program_options.hpp"
 
 /// ZMQ/nmsg (in FairSoft)
-#ifdef NANOMSG
-#include "FairMQTransportFactoryNN.h"
-#else
-#include "FairMQTransportFactoryZMQ.h"
-#endif
+#include "FairMQTransportFactory.h"
 
 /// FairRoot - FairMQ
 #include "FairMQLogger.h"
@@ -49,11 +45,11 @@ inline int runStateMachine(TMQDevice& device, FairMQProgOptions& config)
 
     LOG(INFO) << "PID: " << getpid();
 
-#ifdef NANOMSG
-    FairMQTransportFactory* transportFactory = new FairMQTransportFactoryNN();
-#else
-    FairMQTransportFactory* transportFactory = new FairMQTransportFactoryZMQ();
-#endif
+    FairMQTransportFactory* transportFactory = FairMQTransportFactory::CreateTransportFactory(config.GetValue<std::string>("transport"));
+    if (!transportFactory)
+    {
+        return 1;
+    }
 
     device.SetTransport(transportFactory);
 
@@ -86,11 +82,11 @@ inline int runNonInteractiveStateMachine(TMQDevice& device, FairMQProgOptions& c
 
     LOG(INFO) << "PID: " << getpid();
 
-#ifdef NANOMSG
-    FairMQTransportFactory* transportFactory = new FairMQTransportFactoryNN();
-#else
-    FairMQTransportFactory* transportFactory = new FairMQTransportFactoryZMQ();
-#endif
+    FairMQTransportFactory* transportFactory = FairMQTransportFactory::CreateTransportFactory(config.GetValue<std::string>("transport"));
+    if (!transportFactory)
+    {
+        return 1;
+    }
 
     device.SetTransport(transportFactory);
 
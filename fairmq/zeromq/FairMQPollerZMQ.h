@@ -42,9 +42,10 @@ class FairMQPollerZMQ : public FairMQPoller
 
     virtual ~FairMQPollerZMQ();
 
-  private:
+  protected:
     FairMQPollerZMQ(FairMQSocket& cmdSocket, FairMQSocket& dataSocket);
 
+  private:
     zmq_pollitem_t* items;
     int fNumItems;
 
@@ -17,6 +17,7 @@
 #include <zmq.h>
 
 #include "FairMQSocketZMQ.h"
+#include "FairMQMessageZMQ.h"
 #include "FairMQLogger.h"
 
 using namespace std;
@@ -193,6 +194,85 @@ int FairMQSocketZMQ::Receive(FairMQMessage* msg, const int flags)
     return nbytes;
 }
 
+int64_t FairMQSocketZMQ::Send(const vector<unique_ptr<FairMQMessage>>& msgVec, const int flags)
+{
+    // ZeroMQ delivers multi-part messages atomically, once the first part is queued the others follow.
+    // Only the first part is sent with the given flags, so a non-blocking send
+    // cannot fail with EAGAIN after a part of the message has been queued.
+    const unsigned int vecSize = msgVec.size();
+    int64_t totalSize = 0;
+
+    for (unsigned int i = 0; i < vecSize; ++i)
+    {
+        const int partFlags = (i == 0) ? flags : (flags & ~ZMQ_DONTWAIT);
+        int nbytes = zmq_msg_send(static_cast<zmq_msg_t*>(msgVec[i]->GetMessage()), fSocket, (i < vecSize - 1) ? ZMQ_SNDMORE|partFlags : partFlags);
+        if (nbytes >= 0)
+        {
+            totalSize += nbytes;
+            continue;
+        }
+        if (zmq_errno() == EAGAIN)
+        {
+            return -2;
+        }
+        if (zmq_errno() == ETERM)
+        {
+            LOG(INFO) << "terminating socket " << fId;
+            return -1;
+        }
+        LOG(ERROR) << "Failed sending on socket " << fId << ", reason: " << zmq_strerror(errno);
+        return nbytes;
+    }
+
+    // the whole multi-part message counts as one message
+    fBytesTx += totalSize;
+    ++fMessagesTx;
+    return totalSize;
+}
+
+int64_t FairMQSocketZMQ::Receive(vector<unique_ptr<FairMQMessage>>& msgVec, const int flags)
+{
+    int64_t totalSize = 0;
+    bool firstPart = true;
+    int more = 1;
+    // parts received before a failure are removed again
+    const size_t initialSize = msgVec.size();
+
+    while (more)
+    {
+        unique_ptr<FairMQMessage> part(new FairMQMessageZMQ());
+        zmq_msg_t* msgPtr = static_cast<zmq_msg_t*>(part->GetMessage());
+
+        // only the first part can be missing, the following parts have arrived together with it
+        int nbytes = zmq_msg_recv(msgPtr, fSocket, firstPart ? flags : 0);
+        if (nbytes >= 0)
+        {
+            firstPart = false;
+            msgVec.push_back(move(part));
+            totalSize += nbytes;
+            more = zmq_msg_more(msgPtr);
+            continue;
+        }
+        const int error = zmq_errno();
+        msgVec.resize(initialSize);
+        if (error == EAGAIN)
+        {
+            return -2;
+        }
+        if (error == ETERM)
+        {
+            LOG(INFO) << "terminating socket " << fId;
+            return -1;
+        }
+        LOG(ERROR) << "Failed receiving on socket " << fId << ", reason: " << zmq_strerror(error);
+        return nbytes;
+    }
+
+    fBytesRx += totalSize;
+    ++fMessagesRx;
+    return totalSize;
+}
+
 void FairMQSocketZMQ::Close()
 {
     // LOG(DEBUG) << "Closing socket " << fId;
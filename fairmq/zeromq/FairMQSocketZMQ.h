@@ -34,6 +34,8 @@ class FairMQSocketZMQ : public FairMQSocket
     virtual int Send(FairMQMessage* msg, const int flags = 0);
     virtual int Receive(FairMQMessage* msg, const std::string& flag = "");
     virtual int Receive(FairMQMessage* msg, const int flags = 0);
+    virtual int64_t Send(const std::vector<std::unique_ptr<FairMQMessage>>& msgVec, const int flags = 0);
+    virtual int64_t Receive(std::vector<std::unique_ptr<FairMQMessage>>& msgVec, const int flags = 0);
 
     virtual void* GetSocket() const;
     virtual int GetSocket(int nothing) const;
@@ -57,7 +59,7 @@ class FairMQSocketZMQ : public FairMQSocket
 
     virtual ~FairMQSocketZMQ();
 
-  private:
+  protected:
     void* fSocket;
     std::string fId;
     unsigned long fBytesTx;
@@ -67,6 +69,7 @@ class FairMQSocketZMQ : public FairMQSocket
 
     static boost::shared_ptr<FairMQContextZMQ> fContext;
 
+  private:
     /// Copy Constructor
     FairMQSocketZMQ(const FairMQSocketZMQ&);
     FairMQSocketZMQ operator=(const FairMQSocketZMQ&);
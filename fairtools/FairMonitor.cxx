@@ -34,6 +34,7 @@
 #include "TString.h"
 #include "TTask.h"
 
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
@@ -49,9 +50,11 @@ FairMonitor::FairMonitor()
   , fNoTaskRequired(0)
   , fNoTaskCreated(0)
   , fRunTime(0.)
-  , fRunMem(0.)
   , fCanvas()
   , fHistList(new TList())
+  , fMemorySampling(100)
+  , fSlots()
+  , fSlotMap()
 {
 }
 //_____________________________________________________________________________
@@ -73,42 +76,112 @@ FairMonitor* FairMonitor::GetMonitor()
 //_____________________________________________________________________________
 
 //_____________________________________________________________________________
-void FairMonitor::StartTimer(const TTask* tTask, const char* identStr) {
-  if ( !fRunMonitor ) return;
+FairMonitorSlot::FairMonitorSlot()
+  : fTask(0)
+  , fTaskName()
+  , fIdent()
+  , fIsExec(kFALSE)
+  , fStartTime(0)
+  , fCount(0)
+  , fSum(0.)
+  , fMin(0.)
+  , fMax(0.)
+  , fMemStart(-1.)
+  , fMemCount(0)
+  , fMemSum(0.)
+  , fTimeHist(0)
+  , fMemHist(0)
+{
+  for ( Int_t ibucket = 0 ; ibucket < kNBuckets ; ibucket++ )
+    fBuckets[ibucket] = 0;
+}
+//_____________________________________________________________________________
 
-  TString tempString = Form("timer_%p_%s_%s",tTask,tTask->GetName(),identStr);
+//_____________________________________________________________________________
+Int_t FairMonitor::GetSlot(const TTask* tTask, const char* identStr) {
+  std::pair<const TTask*, TString> key(tTask,identStr);
+  std::map<std::pair<const TTask*, TString>, Int_t>::const_iterator its = fSlotMap.find(key);
+  if ( its != fSlotMap.end() )
+    return its->second;
 
-  typedef std::map<TString, TStopwatch>::iterator ttMapIter;
+  FairMonitorSlot slot;
+  slot.fTask     = tTask;
+  slot.fTaskName = ( tTask ? tTask->GetName() : "" );
+  slot.fIdent    = identStr;
+  slot.fIsExec   = slot.fIdent.EndsWith("EXEC");
+  fSlots.push_back(slot);
+  Int_t slotId = fSlots.size()-1;
+  fSlotMap.insert(std::pair<std::pair<const TTask*, TString>, Int_t> (key,slotId));
+  return slotId;
+}
+//_____________________________________________________________________________
 
-  ttMapIter itt = fTimerMap.find(tempString);
-  if ( itt == fTimerMap.end() ) {
-    fTimerMap.insert(std::pair<TString, TStopwatch> (tempString,TStopwatch()));
-    itt = fTimerMap.find(tempString);
+//_____________________________________________________________________________
+void FairMonitor::RemoveTask(const TTask* tTask) {
+  typedef std::map<std::pair<const TTask*, TString>, Int_t>::iterator slotMapIter;
+  for ( slotMapIter its = fSlotMap.begin() ; its != fSlotMap.end() ; ) {
+    if ( its->first.first == tTask ) {
+      fSlots[its->second].fTask = 0;
+      fSlotMap.erase(its++);
+    }
+    else {
+      its++;
+    }
   }
-  fTimerMap[tempString].Start();
+  if ( fCurrentTask == tTask )
+    fCurrentTask = 0;
 }
 //_____________________________________________________________________________
 
 //_____________________________________________________________________________
-void FairMonitor::StopTimer(const TTask* tTask, const char* identStr) {
+void FairMonitor::StartTimer(const TTask* tTask, const char* identStr) {
   if ( !fRunMonitor ) return;
+  StartTimer(GetSlot(tTask,identStr));
+}
+//_____________________________________________________________________________
 
-  TString tempString = Form("timer_%p_%s_%s",tTask,tTask->GetName(),identStr);
+//_____________________________________________________________________________
+void FairMonitor::StopTimer(const TTask* tTask, const char* identStr) {
+  if ( !fRunMonitor ) return;
+  StopTimer(GetSlot(tTask,identStr));
+}
+//_____________________________________________________________________________
 
-  typedef std::map<TString, TStopwatch>::iterator ttMapIter;
+//_____________________________________________________________________________
+void FairMonitor::StartTimer(Int_t slot) {
+  if ( !fRunMonitor ) return;
+  fSlots[slot].fStartTime = FairSystemInfo::GetSteadyTime();
+}
+//_____________________________________________________________________________
 
-  ttMapIter itt = fTimerMap.find(tempString);
-  if ( itt == fTimerMap.end() ) {
+//_____________________________________________________________________________
+void FairMonitor::StopTimer(Int_t slot) {
+  if ( !fRunMonitor ) return;
+  Long64_t stopTime = FairSystemInfo::GetSteadyTime();
+  FairMonitorSlot& tSlot = fSlots[slot];
+  if ( tSlot.fStartTime == 0 ) {
     LOG(INFO) << "FairMonitor::StopTimer() called without matching StartTimer()" << FairLogger::endl;
     return;
   }
-  //  itt->second
-  fTimerMap[tempString].Stop();
+  Long64_t duration = stopTime - tSlot.fStartTime;
+  tSlot.fStartTime = 0;
+
+  Double_t time = duration*1.e-9;
+  if ( tSlot.fCount == 0 || time < tSlot.fMin ) tSlot.fMin = time;
+  if ( tSlot.fCount == 0 || time > tSlot.fMax ) tSlot.fMax = time;
+  tSlot.fCount++;
+  tSlot.fSum += time;
+
+  Int_t ibucket = 0;
+  for ( Long64_t micros = duration/1000 ; micros > 0 && ibucket < FairMonitorSlot::kNBuckets-1 ; micros >>= 1 )
+    ibucket++;
+  tSlot.fBuckets[ibucket]++;
 
-  Double_t time = fTimerMap[tempString].RealTime();
-  RecordInfo(tTask,Form("%s_TIM",identStr),time);
+  if ( !tSlot.fTimeHist )
+    tSlot.fTimeHist = GetHist(tSlot.fTask,Form("%s_TIM",tSlot.fIdent.Data()));
+  FillHist(tSlot.fTimeHist,time);
 
-  if ( tempString.EndsWith("_EXEC") )
+  if ( tSlot.fIsExec )
     fRunTime += time;
 }
 //_____________________________________________________________________________
@@ -116,61 +189,72 @@ void FairMonitor::StopTimer(const TTask* tTask, const char* identStr) {
 //_____________________________________________________________________________
 void FairMonitor::StartMemoryMonitor(const TTask* tTask, const char* identStr) {
   if ( !fRunMonitor ) return;
-  FairSystemInfo sysInfo;
-  Int_t memoryAtStart = (Int_t)sysInfo.GetCurrentMemory();
-
-  TString memMon = Form("mem_%p_%s_%s",tTask,tTask->GetName(),identStr);
-  
-  typedef std::map<TString, Int_t>::iterator tiMapIter;
-
-  tiMapIter iti = fMemoryMap.find(memMon);
-  if ( iti == fMemoryMap.end() ) 
-    fMemoryMap.insert(std::pair<TString, Int_t> (memMon,memoryAtStart));
-  else
-    iti->second = memoryAtStart;
+  StartMemoryMonitor(GetSlot(tTask,identStr));
 }
 //_____________________________________________________________________________
 
 //_____________________________________________________________________________
 void FairMonitor::StopMemoryMonitor(const TTask* tTask, const char* identStr) {
   if ( !fRunMonitor ) return;
-  FairSystemInfo sysInfo;
-  Int_t memoryAtEnd = (Int_t)sysInfo.GetCurrentMemory();
+  StopMemoryMonitor(GetSlot(tTask,identStr));
+}
+//_____________________________________________________________________________
 
-  TString memMon = Form("mem_%p_%s_%s",tTask,tTask->GetName(),identStr);
-  
-  typedef std::map<TString, Int_t>::iterator tiMapIter;
+//_____________________________________________________________________________
+void FairMonitor::StartMemoryMonitor(Int_t slot) {
+  if ( !fRunMonitor ) return;
+  FairMonitorSlot& tSlot = fSlots[slot];
+  // reading the process memory is expensive, so only every nth execution is sampled
+  if ( tSlot.fCount % fMemorySampling != 0 ) {
+    tSlot.fMemStart = -1.;
+    return;
+  }
+  FairSystemInfo sysInfo;
+  tSlot.fMemStart = (Double_t)sysInfo.GetCurrentMemory();
+}
+//_____________________________________________________________________________
 
-  tiMapIter iti = fMemoryMap.find(memMon);
-  if ( iti == fMemoryMap.end() ) 
-    LOG(WARNING) << "FairMonitor::StopMemoryMonitor() Could not find corresponding entry for \"" << memMon.Data() << "\"." << FairLogger::endl;
-  else {
-    RecordInfo(tTask,Form("%s_MEM",identStr),memoryAtEnd-iti->second);
-    
-    if ( memMon.EndsWith("_EXEC") )
-      fRunMem += memoryAtEnd-iti->second;
-  } 
+//_____________________________________________________________________________
+void FairMonitor::StopMemoryMonitor(Int_t slot) {
+  if ( !fRunMonitor ) return;
+  FairMonitorSlot& tSlot = fSlots[slot];
+  if ( tSlot.fMemStart < 0. )
+    return;
+  FairSystemInfo sysInfo;
+  Double_t memory = (Double_t)sysInfo.GetCurrentMemory() - tSlot.fMemStart;
+  tSlot.fMemStart = -1.;
+  tSlot.fMemCount++;
+  tSlot.fMemSum += memory;
+
+  if ( !tSlot.fMemHist )
+    tSlot.fMemHist = GetHist(tSlot.fTask,Form("%s_MEM",tSlot.fIdent.Data()));
+  FillHist(tSlot.fMemHist,memory);
 }
 //_____________________________________________________________________________
 
 //_____________________________________________________________________________
 void FairMonitor::RecordInfo(const TTask* tTask, const char* identStr, Double_t value) {
   if ( !fRunMonitor ) return;
-  
+  FillHist(GetHist(tTask,identStr),value);
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+TH1F* FairMonitor::GetHist(const TTask* tTask, const char* identStr) {
   TString tempString = Form("hist_%p_%s_%s",tTask,tTask->GetName(),identStr);
 
-  Int_t nofHists = fHistList->GetEntries();
-  Int_t ihist = 0;
-  for ( ihist = 0 ; ihist < nofHists ; ihist++ ) {
-    if ( !tempString.CompareTo(fHistList->At(ihist)->GetName()) ) {
-      break;
-    }
-  }
-  if ( ihist == nofHists ) {
+  TH1F* tempHist = (TH1F*)(fHistList->FindObject(tempString));
+  if ( !tempHist ) {
     TString titleString = Form("Histogram %s for %s",identStr,tTask->GetName());
-    fHistList->Add(new TH1F(tempString,titleString,1000,0,1000));
+    tempHist = new TH1F(tempString,titleString,1000,0,1000);
+    fHistList->Add(tempHist);
   }
-  TH1F* tempHist = ((TH1F*)(fHistList->At(ihist)));
+  return tempHist;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairMonitor::FillHist(TH1F* tempHist, Double_t value) {
   Int_t nofEntries = tempHist->GetEntries();
   if ( nofEntries > tempHist->GetNbinsX() ) 
     tempHist->SetBins(tempHist->GetNbinsX()*10, 0, tempHist->GetXaxis()->GetXmax()*10);
@@ -179,6 +263,76 @@ void FairMonitor::RecordInfo(const TTask* tTask, const char* identStr, Double_t
 }
 //_____________________________________________________________________________
 
+//_____________________________________________________________________________
+Double_t FairMonitor::GetRunMemory() const {
+  // every sample stands for the executions up to the next one, so the
+  // mean of the samples is scaled with the number of executions
+  Double_t runMem = 0.;
+  for ( UInt_t islot = 0 ; islot < fSlots.size() ; islot++ ) {
+    const FairMonitorSlot& tSlot = fSlots[islot];
+    if ( tSlot.fIsExec && tSlot.fMemCount > 0 )
+      runMem += tSlot.fMemSum/tSlot.fMemCount*tSlot.fCount;
+  }
+  return runMem;
+}
+//_____________________________________________________________________________
+
+//_____________________________________________________________________________
+void FairMonitor::WriteSummary(const char* fileName) {
+  if ( !fRunMonitor ) {
+    LOG(WARNING) << "FairMonitor was disabled. Nothing to write!" << FairLogger::endl;
+    return;
+  }
+  std::ofstream out(fileName);
+  if ( !out.good() ) {
+    LOG(ERROR) << "FairMonitor::WriteSummary() could not open \"" << fileName << "\"" << FairLogger::endl;
+    return;
+  }
+  Bool_t asJson = TString(fileName).EndsWith(".json");
+  out << std::setprecision(9);
+
+  if ( asJson ) {
+    out << "{\n  \"runTime\": " << fRunTime << ",\n  \"runMemory\": " << GetRunMemory()
+        << ",\n  \"memorySampling\": " << fMemorySampling << ",\n  \"slots\": [";
+  }
+  else {
+    out << "task,ident,count,sum_s,mean_s,min_s,max_s,mem_samples,mean_mem_B";
+    for ( Int_t ibucket = 0 ; ibucket < FairMonitorSlot::kNBuckets ; ibucket++ )
+      out << ",lt_" << (1LL<<ibucket) << "us";
+    out << std::endl;
+  }
+
+  for ( UInt_t islot = 0 ; islot < fSlots.size() ; islot++ ) {
+    const FairMonitorSlot& tSlot = fSlots[islot];
+    Double_t mean    = ( tSlot.fCount    ? tSlot.fSum/tSlot.fCount       : 0. );
+    Double_t memMean = ( tSlot.fMemCount ? tSlot.fMemSum/tSlot.fMemCount : 0. );
+    if ( asJson ) {
+      out << ( islot ? "," : "" ) << "\n    {\"task\": \"" << tSlot.fTaskName.Data()
+          << "\", \"ident\": \"" << tSlot.fIdent.Data()
+          << "\", \"count\": " << tSlot.fCount << ", \"sum\": " << tSlot.fSum
+          << ", \"mean\": " << mean << ", \"min\": " << tSlot.fMin << ", \"max\": " << tSlot.fMax
+          << ", \"memSamples\": " << tSlot.fMemCount << ", \"meanMemory\": " << memMean
+          << ", \"buckets\": [";
+      for ( Int_t ibucket = 0 ; ibucket < FairMonitorSlot::kNBuckets ; ibucket++ )
+        out << ( ibucket ? ", " : "" ) << tSlot.fBuckets[ibucket];
+      out << "]}";
+    }
+    else {
+      out << tSlot.fTaskName.Data() << "," << tSlot.fIdent.Data() << "," << tSlot.fCount << ","
+          << tSlot.fSum << "," << mean << "," << tSlot.fMin << "," << tSlot.fMax << ","
+          << tSlot.fMemCount << "," << memMean;
+      for ( Int_t ibucket = 0 ; ibucket < FairMonitorSlot::kNBuckets ; ibucket++ )
+        out << "," << tSlot.fBuckets[ibucket];
+      out << std::endl;
+    }
+  }
+  if ( asJson )
+    out << "\n  ]\n}" << std::endl;
+  out.close();
+  LOG(INFO) << "FairMonitor summary written to \"" << fileName << "\"" << FairLogger::endl;
+}
+//_____________________________________________________________________________
+
 //_____________________________________________________________________________
 void FairMonitor::RecordRegister(const char* name, const char* folderName, Bool_t toFile) {
   if ( !fRunMonitor ) return;
@@ -218,25 +372,24 @@ void FairMonitor::RecordGetting(const char* name) {
 void FairMonitor::PrintTask(TTask* tempTask, Int_t taskLevel) {
   if ( !fRunMonitor ) return;
 
-  Int_t nofHists = fHistList->GetEntries();
   TString tempString = "";
 
   Double_t timInt = -1.;
   Double_t timEnt = 0.;
-  Int_t memInt = -1.;
+  Int_t memInt = -1;
 
   char byteChar[4] = {'B','k','M','G'};
 
-  for ( Int_t ihist = 0 ; ihist < nofHists ; ihist++ ) {
-    tempString = Form("%s",fHistList->At(ihist)->GetName());
-    if ( tempString.Contains(Form("%p",tempTask)) ) {
-      if ( tempString.Contains("EXEC_TIM") ) {
-	timInt = ((TH1F*)fHistList->At(ihist))->Integral();
-	timEnt = ((TH1F*)fHistList->At(ihist))->GetEntries();
-      }
-      if ( tempString.Contains("EXEC_MEM") ) {
-	memInt = ((TH1F*)fHistList->At(ihist))->Integral();
-      }
+  std::map<std::pair<const TTask*, TString>, Int_t>::const_iterator its = fSlotMap.find(std::pair<const TTask*, TString>(tempTask,"EXEC"));
+  if ( its != fSlotMap.end() && fSlots[its->second].fCount > 0 ) {
+    const FairMonitorSlot& tSlot = fSlots[its->second];
+    timInt = tSlot.fSum;
+    timEnt = tSlot.fCount;
+    // the memory is only sampled in every nth execution, scaled as in GetRunMemory()
+    if ( tSlot.fMemCount > 0 ) {
+      Double_t memory = tSlot.fMemSum/tSlot.fMemCount*tSlot.fCount;
+      if ( memory >= 0. )
+        memInt = (Int_t)TMath::Min(memory,2147483647.);
     }
   }
   if ( timInt < 0 ) {
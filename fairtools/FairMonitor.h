@@ -18,15 +18,45 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 #include "TNamed.h"
 #include "TStopwatch.h"
 
 class TCanvas;
 class TFile;
+class TH1F;
 class TList;
 class TTask;
 
+/**
+ * Accumulated measurements of one monitored task and identifier.
+ * Durations are in seconds, the buckets count the executions with
+ * a duration below 2^i microseconds.
+ */
+struct FairMonitorSlot
+{
+  enum { kNBuckets = 24 };
+
+  FairMonitorSlot();
+
+  const TTask* fTask;       // 0 once the task is destroyed
+  TString      fTaskName;
+  TString      fIdent;
+  Bool_t       fIsExec;     // identifier is EXEC, contributes to the run time
+  Long64_t     fStartTime;  // steady clock at start, ns
+  Long64_t     fCount;
+  Double_t     fSum;
+  Double_t     fMin;
+  Double_t     fMax;
+  Long64_t     fBuckets[kNBuckets];
+  Double_t     fMemStart;   // memory at start of a sampled execution, -1 if not sampled
+  Long64_t     fMemCount;   // number of memory samples
+  Double_t     fMemSum;     // summed memory difference of the samples, B
+  TH1F*        fTimeHist;
+  TH1F*        fMemHist;
+};
+
 class FairMonitor : public TNamed
 {
   public:
@@ -34,15 +64,41 @@ class FairMonitor : public TNamed
 
   void EnableMonitor(Bool_t tempBool = kTRUE) { fRunMonitor = tempBool; }
 
+  /** Return the slot in which the measurements of identStr for tTask are
+   *  accumulated, the slot is created on the first call. Tasks get their
+   *  slot once at initialization and use the slot based methods below. */
+  Int_t GetSlot(const TTask* tTask, const char* identStr);
+
+  /** Detach the slots of tTask before the task is destroyed. The
+   *  measurements stay in the summary, a new task at the same address
+   *  gets new slots. */
+  void RemoveTask(const TTask* tTask);
+
+  void StartMonitoring(Int_t slot) {
+    StartMemoryMonitor(slot);
+    StartTimer        (slot);
+  }
+  void  StopMonitoring(Int_t slot) {
+    StopTimer        (slot);
+    StopMemoryMonitor(slot);
+  }
   void StartMonitoring(const TTask* tTask, const char* identStr) {
-    StartTimer        (tTask,identStr);
-    StartMemoryMonitor(tTask,identStr);
+    if ( fRunMonitor ) StartMonitoring(GetSlot(tTask,identStr));
   }
   void  StopMonitoring(const TTask* tTask, const char* identStr) {
-    StopTimer        (tTask,identStr);
-    StopMemoryMonitor(tTask,identStr);
+    if ( fRunMonitor ) StopMonitoring(GetSlot(tTask,identStr));
   }
 
+  void StartTimer(Int_t slot);
+  void  StopTimer(Int_t slot);
+
+  /** The memory is only read in every nth execution of a slot. The _MEM
+   *  histograms hold these samples, the run memory of the summary is the
+   *  mean sample scaled with the number of executions */
+  void SetMemorySampling(Int_t nth) { fMemorySampling = ( nth > 0 ? nth : 1 ); }
+  void StartMemoryMonitor(Int_t slot);
+  void  StopMemoryMonitor(Int_t slot);
+
   void StartTimer(const TTask* tTask, const char* identStr);
   void  StopTimer(const TTask* tTask, const char* identStr);
 
@@ -67,6 +123,10 @@ class FairMonitor : public TNamed
 
   void StoreHistograms(TFile* tfile);
 
+  /** Write the accumulated measurements of all slots to fileName,
+   *  as JSON if the name ends with .json, as CSV otherwise */
+  void WriteSummary(const char* fileName);
+
   private:
     static FairMonitor* instance;
     FairMonitor();
@@ -75,10 +135,17 @@ class FairMonitor : public TNamed
     Bool_t fRunMonitor;
 
     Double_t fRunTime; 
-    Double_t fRunMem;
 
-    std::map<TString, TStopwatch> fTimerMap;
-    std::map<TString, Int_t> fMemoryMap;
+    Int_t fMemorySampling;
+    std::vector<FairMonitorSlot> fSlots;
+    std::map<std::pair<const TTask*, TString>, Int_t> fSlotMap;
+
+    /** Memory difference summed over all EXEC executions, estimated from the samples */
+    Double_t GetRunMemory() const;
+
+    /** Append value to the histogram, bin n holds the nth value */
+    void FillHist(TH1F* hist, Double_t value);
+    TH1F* GetHist(const TTask* tTask, const char* identStr);
 
     TList* fHistList;
     TCanvas* fCanvas;
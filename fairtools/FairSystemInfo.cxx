@@ -19,9 +19,11 @@
 
 #if defined(__APPLE__) && defined(__MACH__)
 #include <mach/mach.h>
+#include <mach/mach_time.h>
 
 #elif defined(__linux__) || defined(__linux) || defined(linux) || defined(__gnu_linux__)
 #include <stdio.h>
+#include <time.h>
 
 #else
 #error "Unknown OS."
@@ -77,3 +79,17 @@ size_t FairSystemInfo::GetCurrentMemory( )
     return (size_t)0L;          /* Unsupported. */
 #endif
 }
+
+Long64_t FairSystemInfo::GetSteadyTime()
+{
+#if defined(__APPLE__) && defined(__MACH__)
+  static mach_timebase_info_data_t timebase;
+  if ( timebase.denom == 0 )
+    mach_timebase_info(&timebase);
+  return (Long64_t)(mach_absolute_time()*timebase.numer/timebase.denom);
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC,&now);
+  return (Long64_t)now.tv_sec*1000000000LL + now.tv_nsec;
+#endif
+}
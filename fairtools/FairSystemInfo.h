@@ -25,6 +25,9 @@ class FairSystemInfo
   Float_t GetMaxMemory();
   size_t GetCurrentMemory();  
 
+  /** Monotonic clock in ns, not affected by changes of the system time **/
+  static Long64_t GetSteadyTime();
+
   ClassDef(FairSystemInfo, 1)
 };
 
@@ -138,6 +138,11 @@ Bool_t FairGenericParAsciiFileIo::readGenericSet(FairParGenericSet *pPar) {
   if (!pFile) {
     return kFALSE;
   }
+  // the file has only one version of the container for all runs, a container
+  // initialized from it is not read again on a run change
+  if (pPar->getInputVersion(inputNumber) == 1) {
+    return kTRUE;
+  }
   pFile->clear();
   pFile->seekg(0, ios::beg);
   Text_t *name = (Char_t *)pPar->GetName();
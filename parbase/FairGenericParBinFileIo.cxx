@@ -0,0 +1,225 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////////
+// FairGenericParBinFileIo
+//
+// Interface class to binary files for input/output of parameters derived
+// from FairParGenericSet
+//
+// A record holds the parameters of the FairParamList filled by putParams:
+//
+//   RecordHeader    number of parameters, lengths of author and description
+//   author, description
+//   per parameter:  ParamHeader, name, type, value, streamer info
+//
+// Every field is padded to 8 bytes, so the values are aligned in the mapped
+// file. The values are copied from the mapping into the FairParamObj without
+// any parsing and the streamer info is kept for classes like in FairParamList.
+//////////////////////////////////////////////////////////////////////////////
+
+#include "FairGenericParBinFileIo.h"
+
+#include "FairParBinFileIo.h"           // for FairParBinFileIo
+#include "FairParGenericSet.h"          // for FairParGenericSet
+#include "FairParSet.h"                 // for FairParSet
+#include "FairParamList.h"              // for FairParamObj, FairParamList
+
+#include "TCollection.h"                // for TIter
+#include "TList.h"                      // for TList
+
+#include <stdio.h>                      // for printf
+#include <string.h>                     // for memcpy, strlen
+#include <string>                       // for string
+
+namespace
+{
+
+struct RecordHeader {
+  UInt_t fNParams;
+  UInt_t fAuthorLength;
+  UInt_t fDescriptionLength;
+  UInt_t fReserved;
+};
+
+struct ParamHeader {
+  UInt_t fNameLength;
+  UInt_t fTypeLength;
+  UInt_t fValueLength;
+  UInt_t fStreamerInfoLength;
+  Int_t fClassVersion;
+  UInt_t fReserved;
+};
+
+ULong64_t Padded(ULong64_t length)
+{
+  return (length+7)/8*8;
+}
+
+void Append(std::string& record, const void* data, ULong64_t length)
+{
+  if (length>0) { record.append(static_cast<const char*>(data),length); }
+  record.append(Padded(length)-length,'\0');
+}
+
+// steps through a record, pointers are 0 after the end of the record
+class RecordReader
+{
+  public:
+    RecordReader(const char* data, ULong64_t length) : fPos(data), fEnd(data+length) {}
+    const char* Get(ULong64_t length) {
+      if (!fPos || (ULong64_t)(fEnd-fPos)<length) {
+        fPos=0;
+        return 0;
+      }
+      const char* p=fPos;
+      fPos+=Padded(length)<(ULong64_t)(fEnd-fPos) ? Padded(length) : fEnd-fPos;
+      return p;
+    }
+  private:
+    const char* fPos;
+    const char* fEnd;
+};
+
+}
+
+ClassImp(FairGenericParBinFileIo)
+
+FairGenericParBinFileIo::FairGenericParBinFileIo(FairParBinFileIo* f)
+  : FairDetParIo(),
+    pFile(f)
+{
+  // constructor
+  // sets the name of the I/O class "FairGenericParIo"
+  // gets the pointer to the binary file I/O
+  fName="FairGenericParIo";
+}
+
+Bool_t FairGenericParBinFileIo::init(FairParSet* pPar)
+{
+  // initializes the parameter container from the binary file
+  if (!pFile) { return kFALSE; }
+  if (pPar->InheritsFrom("FairParGenericSet")) {
+    return readGenericSet((FairParGenericSet*)pPar);
+  }
+  Error("init(FairParSet*)","%s does not inherit from FairParGenericSet",pPar->GetName());
+  return kFALSE;
+}
+
+Int_t FairGenericParBinFileIo::write(FairParSet* pPar)
+{
+  // writes the parameter container to the binary file
+  if (!pFile) { return -1; }
+  if (pPar->InheritsFrom("FairParGenericSet")) {
+    return writeGenericSet((FairParGenericSet*)pPar);
+  }
+  Error("write(FairParSet*)","%s does not inherit from FairParGenericSet",pPar->GetName());
+  return -1;
+}
+
+Bool_t FairGenericParBinFileIo::readGenericSet(FairParGenericSet* pPar)
+{
+  // reads the record valid for the current run from the mapped file
+  const Text_t* name=pPar->GetName();
+  Int_t version=-1;
+  ULong64_t length=0;
+  const char* data=pFile->findRecord(name,version,length);
+  if (!data) {
+    pPar->setInputVersion(-1,inputNumber);
+    return kFALSE;
+  }
+  // the container was already initialized from this record
+  if (pPar->getInputVersion(inputNumber)==version) { return kTRUE; }
+
+  RecordReader reader(data,length);
+  const RecordHeader* header=reinterpret_cast<const RecordHeader*>(reader.Get(sizeof(RecordHeader)));
+  const char* author=header ? reader.Get(header->fAuthorLength) : 0;
+  const char* description=header ? reader.Get(header->fDescriptionLength) : 0;
+  Bool_t complete=(description!=0);
+  FairParamList* paramList=new FairParamList;
+  for (UInt_t i=0; complete && i<header->fNParams; i++) {
+    const ParamHeader* p=reinterpret_cast<const ParamHeader*>(reader.Get(sizeof(ParamHeader)));
+    const char* pName=p ? reader.Get(p->fNameLength) : 0;
+    const char* pType=p ? reader.Get(p->fTypeLength) : 0;
+    const char* pValue=p ? reader.Get(p->fValueLength) : 0;
+    const char* pInfo=p ? reader.Get(p->fStreamerInfoLength) : 0;
+    if (!pInfo) {
+      complete=kFALSE;
+      break;
+    }
+    FairParamObj* obj=new FairParamObj(std::string(pName,p->fNameLength).c_str());
+    obj->setParamType(std::string(pType,p->fTypeLength).c_str());
+    if (p->fValueLength>0) { memcpy(obj->setLength(p->fValueLength),pValue,p->fValueLength); }
+    if (!obj->isBasicType()) {
+      obj->setClassVersion(p->fClassVersion);
+      if (p->fStreamerInfoLength>0) {
+        memcpy(obj->setStreamerInfoSize(p->fStreamerInfoLength),pInfo,p->fStreamerInfoLength);
+      }
+    }
+    paramList->getList()->Add(obj);
+  }
+  if (!complete) {
+    Error("readGenericSet(FairParGenericSet*)","%s: corrupted record in %s",name,pFile->getFilename());
+    pPar->setInputVersion(-1,inputNumber);
+    delete paramList;
+    return kFALSE;
+  }
+
+  pPar->setAuthor(std::string(author,header->fAuthorLength).c_str());
+  pPar->setDescription(std::string(description,header->fDescriptionLength).c_str());
+  Bool_t allFound=pPar->getParams(paramList);
+  if (allFound) {
+    pPar->setInputVersion(version,inputNumber);
+    pPar->setChanged();
+    printf("%s initialized from binary file\n",name);
+  } else {
+    pPar->setInputVersion(-1,inputNumber);
+  }
+  delete paramList;
+  return allFound;
+}
+
+Int_t FairGenericParBinFileIo::writeGenericSet(FairParGenericSet* pPar)
+{
+  // writes the parameters of the container as record for the current run
+  FairParamList* paramList=new FairParamList;
+  pPar->putParams(paramList);
+  TList* pList=paramList->getList();
+
+  std::string record;
+  RecordHeader header;
+  header.fNParams=pList->GetSize();
+  header.fAuthorLength=strlen(pPar->getAuthor());
+  header.fDescriptionLength=strlen(pPar->getDescription());
+  header.fReserved=0;
+  Append(record,&header,sizeof(header));
+  Append(record,pPar->getAuthor(),header.fAuthorLength);
+  Append(record,pPar->getDescription(),header.fDescriptionLength);
+
+  TIter next(pList);
+  FairParamObj* po;
+  while ((po=(FairParamObj*)next())) {
+    ParamHeader p;
+    p.fNameLength=strlen(po->GetName());
+    p.fTypeLength=strlen(po->getParamType());
+    p.fValueLength=po->getLength();
+    p.fStreamerInfoLength=po->getStreamerInfoSize();
+    p.fClassVersion=po->getClassVersion();
+    p.fReserved=0;
+    Append(record,&p,sizeof(p));
+    Append(record,po->GetName(),p.fNameLength);
+    Append(record,po->getParamType(),p.fTypeLength);
+    Append(record,po->getParamValue(),p.fValueLength);
+    Append(record,po->getStreamerInfo(),p.fStreamerInfoLength);
+  }
+  delete paramList;
+
+  Int_t version=pFile->writeRecord(pPar->GetName(),record.data(),record.size());
+  if (version>0) { pPar->setChanged(kFALSE); }
+  return version;
+}
@@ -0,0 +1,37 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#ifndef FAIRGENERICPARBINFILEIO_H
+#define FAIRGENERICPARBINFILEIO_H
+
+#include "FairDetParIo.h"               // for FairDetParIo
+
+#include "Rtypes.h"                     // for Int_t, Bool_t, etc
+
+class FairParBinFileIo;
+class FairParGenericSet;
+class FairParSet;
+
+class FairGenericParBinFileIo : public FairDetParIo
+{
+  protected:
+    FairParBinFileIo* pFile;  //! pointer to the binary file I/O
+  public:
+    FairGenericParBinFileIo(FairParBinFileIo* f=0);
+    ~FairGenericParBinFileIo() {}
+    Bool_t init(FairParSet*);
+    Int_t write(FairParSet*);
+  private:
+    FairGenericParBinFileIo(const FairGenericParBinFileIo&);
+    FairGenericParBinFileIo& operator=(const FairGenericParBinFileIo&);
+
+    ClassDef(FairGenericParBinFileIo,0) // I/O from binary file for parameter containers derived from FairParGenericSet
+    Bool_t readGenericSet(FairParGenericSet* pPar);
+    Int_t writeGenericSet(FairParGenericSet* pPar);
+};
+
+#endif  /* !FAIRGENERICPARBINFILEIO_H */
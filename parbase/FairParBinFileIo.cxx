@@ -0,0 +1,388 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+
+///////////////////////////////////////////////////////////////////////////////
+// FairParBinFileIo
+//
+// Interface class for parameter I/O from binary files, which are memory
+// mapped for reading. Derived from the interface base class FairParIo.
+//
+// The file contains one record per container and validity range of runs,
+// followed by an index sorted by container name and first run:
+//
+//   FileHeader   magic "FAIRPAR", format version, byte order, index position
+//   records      the parameters of a container, see FairGenericParBinFileIo,
+//                each aligned to 8 bytes
+//   IndexEntry[] position, version and validity range of each record
+//   names        container names of the index entries
+//
+// Opening a file only maps it and checks the header, a container is looked up
+// with a binary search in the mapped index and read in place when it is
+// initialized. Files are written and read in the byte order of the machine.
+//
+// For output the file is opened with status "out" and set as output of the
+// runtime database. Each container is written as a record valid from the
+// current run on; a record identical to the previous one of the same container
+// is not written again, its validity is extended. The validity of a record ends
+// with the first run of the next record of the container. The index is only
+// written by close(), e.g. in FairRuntimeDb::closeOutput().
+//
+// Converting a ROOT or ASCII parameter file means initializing the containers
+// from it for all runs with a binary file as output:
+//
+//   rtdb->setFirstInput(rootInput);
+//   FairParBinFileIo* binOutput=new FairParBinFileIo();
+//   binOutput->open("params.bin","out");
+//   rtdb->setOutput(binOutput);
+//   for (Int_t run=firstRun; run<=lastRun; run++) { rtdb->initContainers(run); }
+//   rtdb->closeOutput();
+///////////////////////////////////////////////////////////////////////////////
+#include "FairParBinFileIo.h"
+
+#include "FairDetParIo.h"               // for FairDetParIo
+#include "FairRtdbRun.h"                // for FairRtdbRun
+#include "FairRuntimeDb.h"              // for FairRuntimeDb
+
+#include "TCollection.h"                // for TIter
+#include "TList.h"                      // for TList
+
+#include <fcntl.h>                      // for open, O_RDONLY
+#include <string.h>                     // for memcmp, strcmp, strlen
+#include <sys/mman.h>                   // for mmap, munmap
+#include <sys/stat.h>                   // for fstat
+#include <unistd.h>                     // for close
+#include <algorithm>                    // for stable_sort, upper_bound
+#include <fstream>                      // for ofstream
+#include <iostream>                     // for cout
+#include <map>                          // for map
+#include <string>                       // for string
+#include <vector>                       // for vector
+
+using std::cout;
+using std::ios;
+
+namespace
+{
+
+const char kMagic[8]= {'F','A','I','R','P','A','R','\0'};
+const UInt_t kFormatVersion=1;
+const UInt_t kByteOrder=0x01020304;
+
+struct FileHeader {
+  char fMagic[8];
+  UInt_t fFormatVersion;
+  UInt_t fByteOrder;        // kByteOrder in the byte order of the writer
+  ULong64_t fIndexOffset;
+  ULong64_t fNEntries;
+};
+
+struct IndexEntry {
+  ULong64_t fOffset;        // position of the record
+  ULong64_t fLength;
+  ULong64_t fNameOffset;    // position of the container name (not terminated)
+  UInt_t fNameLength;
+  Int_t fVersion;           // number of the record of this container, 1, 2, ...
+  Int_t fFirstRun;          // validity range of the record
+  Int_t fLastRun;
+};
+
+Int_t CompareNames(const char* a, UInt_t aLength, const char* b, UInt_t bLength)
+{
+  Int_t c=memcmp(a,b,aLength<bLength ? aLength : bLength);
+  if (c!=0) { return c; }
+  return aLength<bLength ? -1 : (aLength>bLength ? 1 : 0);
+}
+
+// orders index entries by container name and first run, the names are taken
+// from names+fNameOffset
+struct EntryOrder {
+  EntryOrder(const char* names) : fNames(names) {}
+  bool operator()(const IndexEntry& a, const IndexEntry& b) const {
+    Int_t c=CompareNames(fNames+a.fNameOffset,a.fNameLength,fNames+b.fNameOffset,b.fNameLength);
+    return c<0 || (c==0 && a.fFirstRun<b.fFirstRun);
+  }
+  const char* fNames;
+};
+
+// search key (container name, run) for upper_bound in the index
+struct RunKey {
+  const char* fName;
+  UInt_t fNameLength;
+  Int_t fRun;
+};
+
+struct RunKeyOrder {
+  RunKeyOrder(const char* data) : fData(data) {}
+  bool operator()(const RunKey& key, const IndexEntry& e) const {
+    Int_t c=CompareNames(key.fName,key.fNameLength,fData+e.fNameOffset,e.fNameLength);
+    return c<0 || (c==0 && key.fRun<e.fFirstRun);
+  }
+  const char* fData;
+};
+
+ULong64_t Padding(ULong64_t length)
+{
+  return (8-length%8)%8;
+}
+
+}
+
+struct FairParBinFileMap {
+  FairParBinFileMap() : fFile(-1), fData(0), fSize(0), fEntries(0), fNEntries(0) {}
+  Int_t fFile;
+  char* fData;
+  size_t fSize;
+  const IndexEntry* fEntries;
+  ULong64_t fNEntries;
+};
+
+struct FairParBinFileWriter {
+  FairParBinFileWriter() : fFile(), fOffset(0), fEntries(), fNames(), fLastEntry(), fLastRecord() {}
+  std::ofstream fFile;
+  ULong64_t fOffset;
+  std::vector<IndexEntry> fEntries;              // fNameOffset relative to fNames
+  std::string fNames;
+  std::map<std::string, size_t> fLastEntry;      // last entry of each container
+  std::map<std::string, std::string> fLastRecord; // and its data
+};
+
+ClassImp(FairParBinFileIo)
+
+FairParBinFileIo::FairParBinFileIo()
+  :FairParIo(),
+   fMap(0),
+   fWriter(0),
+   fRunId(-1)
+{
+}
+
+FairParBinFileIo::~FairParBinFileIo()
+{
+  // default destructor closes an open file and deletes list of I/Os
+  close();
+}
+
+Bool_t FairParBinFileIo::open(const Text_t* fname, const Text_t* status)
+{
+  // opens file
+  // if a file is already open, this file will be closed
+  // activates detector I/Os
+  close();
+  if (strcmp(status,"in")==0) {
+    FairParBinFileMap* map=new FairParBinFileMap();
+    map->fFile=::open(fname,O_RDONLY);
+    struct stat st;
+    if (map->fFile<0 || fstat(map->fFile,&st)!=0) {
+      Error("open","Could not open input file %s",fname);
+      delete map;
+      return kFALSE;
+    }
+    map->fSize=st.st_size;
+    if (map->fSize>=sizeof(FileHeader)) {
+      void* data=mmap(0,map->fSize,PROT_READ,MAP_PRIVATE,map->fFile,0);
+      map->fData=(data==MAP_FAILED) ? 0 : static_cast<char*>(data);
+    }
+    const FileHeader* header=reinterpret_cast<const FileHeader*>(map->fData);
+    Bool_t valid=header && memcmp(header->fMagic,kMagic,sizeof(kMagic))==0
+                 && header->fFormatVersion==kFormatVersion && header->fByteOrder==kByteOrder
+                 && header->fIndexOffset<=map->fSize
+                 && header->fNEntries<=(map->fSize-header->fIndexOffset)/sizeof(IndexEntry);
+    // the names and records of all entries must lie in the file, the lookups
+    // rely on it
+    if (valid) {
+      map->fEntries=reinterpret_cast<const IndexEntry*>(map->fData+header->fIndexOffset);
+      for (ULong64_t i=0; valid && i<header->fNEntries; ++i) {
+        const IndexEntry& e=map->fEntries[i];
+        valid=e.fNameOffset<=map->fSize && e.fNameLength<=map->fSize-e.fNameOffset
+              && e.fOffset<=map->fSize && e.fLength<=map->fSize-e.fOffset;
+      }
+    }
+    if (!valid) {
+      Error("open","%s is not a complete binary parameter file of format version %u "
+            "written with the byte order of this machine",fname,kFormatVersion);
+      if (map->fData) { munmap(map->fData,map->fSize); }
+      ::close(map->fFile);
+      delete map;
+      return kFALSE;
+    }
+    map->fNEntries=header->fNEntries;
+    fMap=map;
+  } else if (strcmp(status,"out")==0) {
+    FairParBinFileWriter* writer=new FairParBinFileWriter();
+    writer->fFile.open(fname,ios::out|ios::binary|ios::trunc);
+    if (!writer->fFile.is_open()) {
+      Error("open","Could not open output file %s",fname);
+      delete writer;
+      return kFALSE;
+    }
+    // the header is only valid after close()
+    FileHeader header;
+    memset(&header,0,sizeof(header));
+    writer->fFile.write(reinterpret_cast<const char*>(&header),sizeof(header));
+    writer->fOffset=sizeof(header);
+    fWriter=writer;
+  } else {
+    cout<<"Put the right stream option for file "<<fname
+        <<"\n  writing state : out\n   reading state : in  \nopen  aborted \n";
+    return kFALSE;
+  }
+  filename=fname;
+  FairRuntimeDb::instance()->activateParIo(this);
+  return kTRUE;
+}
+
+void FairParBinFileIo::close()
+{
+  // closes the file and deletes the detector I/Os
+  // writes the index of an output file
+  if (fMap) {
+    munmap(fMap->fData,fMap->fSize);
+    ::close(fMap->fFile);
+    delete fMap;
+    fMap=0;
+  }
+  if (fWriter) {
+    std::vector<IndexEntry>& entries=fWriter->fEntries;
+    std::stable_sort(entries.begin(),entries.end(),EntryOrder(fWriter->fNames.data()));
+
+    // a container written twice for the same run keeps the last record,
+    // the validity of the others ends with the next record
+    std::vector<IndexEntry> index;
+    for (size_t i=0; i<entries.size(); i++) {
+      IndexEntry& e=entries[i];
+      Bool_t sameName=!index.empty()
+                      && CompareNames(fWriter->fNames.data()+index.back().fNameOffset,index.back().fNameLength,
+                                      fWriter->fNames.data()+e.fNameOffset,e.fNameLength)==0;
+      if (sameName && index.back().fFirstRun==e.fFirstRun) {
+        e.fVersion=index.back().fVersion;
+        index.back()=e;
+        continue;
+      }
+      if (sameName) {
+        index.back().fLastRun=e.fFirstRun-1;
+        e.fVersion=index.back().fVersion+1;
+      } else {
+        e.fVersion=1;
+      }
+      index.push_back(e);
+    }
+
+    FileHeader header;
+    memcpy(header.fMagic,kMagic,sizeof(kMagic));
+    header.fFormatVersion=kFormatVersion;
+    header.fByteOrder=kByteOrder;
+    header.fIndexOffset=fWriter->fOffset;
+    header.fNEntries=index.size();
+    ULong64_t namesOffset=header.fIndexOffset+index.size()*sizeof(IndexEntry);
+    for (size_t i=0; i<index.size(); i++) {
+      index[i].fNameOffset+=namesOffset;
+    }
+    if (!index.empty()) {
+      fWriter->fFile.write(reinterpret_cast<const char*>(&index[0]),index.size()*sizeof(IndexEntry));
+    }
+    fWriter->fFile.write(fWriter->fNames.data(),fWriter->fNames.size());
+    fWriter->fFile.seekp(0);
+    fWriter->fFile.write(reinterpret_cast<const char*>(&header),sizeof(header));
+    fWriter->fFile.close();
+    if (fWriter->fFile.fail()) { Error("close","Could not write the binary parameter file %s",filename.Data()); }
+    delete fWriter;
+    fWriter=0;
+  }
+  filename="";
+  if (detParIoList) { detParIoList->Delete(); }
+}
+
+void FairParBinFileIo::print()
+{
+  // prints information about the file and the detector I/Os
+  if (check()) {
+    cout<<"Binary I/O "<<filename<<" is open for "<<(fMap ? "input, " : "output, ")
+        <<(fMap ? fMap->fNEntries : fWriter->fEntries.size())<<" records\n";
+    TIter next(detParIoList);
+    FairDetParIo* io;
+    cout<<"detector I/Os: ";
+    while ((io=(FairDetParIo*)next())) {
+      cout<<" "<<io->GetName();
+    }
+    cout<<'\n';
+  } else { cout<<"No file open\n"; }
+}
+
+void FairParBinFileIo::readVersions(FairRtdbRun* currentRun)
+{
+  // the records are selected by their validity for this run
+  fRunId=currentRun ? (Int_t)currentRun->getRunId() : -1;
+}
+
+const char* FairParBinFileIo::findRecord(const Text_t* name, Int_t& version, ULong64_t& length)
+{
+  // returns the record of the container valid for the current run and sets
+  // its version and length (returns 0 if the container is not in the file
+  // for this run)
+  if (!fMap) { return 0; }
+  RunKey key= {name,(UInt_t)strlen(name),fRunId};
+  const IndexEntry* end=fMap->fEntries+fMap->fNEntries;
+  const IndexEntry* e=std::upper_bound(fMap->fEntries,end,key,RunKeyOrder(fMap->fData));
+  if (e==fMap->fEntries) { return 0; }
+  --e;
+  if (CompareNames(name,key.fNameLength,fMap->fData+e->fNameOffset,e->fNameLength)!=0
+      || fRunId>e->fLastRun) {
+    return 0;
+  }
+  version=e->fVersion;
+  length=e->fLength;
+  return fMap->fData+e->fOffset;
+}
+
+Int_t FairParBinFileIo::writeRecord(const Text_t* name, const char* data, ULong64_t length)
+{
+  // appends the record of the container for the current run and returns the
+  // number of records of this container (-1 on errors)
+  if (!fWriter) {
+    Error("writeRecord","Output is not writable");
+    return -1;
+  }
+  FairRtdbRun* run=FairRuntimeDb::instance()->getCurrentRun();
+  if (!run) {
+    Error("writeRecord","No current run for container %s",name);
+    return -1;
+  }
+  std::string recordName(name);
+  std::string record(data,length);
+  std::map<std::string, size_t>::iterator last=fWriter->fLastEntry.find(recordName);
+  Int_t nRecords=1;
+  if (last!=fWriter->fLastEntry.end()) {
+    // unchanged containers stay valid
+    if (fWriter->fLastRecord[recordName]==record) { return fWriter->fEntries[last->second].fVersion; }
+    nRecords=fWriter->fEntries[last->second].fVersion+1;
+  }
+
+  IndexEntry e;
+  e.fOffset=fWriter->fOffset;
+  e.fLength=length;
+  e.fNameOffset=fWriter->fNames.size();
+  e.fNameLength=recordName.size();
+  e.fVersion=nRecords;
+  e.fFirstRun=(Int_t)run->getRunId();
+  e.fLastRun=kMaxInt;
+
+  static const char padding[8]= {0};
+  ULong64_t pad=Padding(length);
+  fWriter->fFile.write(data,length);
+  fWriter->fFile.write(padding,pad);
+  if (fWriter->fFile.fail()) {
+    Error("writeRecord","Could not write container %s to %s",name,filename.Data());
+    return -1;
+  }
+  fWriter->fOffset+=length+pad;
+  fWriter->fNames+=recordName;
+  fWriter->fLastEntry[recordName]=fWriter->fEntries.size();
+  fWriter->fLastRecord[recordName]=record;
+  fWriter->fEntries.push_back(e);
+  return nRecords;
+}
@@ -0,0 +1,63 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#ifndef FAIRPARBINFILEIO_H
+#define FAIRPARBINFILEIO_H
+
+#include "FairParIo.h"                  // for FairParIo
+
+#include "Rtypes.h"                     // for Bool_t, Text_t, Int_t, etc
+
+class FairRtdbRun;
+struct FairParBinFileMap;
+struct FairParBinFileWriter;
+
+class FairParBinFileIo : public FairParIo
+{
+  protected:
+    FairParBinFileMap* fMap;       //! mapped input file and its index
+    FairParBinFileWriter* fWriter; //! records and index of the output file
+    Int_t fRunId;                  //! run for which the containers are read
+  public:
+    FairParBinFileIo();
+
+    // default destructor closes an open file and deletes list of I/Os
+    ~FairParBinFileIo();
+
+    // opens file for reading ("in") or writing ("out")
+    // if a file is already open, this file will be closed
+    // activates detector I/Os
+    Bool_t open(const Text_t* fname, const Text_t* status="in");
+
+    // closes file, an output file is only complete after close
+    void close();
+
+    // returns kTRUE if file is open
+    Bool_t check() { return fMap!=0 || fWriter!=0; }
+
+    // prints information about the file and the detector I/Os
+    void print();
+
+    // sets the run for which the records are looked up
+    void readVersions(FairRtdbRun*);
+
+    // returns the record of the container valid for the current run,
+    // a pointer into the mapped file (0 if not found)
+    const char* findRecord(const Text_t* name, Int_t& version, ULong64_t& length);
+
+    // appends a record of the container for the current run of the runtime
+    // database and returns its number (-1 on errors)
+    Int_t writeRecord(const Text_t* name, const char* data, ULong64_t length);
+
+  private:
+    FairParBinFileIo(const FairParBinFileIo&);
+    FairParBinFileIo& operator=(const FairParBinFileIo&);
+
+    ClassDef(FairParBinFileIo,0) // Parameter I/O from memory mapped binary files
+};
+
+#endif  /* !FAIRPARBINFILEIO_H */
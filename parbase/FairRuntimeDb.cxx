@@ -20,10 +20,12 @@
 #include "FairDetParRootFileIo.h"       // for FairDetParRootFileIo
 //#include "FairDetParTSQLIo.h"           // for FairDetParTSQLIo
 #include "FairGenericParAsciiFileIo.h"  // for FairGenericParAsciiFileIo
+#include "FairGenericParBinFileIo.h"    // for FairGenericParBinFileIo
 #include "FairGenericParRootFileIo.h"   // for FairGenericParRootFileIo
 //#include "FairGenericParTSQLIo.h"       // for FairGenericParTSQLIo
 #include "FairLogger.h"                 // for FairLogger, MESSAGE_ORIGIN
 #include "FairParAsciiFileIo.h"         // for FairParAsciiFileIo
+#include "FairParBinFileIo.h"           // for FairParBinFileIo
 #include "FairParIo.h"                  // for FairParIo
 #include "FairParRootFileIo.h"          // for FairParRootFileIo
 #include "FairParSet.h"                 // for FairParSet
@@ -65,6 +67,8 @@ FairRuntimeDb* FairRuntimeDb::instance(void)
 FairRuntimeDb::FairRuntimeDb(void)
   :TObject(),
    containerList(new TList()),
+   changedContainers(new TList()),
+   requestedContainers(NULL),
    runs(new TList()),
    firstInput(NULL),
    secondInput(NULL),
@@ -95,6 +99,7 @@ FairRuntimeDb::~FairRuntimeDb()
     }
     delete containerList;
   }
+  delete changedContainers;
   if (runs) {
     runs->Delete();
     delete runs;
@@ -186,6 +191,7 @@ FairParSet* FairRuntimeDb::getContainer(const Text_t* name)
     c=fact->getContainer(name);
   }
   if (!c) { Error("getContainer(Text_t*)","Container %s not created!",name); }
+  else if (requestedContainers && !requestedContainers->FindObject(c)) { requestedContainers->Add(c); }
   return c;
 }
 
@@ -203,6 +209,7 @@ void FairRuntimeDb::removeContainer(Text_t* name)
   TObject* c=containerList->FindObject(name);
   if (c) {
     containerList->Remove(c);
+    changedContainers->Remove(c);
     delete c;
   }
 }
@@ -210,6 +217,7 @@ void FairRuntimeDb::removeContainer(Text_t* name)
 void FairRuntimeDb::removeAllContainers(void)
 {
   // removes all containers from the list and deletes them
+  changedContainers->Clear();
   containerList->Delete();
 }
 
@@ -538,14 +546,31 @@ Bool_t FairRuntimeDb::initContainers(void)
   }
   if (len>0) { cout << " --> " << refRunName; }
   cout<<'\n'<<"************************************************************* "<<'\n';
+  // the inputs only read the containers which have a new version for this run,
+  // the others keep their input versions and are not marked as changed
+  changedContainers->Clear();
   while ((cont=(FairParSet*)next())) {
     cout << "-I- FairRunTimeDB::InitContainer() " << cont->GetName() << endl;
-    if (!cont->isStatic()) { rc=cont->init() && rc; }
+    if (!cont->isStatic()) {
+      Int_t v1=cont->getInputVersion(1);
+      Int_t v2=cont->getInputVersion(2);
+      rc=cont->init() && rc;
+      if (cont->getInputVersion(1)!=v1 || cont->getInputVersion(2)!=v2) { changedContainers->Add(cont); }
+    }
   }
+  fLogger->Debug(MESSAGE_ORIGIN,"RuntimeDb: %i of %i containers changed",
+                 changedContainers->GetSize(),containerList->GetSize());
   if (!rc) { Error("initContainers()","Error occured during initialization"); }
   return rc;
 }
 
+Bool_t FairRuntimeDb::hasChanged(const Text_t* name)
+{
+  // returns kTRUE if the container got a new input version in the last
+  // initialisation, i.e. if it was read again for the current run
+  return changedContainers->FindObject(name)!=0;
+}
+
 void FairRuntimeDb::setContainersStatic(Bool_t flag)
 {
   // sets the status flag in all containers
@@ -806,6 +831,9 @@ void FairRuntimeDb::activateParIo(FairParIo* io)
       FairDetParAsciiFileIo* pn=
         new FairGenericParAsciiFileIo(((FairParAsciiFileIo*)io)->getFile());
       io->setDetParIo(pn);
+    } else if (strcmp(ioName,"FairParBinFileIo")==0) {
+      FairDetParIo* pn=new FairGenericParBinFileIo((FairParBinFileIo*)io);
+      io->setDetParIo(pn);
     }
     // else if(strcmp(ioName,"FairParTSQLIo") == 0) {
     //  std::cout << "\n\n\n\t TSQL versie is called en nu de rest \n\n";
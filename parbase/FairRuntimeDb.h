@@ -30,6 +30,8 @@ class FairRuntimeDb : public TObject
   protected:
     FairRuntimeDb(void);
     TList* containerList;    // list of parameter containers
+    TList* changedContainers;   // containers with new input versions after the last initialisation
+    TList* requestedContainers; // if set, getContainer adds the returned containers
     TList* runs;             // list of runs
     FairParIo* firstInput;    // first (prefered) input for parameters
     FairParIo* secondInput;   // second input (used if not found in first input)
@@ -67,6 +69,9 @@ class FairRuntimeDb : public TObject
     void removeContainer(Text_t*);
     void removeAllContainers(void);
     Bool_t initContainers(Int_t runId,Int_t refId=-1,const Text_t* fileName="");
+    TList* getChangedContainers() {return changedContainers;}
+    Bool_t hasChanged(const Text_t*);
+    void recordRequestedContainers(TList* list) {requestedContainers=list;}
     void setContainersStatic(Bool_t f=kTRUE);
     Bool_t writeContainers(void);
     Bool_t writeContainer(FairParSet*,FairRtdbRun*,FairRtdbRun* refRun=0);
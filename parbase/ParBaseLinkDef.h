@@ -22,8 +22,10 @@
 #pragma link C++ class FairDetParIo+;
 #pragma link C++ class FairDetParRootFileIo+;
 #pragma link C++ class FairGenericParAsciiFileIo+;
+#pragma link C++ class FairGenericParBinFileIo+;
 #pragma link C++ class FairGenericParRootFileIo+;
 #pragma link C++ class FairParAsciiFileIo+;
+#pragma link C++ class FairParBinFileIo+;
 #pragma link C++ class FairParGenericSet+;
 #pragma link C++ class FairParIo+;
 #pragma link C++ class FairParRootFile+;
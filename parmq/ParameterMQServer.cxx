@@ -12,6 +12,9 @@
  * @author M. Al-Turany, A. Rybalchenko
  */
 
+#include <cstring>
+#include <stdexcept>
+
 #include <boost/thread.hpp>
 #include <boost/bind.hpp>
 
@@ -20,16 +23,38 @@
 
 #include "FairRuntimeDb.h"
 #include "FairParAsciiFileIo.h"
+#include "FairParBinFileIo.h"
 #include "FairParRootFileIo.h"
 
 #include "ParameterMQServer.h"
 #include "FairMQLogger.h"
-#include "FairParGenericSet.h"
+#include "FairMQPoller.h"
+#include "FairMQSocket.h"
+#include "FairParSet.h"
 
 using namespace std;
 
+namespace
+{
+// the worker threads are connected to the router through this address
+const string workerAddress = "inproc://parmq-workers";
+
+void free_shared_tmessage(void* /*data*/, void* hint)
+{
+    delete static_cast<shared_ptr<TMessage>*>(hint);
+}
+}
+
 ParameterMQServer::ParameterMQServer() :
     fRtdb(FairRuntimeDb::instance()),
+    fMutex(),
+    fCurrentRunId(-1),
+    fCache(),
+    fRequested(),
+    fPendingBroadcasts(),
+    fNRequests(0),
+    fNCacheHits(0),
+    fNumWorkers(4),
     fFirstInputName("first_input.root"),
     fFirstInputType("ROOT"),
     fSecondInputName(""),
@@ -56,6 +81,12 @@ void ParameterMQServer::InitTask()
             par1A->open(fFirstInputName.data(), "in");
             fRtdb->setFirstInput(par1A);
         }
+        else if (fFirstInputType == "BIN")
+        {
+            FairParBinFileIo* par1B = new FairParBinFileIo();
+            par1B->open(fFirstInputName.data(), "in");
+            fRtdb->setFirstInput(par1B);
+        }
 
         // Set second input
         if (fSecondInputName != "")
@@ -72,6 +103,12 @@ void ParameterMQServer::InitTask()
                 par2A->open(fSecondInputName.data(), "in");
                 fRtdb->setSecondInput(par2A);
             }
+            else if (fSecondInputType == "BIN")
+            {
+                FairParBinFileIo* par2B = new FairParBinFileIo();
+                par2B->open(fSecondInputName.data(), "in");
+                fRtdb->setSecondInput(par2B);
+            }
         }
 
         // Set output
@@ -89,58 +126,228 @@ void ParameterMQServer::InitTask()
     }
 }
 
-void free_tmessage (void *data, void *hint)
+void ParameterMQServer::Run()
 {
-    delete static_cast<TMessage*>(hint);
+    if (fChannels.at("data").at(0).GetType() == "router")
+    {
+        RunRouter();
+    }
+    else
+    {
+        RunReplier();
+    }
+
+    LOG(INFO) << "Served " << fNRequests << " parameter requests, " << fNCacheHits << " of them from the cache";
 }
 
-void ParameterMQServer::Run()
+void ParameterMQServer::RunReplier()
 {
-    string parameterName = "";
-    FairParGenericSet* par = nullptr;
+    const FairMQChannel& dataChannel = fChannels.at("data").at(0);
 
     while (CheckCurrentState(RUNNING))
     {
         unique_ptr<FairMQMessage> req(fTransportFactory->CreateMessage());
 
-        if (fChannels.at("data").at(0).Receive(req) > 0)
+        if (dataChannel.Receive(req) >= 0)
         {
             string reqStr(static_cast<char*>(req->GetData()), req->GetSize());
-            LOG(INFO) << "Received parameter request from client: \"" << reqStr << "\"";
+            Reply reply = GetReply(reqStr);
+
+            // a rep socket has to answer every request, errors are answered with an empty message
+            unique_ptr<FairMQMessage> msg(reply ? CreateMessage(reply) : fTransportFactory->CreateMessage());
+            dataChannel.Send(msg);
 
-            size_t pos = reqStr.rfind(",");
-            string newParameterName = reqStr.substr(0, pos);
-            int runId = stoi(reqStr.substr(pos + 1));
-            LOG(INFO) << "Parameter name: " << newParameterName;
-            LOG(INFO) << "Run ID: " << runId;
+            Broadcast();
+        }
+    }
+}
 
-            LOG(INFO) << "Retrieving parameter...";
-            // Check if the parameter name has changed to avoid getting same container repeatedly
-            if (newParameterName != parameterName)
+void ParameterMQServer::RunRouter()
+{
+    // The requests arrive as [client identity, empty, request] on the router socket and are passed
+    // through a dealer socket to the rep sockets of the workers, the replies go back the same way.
+    FairMQSocket* front = fChannels.at("data").at(0).fSocket;
+    unique_ptr<FairMQSocket> back(fTransportFactory->CreateSocket("dealer", "parmq-workers", fNumIoThreads));
+    if (!back->Bind(workerAddress))
+    {
+        LOG(ERROR) << "Could not bind the worker socket to " << workerAddress;
+        return;
+    }
+
+    boost::thread_group workers;
+    for (int i = 0; i < fNumWorkers; ++i)
+    {
+        workers.create_thread(boost::bind(&ParameterMQServer::RunWorker, this, i));
+    }
+    LOG(INFO) << "Serving parameter requests with " << fNumWorkers << " worker threads";
+
+    unique_ptr<FairMQPoller> poller(fTransportFactory->CreatePoller(*front, *back));
+    vector<unique_ptr<FairMQMessage>> parts;
+
+    while (CheckCurrentState(RUNNING))
+    {
+        poller->Poll(100);
+
+        if (poller->CheckInput(0))
+        {
+            parts.clear();
+            if (front->Receive(parts, 0) >= 0)
             {
-                parameterName = newParameterName;
-                par = static_cast<FairParGenericSet*>(fRtdb->getContainer(parameterName.c_str()));
+                back->Send(parts, 0);
             }
-            fRtdb->initContainers(runId);
+        }
 
-            LOG(INFO) << "Sending following parameter to the client:";
-            if (par)
+        if (poller->CheckInput(1))
+        {
+            parts.clear();
+            if (back->Receive(parts, 0) >= 0)
             {
-                par->print();
+                front->Send(parts, 0);
+            }
+        }
+
+        Broadcast();
+    }
 
-                TMessage* tmsg = new TMessage(kMESS_OBJECT);
-                tmsg->WriteObject(par);
+    workers.join_all();
+    back->Close();
+}
 
-                unique_ptr<FairMQMessage> reply(fTransportFactory->CreateMessage(tmsg->Buffer(), tmsg->BufferSize(), free_tmessage, tmsg));
+void ParameterMQServer::RunWorker(int id)
+{
+    unique_ptr<FairMQSocket> socket(fTransportFactory->CreateSocket("rep", "parmq-worker", fNumIoThreads));
+    socket->Connect(workerAddress);
+    // wake up regularly to notice the end of the RUNNING state
+    socket->SetReceiveTimeout(100, workerAddress, "connect");
 
-                fChannels.at("data").at(0).Send(reply);
-            }
-            else
+    while (CheckCurrentState(RUNNING))
+    {
+        unique_ptr<FairMQMessage> req(fTransportFactory->CreateMessage());
+
+        if (socket->Receive(req.get(), 0) >= 0)
+        {
+            string reqStr(static_cast<char*>(req->GetData()), req->GetSize());
+            Reply reply = GetReply(reqStr);
+
+            unique_ptr<FairMQMessage> msg(reply ? CreateMessage(reply) : fTransportFactory->CreateMessage());
+            socket->Send(msg.get(), 0);
+        }
+    }
+
+    socket->Close();
+    LOG(DEBUG) << "Parameter worker " << id << " stopped";
+}
+
+ParameterMQServer::Reply ParameterMQServer::GetReply(const string& request)
+{
+    LOG(DEBUG) << "Received parameter request from client: \"" << request << "\"";
+
+    size_t pos = request.rfind(",");
+    if (pos == string::npos)
+    {
+        LOG(ERROR) << "Invalid parameter request \"" << request << "\", expected \"ParameterName,RunID\"";
+        return nullptr;
+    }
+    string parameterName = request.substr(0, pos);
+    int runId = 0;
+    try
+    {
+        runId = stoi(request.substr(pos + 1));
+    }
+    catch (const exception& e)
+    {
+        LOG(ERROR) << "Invalid run ID in parameter request \"" << request << "\"";
+        return nullptr;
+    }
+
+    boost::mutex::scoped_lock lock(fMutex);
+    ++fNRequests;
+
+    if (runId != fCurrentRunId)
+    {
+        LOG(INFO) << "Run ID changed from " << fCurrentRunId << " to " << runId << ", the parameter cache is cleared";
+        fCache.clear();
+        fCurrentRunId = runId;
+
+        // the subscribers get the new versions of all containers requested so far
+        if (fChannels.count("broadcast") > 0)
+        {
+            for (set<string>::const_iterator it = fRequested.begin(); it != fRequested.end(); ++it)
             {
-                LOG(ERROR) << "Parameter uninitialized!";
+                Reply reply = Serialize(*it);
+                if (reply)
+                {
+                    fCache[make_pair(*it, runId)] = reply;
+                    fPendingBroadcasts.push_back(make_pair(*it + "," + to_string(runId), reply));
+                }
             }
         }
     }
+
+    map<pair<string, int>, Reply>::const_iterator cached = fCache.find(make_pair(parameterName, runId));
+    if (cached != fCache.end())
+    {
+        ++fNCacheHits;
+        return cached->second;
+    }
+
+    Reply reply = Serialize(parameterName);
+    if (reply)
+    {
+        fCache[make_pair(parameterName, runId)] = reply;
+        fRequested.insert(parameterName);
+    }
+    return reply;
+}
+
+ParameterMQServer::Reply ParameterMQServer::Serialize(const string& parameterName)
+{
+    FairParSet* par = fRtdb->getContainer(parameterName.c_str());
+    if (!par)
+    {
+        LOG(ERROR) << "Parameter " << parameterName << " uninitialized!";
+        return nullptr;
+    }
+    fRtdb->initContainers(fCurrentRunId);
+
+    LOG(INFO) << "Serializing parameter " << parameterName << " for run " << fCurrentRunId << ":";
+    par->print();
+
+    Reply reply(new TMessage(kMESS_OBJECT));
+    reply->WriteObject(par);
+    return reply;
+}
+
+void ParameterMQServer::Broadcast()
+{
+    vector<pair<string, Reply>> pending;
+    {
+        boost::mutex::scoped_lock lock(fMutex);
+        pending.swap(fPendingBroadcasts);
+    }
+    if (pending.empty())
+    {
+        return;
+    }
+
+    const FairMQChannel& broadcastChannel = fChannels.at("broadcast").at(0);
+    for (size_t i = 0; i < pending.size(); ++i)
+    {
+        LOG(INFO) << "Broadcasting parameter " << pending[i].first;
+
+        vector<unique_ptr<FairMQMessage>> parts;
+        parts.push_back(unique_ptr<FairMQMessage>(fTransportFactory->CreateMessage(pending[i].first.size())));
+        memcpy(parts.back()->GetData(), pending[i].first.data(), pending[i].first.size());
+        parts.push_back(unique_ptr<FairMQMessage>(CreateMessage(pending[i].second)));
+
+        broadcastChannel.SendParts(parts);
+    }
+}
+
+FairMQMessage* ParameterMQServer::CreateMessage(const Reply& reply)
+{
+    // the message keeps the serialized container alive, even if the cache is cleared in the meantime
+    return fTransportFactory->CreateMessage(reply->Buffer(), reply->Length(), free_shared_tmessage, new Reply(reply));
 }
 
 void ParameterMQServer::SetProperty(const int key, const string& value)
@@ -196,6 +403,9 @@ void ParameterMQServer::SetProperty(const int key, const int value)
 {
     switch (key)
     {
+        case NumWorkers:
+            fNumWorkers = value;
+            break;
         default:
             FairMQDevice::SetProperty(key, value);
             break;
@@ -206,6 +416,8 @@ int ParameterMQServer::GetProperty(const int key, const int default_ /*= 0*/)
 {
     switch (key)
     {
+        case NumWorkers:
+            return fNumWorkers;
         default:
             return FairMQDevice::GetProperty(key, default_);
     }
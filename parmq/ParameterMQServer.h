@@ -15,11 +15,20 @@
 #ifndef PARAMETERMQSERVER_H_
 #define PARAMETERMQSERVER_H_
 
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
 
 #include "FairMQDevice.h"
 
 class FairRuntimeDb;
+class FairMQSocket;
+class TMessage;
 
 class ParameterMQServer : public FairMQDevice
 {
@@ -32,6 +41,7 @@ class ParameterMQServer : public FairMQDevice
         SecondInputType,
         OutputName,
         OutputType,
+        NumWorkers,
         Last
     };
 
@@ -49,8 +59,36 @@ class ParameterMQServer : public FairMQDevice
     virtual int GetProperty(const int key, const int default_ = 0);
 
   private:
+    /// Serialized parameter container, shared by the cache and the messages in flight
+    typedef std::shared_ptr<TMessage> Reply;
+
+    /// Serves the requests on the "data" channel of type rep, one after the other
+    void RunReplier();
+    /// Forwards the requests on the "data" channel of type router to the worker threads
+    void RunRouter();
+    /// Main function of the worker threads in router mode
+    void RunWorker(int id);
+
+    /// Returns the reply for a request "ParameterName,RunID", nullptr on errors. Thread safe.
+    Reply GetReply(const std::string& request);
+    /// Serializes the container for the current run, fMutex has to be locked
+    Reply Serialize(const std::string& parameterName);
+    /// Publishes the queued parameter versions on the "broadcast" channel
+    void Broadcast();
+    FairMQMessage* CreateMessage(const Reply& reply);
+
     FairRuntimeDb* fRtdb;
 
+    boost::mutex fMutex; ///< protects the runtime database and the cache
+    int fCurrentRunId;
+    std::map<std::pair<std::string, int>, Reply> fCache; ///< (container name, run id) to reply, cleared on run change
+    std::set<std::string> fRequested; ///< containers requested so far, broadcast on run change
+    std::vector<std::pair<std::string, Reply>> fPendingBroadcasts; ///< topic "ParameterName,RunID" and reply
+    unsigned long fNRequests;
+    unsigned long fNCacheHits;
+
+    int fNumWorkers;
+
     std::string fFirstInputName;
     std::string fFirstInputType;
     std::string fSecondInputName;
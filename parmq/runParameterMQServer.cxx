@@ -44,15 +44,17 @@ int main(int argc, char** argv)
         string secondInputType;
         string outputName;
         string outputType;
+        int numWorkers;
 
         options_description serverOptions("Parameter MQ Server options");
         serverOptions.add_options()
             ("first-input-name", value<string>(&firstInputName)->default_value("first_input.root"), "First input file name")
-            ("first-input-type", value<string>(&firstInputType)->default_value("ROOT"), "First input file type (ROOT/ASCII)")
+            ("first-input-type", value<string>(&firstInputType)->default_value("ROOT"), "First input file type (ROOT/ASCII/BIN)")
             ("second-input-name", value<string>(&secondInputName)->default_value(""), "Second input file name")
-            ("second-input-type", value<string>(&secondInputType)->default_value("ROOT"), "Second input file type (ROOT/ASCII)")
+            ("second-input-type", value<string>(&secondInputType)->default_value("ROOT"), "Second input file type (ROOT/ASCII/BIN)")
             ("output-name", value<string>(&outputName)->default_value(""), "Output file name")
-            ("output-type", value<string>(&outputType)->default_value("ROOT"), "Output file type");
+            ("output-type", value<string>(&outputType)->default_value("ROOT"), "Output file type")
+            ("num-workers", value<int>(&numWorkers)->default_value(4), "Number of worker threads if the data channel is a router");
 
         config.AddToCmdLineOptions(serverOptions);
 
@@ -88,6 +90,7 @@ int main(int argc, char** argv)
         server.SetProperty(ParameterMQServer::SecondInputType, secondInputType);
         server.SetProperty(ParameterMQServer::OutputName, outputName);
         server.SetProperty(ParameterMQServer::OutputType, outputType);
+        server.SetProperty(ParameterMQServer::NumWorkers, numWorkers);
 
         server.ChangeState("INIT_DEVICE");
         server.WaitForEndOfState("INIT_DEVICE");
@@ -24,4 +24,10 @@ FairTimeStamp* MyRingSorter::CreateElement(FairTimeStamp* data)
   return new MyDataClass(*(MyDataClass*)data);
 }
 
+FairTimeStamp* MyRingSorter::CopyElement(FairTimeStamp* data, FairTimeStamp* recycled)
+{
+  *(MyDataClass*)recycled = *(MyDataClass*)data;
+  return recycled;
+}
+
 ClassImp(MyRingSorter);
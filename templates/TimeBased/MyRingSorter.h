@@ -21,11 +21,15 @@ class MyRingSorter: public FairRingSorter
 {
   public:
     MyRingSorter(int size = 100, double width = 10)
-      : FairRingSorter(size, width) {};
+      : FairRingSorter(size, width) {
+      // MySorterTask copies the sorted data into its output array
+      SetRecycleElements(kTRUE);
+    };
 
     virtual ~MyRingSorter();
 
     virtual FairTimeStamp* CreateElement(FairTimeStamp* data);
+    virtual FairTimeStamp* CopyElement(FairTimeStamp* data, FairTimeStamp* recycled);
 
     ClassDef (MyRingSorter,1);
 };
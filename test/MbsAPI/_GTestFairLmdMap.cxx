@@ -0,0 +1,204 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+extern "C"
+{
+#include "fLmdMap.h"
+}
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+const char* kLmdFile = "test_lmdmap.lmd";
+const char* kTagFile = "test_lmdmap.tag";
+const char* kOtherLmdFile = "test_lmdmap_other.lmd";
+const uint32_t kEvents = 100;
+
+// events with event number i and a payload of i%7+1 longwords
+uint32_t WriteLmdFile(const char* fileName, uint32_t nEvents, uint32_t index)
+{
+  sLmdControl* lmd = fLmdAllocateControl();
+  uint32_t status = fLmdPutOpen(lmd, const_cast<char*>(fileName), LMD__STANDARD_HEADER,
+                                LMD__NO_BUFFER, LMD__OVERWRITE, index, LMD__NO_LARGE_FILE);
+  std::vector<uint32_t> event(4 + 8);
+  for (uint32_t i = 0; (status == LMD__SUCCESS) && (i < nEvents); ++i) {
+    uint32_t words = i % 7 + 1;
+    sMbsEventHeader* header = reinterpret_cast<sMbsEventHeader*>(&event[0]);
+    header->iWords = 4 + 2 * words;
+    header->iType = LMD__TYPE_EVENT_HEADER_10_1;
+    header->iTrigger = 1;
+    header->iEventNumber = i;
+    for (uint32_t k = 0; k < words; ++k) { event[4 + k] = i; }
+    status = fLmdPutElement(lmd, reinterpret_cast<sMbsHeader*>(header));
+  }
+  if (status == LMD__SUCCESS) { status = fLmdPutClose(lmd); }
+  free(lmd);
+  return status;
+}
+
+uint32_t EventNumber(sMbsHeader* element)
+{
+  return reinterpret_cast<sMbsEventHeader*>(element)->iEventNumber;
+}
+
+// event numbers returned by fLmdMapGetNext until the end of the range
+std::vector<uint32_t> ReadNext(sLmdMapControl* map)
+{
+  std::vector<uint32_t> numbers;
+  sMbsHeader* element;
+  while (fLmdMapGetNext(map, &element) == LMD__SUCCESS) {
+    numbers.push_back(EventNumber(element));
+  }
+  return numbers;
+}
+
+class FairLmdMapTest : public ::testing::Test
+{
+  protected:
+    FairLmdMapTest() : fMap(fLmdMapAllocateControl()) {}
+
+    virtual ~FairLmdMapTest()
+    {
+      fLmdMapClose(fMap);
+      free(fMap);
+      remove(kLmdFile);
+      remove(kTagFile);
+      remove(kOtherLmdFile);
+    }
+
+    sLmdMapControl* fMap;
+};
+
+} // namespace
+
+TEST_F(FairLmdMapTest, ReadsAllEventsInOrder)
+{
+  ASSERT_EQ(LMD__SUCCESS, WriteLmdFile(kLmdFile, kEvents, LMD__INDEX));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapOpen(fMap, const_cast<char*>(kLmdFile), NULL));
+  ASSERT_EQ(kEvents, fLmdMapGetElements(fMap));
+
+  std::vector<uint32_t> numbers = ReadNext(fMap);
+  ASSERT_EQ(kEvents, numbers.size());
+  for (uint32_t i = 0; i < kEvents; ++i) { EXPECT_EQ(i, numbers[i]); }
+}
+
+TEST_F(FairLmdMapTest, BuildsIndexWithoutTable)
+{
+  ASSERT_EQ(LMD__SUCCESS, WriteLmdFile(kLmdFile, kEvents, LMD__NO_INDEX));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapOpen(fMap, const_cast<char*>(kLmdFile), NULL));
+  ASSERT_EQ(kEvents, fLmdMapGetElements(fMap));
+  EXPECT_EQ(kEvents, ReadNext(fMap).size());
+}
+
+TEST_F(FairLmdMapTest, SeeksToEvent)
+{
+  ASSERT_EQ(LMD__SUCCESS, WriteLmdFile(kLmdFile, kEvents, LMD__INDEX));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapOpen(fMap, const_cast<char*>(kLmdFile), NULL));
+
+  sMbsHeader* element;
+  const uint32_t targets[] = { 57, 3, 99, 0 };
+  for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); ++i) {
+    ASSERT_EQ(LMD__SUCCESS, fLmdMapSeek(fMap, targets[i]));
+    ASSERT_EQ(LMD__SUCCESS, fLmdMapGetNext(fMap, &element));
+    EXPECT_EQ(targets[i], EventNumber(element));
+    // the payload of the element is intact
+    EXPECT_EQ(4 + 2 * (targets[i] % 7 + 1), element->iWords);
+    EXPECT_EQ(targets[i], reinterpret_cast<uint32_t*>(element)[4]);
+  }
+
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapSeek(fMap, kEvents));
+  EXPECT_EQ(GETLMD__NOMORE, fLmdMapGetNext(fMap, &element));
+  EXPECT_EQ(GETLMD__OUTOF_RANGE, fLmdMapSeek(fMap, kEvents + 1));
+  EXPECT_EQ(GETLMD__OUTOF_RANGE, fLmdMapGetElement(fMap, kEvents, &element));
+}
+
+TEST_F(FairLmdMapTest, SplitsIntoContiguousRanges)
+{
+  ASSERT_EQ(LMD__SUCCESS, WriteLmdFile(kLmdFile, kEvents, LMD__INDEX));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapOpen(fMap, const_cast<char*>(kLmdFile), NULL));
+
+  const uint32_t nRanges = 3;
+  uint64_t first, last, expectedFirst = 0;
+  std::vector<uint32_t> numbers;
+  for (uint32_t iRange = 0; iRange < nRanges; ++iRange) {
+    ASSERT_EQ(LMD__SUCCESS, fLmdMapGetRange(fMap, iRange, nRanges, &first, &last));
+    EXPECT_EQ(expectedFirst, first);
+    EXPECT_LT(first, last);
+    expectedFirst = last;
+
+    ASSERT_EQ(LMD__SUCCESS, fLmdMapSetRange(fMap, first, last));
+    std::vector<uint32_t> range = ReadNext(fMap);
+    EXPECT_EQ(last - first, range.size());
+    numbers.insert(numbers.end(), range.begin(), range.end());
+  }
+  EXPECT_EQ(kEvents, expectedFirst);
+
+  // the ranges together hold every event once
+  ASSERT_EQ(kEvents, numbers.size());
+  for (uint32_t i = 0; i < kEvents; ++i) { EXPECT_EQ(i, numbers[i]); }
+
+  EXPECT_EQ(GETLMD__OUTOF_RANGE, fLmdMapGetRange(fMap, nRanges, nRanges, &first, &last));
+  EXPECT_EQ(GETLMD__OUTOF_RANGE, fLmdMapSetRange(fMap, 10, 5));
+  EXPECT_EQ(GETLMD__OUTOF_RANGE, fLmdMapSetRange(fMap, 0, kEvents + 1));
+}
+
+TEST_F(FairLmdMapTest, ReadsIndexFromTagFile)
+{
+  ASSERT_EQ(LMD__SUCCESS, WriteLmdFile(kLmdFile, kEvents, LMD__NO_INDEX));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapOpen(fMap, const_cast<char*>(kLmdFile), NULL));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapWriteTagFile(fMap, const_cast<char*>(kTagFile)));
+
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapOpen(fMap, const_cast<char*>(kLmdFile), const_cast<char*>(kTagFile)));
+  ASSERT_EQ(kEvents, fLmdMapGetElements(fMap));
+  sMbsHeader* element;
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapSeek(fMap, 42));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapGetNext(fMap, &element));
+  EXPECT_EQ(42u, EventNumber(element));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapSeek(fMap, 0));
+  EXPECT_EQ(kEvents, ReadNext(fMap).size());
+}
+
+TEST_F(FairLmdMapTest, IgnoresTagFileOfOtherFile)
+{
+  // tag file of a file with other event sizes, its offsets do not match
+  ASSERT_EQ(LMD__SUCCESS, WriteLmdFile(kOtherLmdFile, 2 * kEvents, LMD__NO_INDEX));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapOpen(fMap, const_cast<char*>(kOtherLmdFile), NULL));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapWriteTagFile(fMap, const_cast<char*>(kTagFile)));
+
+  ASSERT_EQ(LMD__SUCCESS, WriteLmdFile(kLmdFile, kEvents, LMD__NO_INDEX));
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapOpen(fMap, const_cast<char*>(kLmdFile), const_cast<char*>(kTagFile)));
+  ASSERT_EQ(kEvents, fLmdMapGetElements(fMap));
+  EXPECT_EQ(kEvents, ReadNext(fMap).size());
+}
+
+TEST_F(FairLmdMapTest, IgnoresTableOutsideOfFile)
+{
+  ASSERT_EQ(LMD__SUCCESS, WriteLmdFile(kLmdFile, kEvents, LMD__INDEX));
+
+  // move the offset of an event in the table behind the end of the file
+  FILE* file = fopen(kLmdFile, "r+b");
+  ASSERT_TRUE(file != NULL);
+  sMbsFileHeader header;
+  ASSERT_EQ(1u, fread(&header, sizeof(header), 1, file));
+  ASSERT_EQ(4u, header.iOffsetSize);
+  uint32_t offset = 0x7fffffff;
+  ASSERT_EQ(0, fseek(file, header.iTableOffset * 4 + 16 + 50 * 4, SEEK_SET));
+  ASSERT_EQ(1u, fwrite(&offset, sizeof(offset), 1, file));
+  fclose(file);
+
+  // the index is built from the element headers instead
+  ASSERT_EQ(LMD__SUCCESS, fLmdMapOpen(fMap, const_cast<char*>(kLmdFile), NULL));
+  ASSERT_EQ(kEvents, fLmdMapGetElements(fMap));
+  EXPECT_EQ(kEvents, ReadNext(fMap).size());
+}
@@ -0,0 +1,125 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             * 
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *  
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairLink.h"
+#include "FairMultiLinkedData.h"
+
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <memory>
+#include <set>
+#include <vector>
+
+TEST(FairMultiLinkedDataTest, CompactLinkSize)
+{
+  EXPECT_EQ(sizeof(FairCompactLink), 16u);
+}
+
+TEST(FairMultiLinkedDataTest, InsertLinkAddsWeights)
+{
+  FairMultiLinkedData data;
+  data.InsertLink(FairLink(1, 5, 1.));
+  data.InsertLink(FairLink(1, 5, 2.));
+  data.InsertLink(FairLink(2, 5, 1.));
+
+  ASSERT_EQ(data.GetNLinks(), 2);
+  EXPECT_EQ(data.GetLink(0).GetType(), 1);
+  EXPECT_FLOAT_EQ(data.GetLink(0).GetWeight(), 3.);
+  EXPECT_EQ(data.GetLink(1).GetType(), 2);
+}
+
+TEST(FairMultiLinkedDataTest, SameOrderAsSet)
+{
+  // the links have to come out in the same order as from a std::set<FairLink>
+  TRandom3 random(4357);
+  FairMultiLinkedData data;
+  std::set<FairLink> reference;
+  for (Int_t i = 0; i < 200; i++) {
+    Int_t file = random.Integer(3);
+    Int_t entry = random.Integer(10);
+    Int_t type = random.Integer(5);
+    Int_t index = random.Integer(50);
+    FairLink link(file, entry, type, index);
+    data.InsertLink(link);
+    reference.insert(link);
+  }
+
+  ASSERT_EQ(data.GetNLinks(), static_cast<Int_t>(reference.size()));
+  std::set<FairLink> links = data.GetLinks();
+  std::set<FairLink>::const_iterator it = reference.begin();
+  for (std::set<FairLink>::const_iterator iter = links.begin(); iter != links.end(); iter++, it++) {
+    EXPECT_TRUE(*iter == *it);
+  }
+  EXPECT_GE(data.LinkPosInList(data.GetLink(7).GetType(), data.GetLink(7).GetIndex()), 0);
+}
+
+namespace {
+
+// Counts the bytes the containers really allocate, including the node
+// overhead of the std::set
+size_t gAllocatedBytes = 0;
+
+template <class T>
+struct CountingAllocator : public std::allocator<T>
+{
+  template <class U> struct rebind { typedef CountingAllocator<U> other; };
+
+  CountingAllocator() : std::allocator<T>() {}
+  template <class U> CountingAllocator(const CountingAllocator<U>& other) : std::allocator<T>(other) {}
+
+  T* allocate(size_t n, const void* = 0)
+  {
+    gAllocatedBytes += n * sizeof(T);
+    return std::allocator<T>::allocate(n);
+  }
+};
+
+// Gives access to the capacity of the link storage
+class LinkStorage : public FairMultiLinkedData
+{
+  public:
+    size_t GetAllocatedBytes() const { return fLinks.capacity() * sizeof(FairCompactLink); }
+};
+
+}
+
+TEST(FairMultiLinkedDataTest, UsesLessMemoryThanSet)
+{
+  // Compares the link storage of FairMultiLinkedData with the
+  // std::set<FairLink> which was used before, for objects with a few links
+  const Int_t nObjects = 1000;
+  const Int_t nLinks = 4;
+
+  typedef std::set<FairLink, std::less<FairLink>, CountingAllocator<FairLink> > LinkSet;
+  std::vector<LinkSet> sets(nObjects);
+  gAllocatedBytes = 0;
+  for (Int_t i = 0; i < nObjects; i++) {
+    for (Int_t k = 0; k < nLinks; k++) {
+      sets[i].insert(FairLink(0, i, 1, nLinks - k));
+    }
+  }
+  size_t setBytes = gAllocatedBytes;
+
+  std::vector<LinkStorage> data(nObjects);
+  size_t compactBytes = 0;
+  for (Int_t i = 0; i < nObjects; i++) {
+    for (Int_t k = 0; k < nLinks; k++) {
+      data[i].InsertLink(FairLink(0, i, 1, nLinks - k));
+    }
+    ASSERT_EQ(data[i].GetNLinks(), nLinks);
+    compactBytes += data[i].GetAllocatedBytes();
+  }
+
+  std::cout << "std::set<FairLink>:  " << setBytes / nObjects << " bytes per object" << std::endl;
+  std::cout << "FairMultiLinkedData: " << compactBytes / nObjects << " bytes per object" << std::endl;
+
+  EXPECT_EQ(compactBytes, nObjects * nLinks * sizeof(FairCompactLink));
+  EXPECT_LT(2 * compactBytes, setBytes);
+}
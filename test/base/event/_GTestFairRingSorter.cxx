@@ -0,0 +1,170 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairRingSorter.h"
+#include "FairTimeStamp.h"
+
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <vector>
+
+namespace {
+
+class TestDigi : public FairTimeStamp
+{
+  public:
+    TestDigi() : FairTimeStamp(), fChannel(0) {}
+    TestDigi(Int_t channel, Double_t time) : FairTimeStamp(time), fChannel(channel) {}
+    Int_t fChannel;
+};
+
+// sorter in the style of FairTestDetectorDigiRingSorter, counting the created elements
+class TestDigiSorter : public FairRingSorter
+{
+  public:
+    TestDigiSorter(int size, double width, Bool_t recycle)
+      : FairRingSorter(size, width), fCreated(0) {
+      SetRecycleElements(recycle);
+    }
+    virtual FairTimeStamp* CreateElement(FairTimeStamp* data) {
+      fCreated++;
+      return new TestDigi(*static_cast<TestDigi*>(data));
+    }
+    virtual FairTimeStamp* CopyElement(FairTimeStamp* data, FairTimeStamp* recycled) {
+      *static_cast<TestDigi*>(recycled) = *static_cast<TestDigi*>(data);
+      return recycled;
+    }
+    Long64_t fCreated;
+};
+
+// Sorts nEvents events of digis which arrive up to 500 ns late, checks the
+// order of the output and returns the number of digis written out
+Long64_t SortEvents(TestDigiSorter& sorter, TRandom3& random, Int_t firstEvent, Int_t nEvents,
+                    std::vector<TestDigi>& event, Double_t& lastTime, Bool_t& ordered)
+{
+  Long64_t nOut = 0;
+  for (Int_t iEvent = firstEvent; iEvent < firstEvent + nEvents; iEvent++) {
+    Double_t eventTime = 100. * iEvent;
+    for (size_t i = 0; i < event.size(); i++) {
+      event[i].fChannel = i;
+      event[i].SetTimeStamp(eventTime + random.Uniform(0., 500.));
+      sorter.AddElement(&event[i], event[i].GetTimeStamp());
+    }
+    const std::vector<FairTimeStamp*>& output = sorter.GetOutputDataRef();
+    for (size_t i = 0; i < output.size(); i++) {
+      ordered = ordered && output[i]->GetTimeStamp() >= lastTime;
+      lastTime = output[i]->GetTimeStamp();
+    }
+    nOut += output.size();
+    sorter.DeleteOutputData();
+  }
+  return nOut;
+}
+
+}
+
+TEST(FairRingSorterTest, SortsAcrossCells)
+{
+  TestDigiSorter sorter(100, 10., kTRUE);
+  TRandom3 random(4357);
+  std::vector<TestDigi> input;
+  for (Int_t i = 0; i < 500; i++) {
+    input.push_back(TestDigi(i, 2. * i + random.Uniform(0., 50.)));
+  }
+  for (size_t i = 0; i < input.size(); i++) {
+    sorter.AddElement(&input[i], input[i].GetTimeStamp());
+  }
+  sorter.WriteOutAll();
+
+  const std::vector<FairTimeStamp*>& output = sorter.GetOutputDataRef();
+  ASSERT_EQ(output.size(), input.size());
+  for (size_t i = 1; i < output.size(); i++) {
+    EXPECT_LE(output[i - 1]->GetTimeStamp(), output[i]->GetTimeStamp());
+  }
+  sorter.DeleteOutputData();
+  EXPECT_TRUE(sorter.GetOutputDataRef().empty());
+}
+
+TEST(FairRingSorterTest, EqualTimeStampsKeepOrder)
+{
+  TestDigiSorter sorter(10, 10., kFALSE);
+  TestDigi late(0, 5.);
+  TestDigi first(1, 3.);
+  TestDigi second(2, 3.);
+  sorter.AddElement(&late, late.GetTimeStamp());
+  sorter.AddElement(&first, first.GetTimeStamp());
+  sorter.AddElement(&second, second.GetTimeStamp());
+  sorter.WriteOutAll();
+
+  std::vector<FairTimeStamp*> output;
+  sorter.SwapOutputData(output);
+  ASSERT_EQ(output.size(), 3u);
+  EXPECT_EQ(static_cast<TestDigi*>(output[0])->fChannel, 1);
+  EXPECT_EQ(static_cast<TestDigi*>(output[1])->fChannel, 2);
+  EXPECT_EQ(static_cast<TestDigi*>(output[2])->fChannel, 0);
+  for (size_t i = 0; i < output.size(); i++) {
+    delete output[i];
+  }
+}
+
+TEST(FairRingSorterTest, RecyclesElements)
+{
+  // once the sorter is filled, the digis written out provide the elements
+  // for the new ones
+  const Int_t nEvents = 300;
+  const Int_t nDigisPerEvent = 1000;
+
+  TRandom3 random(4357);
+  std::vector<TestDigi> event(nDigisPerEvent);
+  TestDigiSorter sorter(1000, 10., kTRUE);
+  Bool_t ordered = kTRUE;
+  Double_t lastTime = 0.;
+
+  Long64_t nOut = SortEvents(sorter, random, 0, nEvents, event, lastTime, ordered);
+  Long64_t nCreated = sorter.fCreated;
+  nOut += SortEvents(sorter, random, nEvents, nEvents, event, lastTime, ordered);
+  sorter.WriteOutAll();
+  nOut += sorter.GetOutputDataRef().size();
+  sorter.DeleteOutputData();
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(nOut, 2LL * nEvents * nDigisPerEvent);
+  EXPECT_LT(sorter.fCreated - nCreated, static_cast<Long64_t>(nEvents) * nDigisPerEvent / 100);
+}
+
+// Benchmark, run with --gtest_also_run_disabled_tests
+TEST(FairRingSorterTest, DISABLED_Throughput)
+{
+  // 10^7 digis in events of 1000 digis, which arrive up to 500 ns late
+  const Int_t nEvents = 10000;
+  const Int_t nDigisPerEvent = 1000;
+
+  TRandom3 random(4357);
+  std::vector<TestDigi> event(nDigisPerEvent);
+  TestDigiSorter sorter(1000, 10., kTRUE);
+  Bool_t ordered = kTRUE;
+  Double_t lastTime = 0.;
+
+  TStopwatch timer;
+  timer.Start();
+  Long64_t nOut = SortEvents(sorter, random, 0, nEvents, event, lastTime, ordered);
+  sorter.WriteOutAll();
+  nOut += sorter.GetOutputDataRef().size();
+  sorter.DeleteOutputData();
+  timer.Stop();
+
+  Double_t nDigis = static_cast<Double_t>(nEvents) * nDigisPerEvent;
+  std::cout << "FairRingSorter: " << nDigis << " digis in " << timer.RealTime() << " s, "
+            << nDigis / timer.RealTime() << " digis/s, " << sorter.fCreated << " elements created" << std::endl;
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(nOut, static_cast<Long64_t>(nDigis));
+}
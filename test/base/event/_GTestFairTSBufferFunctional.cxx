@@ -0,0 +1,89 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairRootManager.h"
+#include "FairTSBufferFunctional.h"
+#include "FairTimeStamp.h"
+
+#include "TClonesArray.h"
+#include "TObjArray.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+std::vector<Double_t> GetTimes(TObjArray* data)
+{
+  std::vector<Double_t> times;
+  for (Int_t i = 0; i < data->GetEntriesFast(); i++) {
+    times.push_back(static_cast<FairTimeStamp*>(data->At(i))->GetTimeStamp());
+  }
+  std::sort(times.begin(), times.end());
+  return times;
+}
+
+std::vector<Double_t> SelectTimes(const std::vector<Double_t>& all, Double_t startTime, Double_t stopTime)
+{
+  std::vector<Double_t> times;
+  for (size_t i = 0; i < all.size(); i++) {
+    if (all[i] >= startTime && all[i] < stopTime) {
+      times.push_back(all[i]);
+    }
+  }
+  std::sort(times.begin(), times.end());
+  return times;
+}
+
+}
+
+TEST(FairTSBufferFunctionalTest, GetTimeSliceData)
+{
+  // 20 entries with 10 digis each, every second entry has one digi which
+  // belongs to the time range of the entries before, entry 7 is empty
+  TClonesArray* digis = new TClonesArray("FairTimeStamp");
+  FairRootManager::Instance()->Register("TSDigi", "TSTest", digis, kFALSE);
+  TTree tree("TSTree", "time slice test");
+  tree.Branch("TSDigi", &digis);
+
+  std::vector<Double_t> all;
+  for (Int_t entry = 0; entry < 20; entry++) {
+    digis->Delete();
+    if (entry != 7) {
+      for (Int_t i = 0; i < 10; i++) {
+        Double_t time = 100. * entry + 10. * i;
+        new ((*digis)[i]) FairTimeStamp(time);
+        all.push_back(time);
+      }
+      if (entry % 2 == 1) {
+        Double_t time = 100. * entry - 150.;
+        new ((*digis)[10]) FairTimeStamp(time);
+        all.push_back(time);
+      }
+    }
+    tree.Fill();
+  }
+
+  FairTSBufferFunctional buffer("TSDigi", &tree, 0, 0);
+
+  // slices of 200 ns with 50 ns overlap
+  for (Int_t slice = 0; slice < 11; slice++) {
+    Double_t startTime = 200. * slice - 100.;
+    Double_t stopTime = startTime + 250.;
+    TObjArray* data = buffer.GetTimeSliceData(startTime, stopTime);
+    ASSERT_TRUE(data != 0);
+    EXPECT_EQ(GetTimes(data), SelectTimes(all, startTime, stopTime)) << "slice " << slice;
+  }
+
+  // the same range again and a range before the kept entries
+  EXPECT_EQ(GetTimes(buffer.GetTimeSliceData(1900., 2150.)), SelectTimes(all, 1900., 2150.));
+  EXPECT_EQ(GetTimes(buffer.GetTimeSliceData(300., 550.)), SelectTimes(all, 300., 550.));
+  EXPECT_EQ(GetTimes(buffer.GetTimeSliceData(5000., 5250.)).size(), 0u);
+}
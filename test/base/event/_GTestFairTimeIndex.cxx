@@ -0,0 +1,65 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairTimeIndex.h"
+
+#include "gtest/gtest.h"
+
+TEST(FairTimeIndexTest, FindFirstEntryAfter)
+{
+  FairTimeIndex index;
+  index.AddEntry(0., 10.);
+  index.AddEmptyEntry();
+  index.AddEntry(8., 20.);
+  // overlaps with the entry before, but ends earlier
+  index.AddEntry(15., 18.);
+  index.AddEntry(21., 30.);
+
+  ASSERT_EQ(index.GetNEntries(), 5);
+  EXPECT_TRUE(index.IsEmpty(1));
+  EXPECT_FALSE(index.IsEmpty(3));
+
+  EXPECT_EQ(index.FindFirstEntryAfter(-1.), 0);
+  EXPECT_EQ(index.FindFirstEntryAfter(5.), 0);
+  EXPECT_EQ(index.FindFirstEntryAfter(10.), 2);
+  EXPECT_EQ(index.FindFirstEntryAfter(19.), 2);
+  EXPECT_EQ(index.FindFirstEntryAfter(20.), 4);
+  EXPECT_EQ(index.FindFirstEntryAfter(30.), 5);
+
+  // entries added after a search are taken into account
+  index.AddEntry(31., 40.);
+  EXPECT_EQ(index.FindFirstEntryAfter(30.), 5);
+}
+
+TEST(FairTimeIndexTest, TimeSliceRange)
+{
+  FairTimeIndex index;
+  index.AddEntry(0., 10.);
+  index.AddEmptyEntry();
+  index.AddEntry(12., 20.);
+  // late entry with data of the range of the entry before
+  index.AddEntry(5., 30.);
+  index.AddEntry(31., 40.);
+
+  // first entry with data at 10. or later
+  EXPECT_EQ(index.FindFirstEntryFrom(10.), 0);
+  EXPECT_EQ(index.FindFirstEntryFrom(10.5), 2);
+  EXPECT_EQ(index.FindFirstEntryFrom(40.), 4);
+  EXPECT_EQ(index.FindFirstEntryFrom(41.), 5);
+
+  // entry 3 holds older data than entry 2
+  EXPECT_EQ(index.GetMinTimeFrom(0), 0.);
+  EXPECT_EQ(index.GetMinTimeFrom(1), 5.);
+  EXPECT_EQ(index.GetMinTimeFrom(2), 5.);
+  EXPECT_EQ(index.GetMinTimeFrom(4), 31.);
+  EXPECT_EQ(index.GetMaxTimeUpTo(2), 20.);
+  EXPECT_EQ(index.GetMaxTimeUpTo(4), 40.);
+
+  // entries added later lower the minimum of the entries before
+  index.AddEntry(1., 50.);
+  EXPECT_EQ(index.GetMinTimeFrom(4), 1.);
+}
@@ -0,0 +1,132 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairWriteoutBufferT.h"
+#include "FairTimeStamp.h"
+
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <vector>
+
+namespace {
+
+class TestDigi : public FairTimeStamp
+{
+  public:
+    TestDigi() : FairTimeStamp(), fChannel(0) {}
+    TestDigi(Int_t channel, Double_t time) : FairTimeStamp(time), fChannel(channel) {}
+    Int_t fChannel;
+};
+
+struct TestDigiChannel {
+  typedef Int_t result_type;
+  Int_t operator()(const TestDigi& digi) const { return digi.fChannel; }
+};
+
+typedef FairWriteoutBufferT<TestDigi, TestDigiChannel> TestDigiBuffer;
+
+// extends the dead time of a busy channel
+class ExtendingBuffer : public TestDigiBuffer
+{
+  protected:
+    virtual void ModifyData(TestDigi&, double& activeTime, const TestDigi&, double newActiveTime) {
+      if (newActiveTime > activeTime) {
+        activeTime = newActiveTime;
+      }
+    }
+};
+
+void FillTestData(TestDigiBuffer& buffer)
+{
+  TestDigi first(1, 0.);
+  TestDigi pileUp(1, 50.);
+  TestDigi other(2, 10.);
+  buffer.FillNewData(&first, 0., 100.);
+  buffer.FillNewData(&pileUp, 50., 150.);
+  buffer.FillNewData(&other, 10., 60.);
+}
+
+void CheckAndDelete(std::vector<FairTimeStamp*> data, const std::vector<Int_t>& channels)
+{
+  ASSERT_EQ(data.size(), channels.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    EXPECT_EQ(static_cast<TestDigi*>(data[i])->fChannel, channels[i]);
+    delete data[i];
+  }
+}
+
+}
+
+TEST(FairWriteoutBufferTTest, PileUpIsIgnored)
+{
+  TestDigiBuffer buffer;
+  buffer.ActivateBuffering();
+  FillTestData(buffer);
+
+  buffer.WriteOutData(60.);
+  EXPECT_EQ(buffer.GetNData(), 2);
+
+  std::vector<Int_t> channels;
+  channels.push_back(2);
+  channels.push_back(1);
+  CheckAndDelete(buffer.GetRemoveOldData(150.), channels);
+  EXPECT_EQ(buffer.GetNData(), 0);
+
+  // the channel is free again
+  TestDigi late(1, 200.);
+  buffer.FillNewData(&late, 200., 300.);
+  buffer.WriteOutData(250.);
+  EXPECT_EQ(buffer.GetNData(), 1);
+  CheckAndDelete(buffer.GetAllData(), std::vector<Int_t>(1, 1));
+}
+
+TEST(FairWriteoutBufferTTest, ModifyExtendsDeadTime)
+{
+  ExtendingBuffer buffer;
+  buffer.ActivateBuffering();
+  FillTestData(buffer);
+
+  buffer.WriteOutData(60.);
+  CheckAndDelete(buffer.GetRemoveOldData(120.), std::vector<Int_t>(1, 2));
+  EXPECT_EQ(buffer.GetNData(), 1);
+  CheckAndDelete(buffer.GetRemoveOldData(151.), std::vector<Int_t>(1, 1));
+}
+
+// Benchmark, run with --gtest_also_run_disabled_tests
+TEST(FairWriteoutBufferTTest, DISABLED_Throughput)
+{
+  // 10^6 digis on 10^4 channels with a dead time of 100 ns, a digi every 0.1 ns
+  const Int_t nDigis = 1000000;
+  const Int_t nChannels = 10000;
+
+  TRandom3 random(4357);
+  TestDigiBuffer buffer;
+  buffer.ActivateBuffering();
+  TestDigi digi;
+
+  TStopwatch timer;
+  timer.Start();
+  for (Int_t i = 0; i < nDigis; i++) {
+    Double_t time = 0.1 * i;
+    digi.fChannel = random.Integer(nChannels);
+    digi.SetTimeStamp(time);
+    buffer.FillNewData(&digi, time, time + 100.);
+    if (i % 1000 == 999) {
+      buffer.WriteOutData(time);
+    }
+  }
+  buffer.WriteOutAllData();
+  timer.Stop();
+
+  std::cout << "FairWriteoutBufferT: " << nDigis << " digis in " << timer.RealTime() << " s, "
+            << nDigis / timer.RealTime() << " digis/s" << std::endl;
+  EXPECT_EQ(buffer.GetNData(), 0);
+}
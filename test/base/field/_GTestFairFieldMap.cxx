@@ -0,0 +1,278 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairField.h"
+#include "FairFieldFactory.h"
+#include "FairFieldMap.h"
+#include "FairFieldMapCreator.h"
+
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+// smooth field, Bx and Bz change sign with y, Bx with x
+class AnalyticField : public FairField
+{
+  public:
+    AnalyticField() : FairField("AnalyticField") {}
+    virtual Double_t GetBx(Double_t x, Double_t y, Double_t z) { return 1e-3 * x * y * TMath::Cos(0.01 * z); }
+    virtual Double_t GetBy(Double_t x, Double_t y, Double_t z) { return 10. + 1e-3 * (x * x - y * y) + 0.01 * z; }
+    virtual Double_t GetBz(Double_t x, Double_t y, Double_t z) { return 0.02 * y * TMath::Sin(0.01 * z); }
+};
+
+// field map in the style of the experiment maps: one array per component,
+// separate interpolation for each component
+class NaiveFieldMap : public FairField
+{
+  public:
+    NaiveFieldMap(FairField* field, Int_t n, Double_t min, Double_t max, Double_t zmin, Double_t zmax)
+      : FairField("NaiveFieldMap"), fN(n), fMin(min), fMax(max), fZmin(zmin), fZmax(zmax),
+        fBx(n * n * n), fBy(n * n * n), fBz(n * n * n) {
+      for (Int_t ix = 0; ix < n; ix++) {
+        for (Int_t iy = 0; iy < n; iy++) {
+          for (Int_t iz = 0; iz < n; iz++) {
+            Double_t x = fMin + ix * (fMax - fMin) / (n - 1);
+            Double_t y = fMin + iy * (fMax - fMin) / (n - 1);
+            Double_t z = fZmin + iz * (fZmax - fZmin) / (n - 1);
+            Int_t index = (ix * n + iy) * n + iz;
+            fBx[index] = field->GetBx(x, y, z);
+            fBy[index] = field->GetBy(x, y, z);
+            fBz[index] = field->GetBz(x, y, z);
+          }
+        }
+      }
+    }
+    virtual Double_t GetBx(Double_t x, Double_t y, Double_t z) { return Interpolate(fBx, x, y, z); }
+    virtual Double_t GetBy(Double_t x, Double_t y, Double_t z) { return Interpolate(fBy, x, y, z); }
+    virtual Double_t GetBz(Double_t x, Double_t y, Double_t z) { return Interpolate(fBz, x, y, z); }
+
+  private:
+    Double_t Interpolate(const std::vector<Float_t>& b, Double_t x, Double_t y, Double_t z) {
+      if (x < fMin || x > fMax || y < fMin || y > fMax || z < fZmin || z > fZmax) { return 0.; }
+      Double_t step = (fMax - fMin) / (fN - 1);
+      Double_t zStep = (fZmax - fZmin) / (fN - 1);
+      Int_t ix = static_cast<Int_t>((x - fMin) / step);
+      Int_t iy = static_cast<Int_t>((y - fMin) / step);
+      Int_t iz = static_cast<Int_t>((z - fZmin) / zStep);
+      if (ix == fN - 1) { ix--; }
+      if (iy == fN - 1) { iy--; }
+      if (iz == fN - 1) { iz--; }
+      Double_t dx = (x - fMin) / step - ix;
+      Double_t dy = (y - fMin) / step - iy;
+      Double_t dz = (z - fZmin) / zStep - iz;
+      Double_t result = 0.;
+      for (Int_t i = 0; i < 2; i++) {
+        for (Int_t j = 0; j < 2; j++) {
+          for (Int_t k = 0; k < 2; k++) {
+            Double_t w = (i ? dx : 1. - dx) * (j ? dy : 1. - dy) * (k ? dz : 1. - dz);
+            result += w * b[((ix + i) * fN + iy + j) * fN + iz + k];
+          }
+        }
+      }
+      return result;
+    }
+    Int_t fN;
+    Double_t fMin, fMax, fZmin, fZmax;
+    std::vector<Float_t> fBx, fBy, fBz;
+};
+
+void RandomPoints(Int_t n, Double_t min, Double_t max, Double_t zmin, Double_t zmax,
+                  std::vector<Double_t>& x, std::vector<Double_t>& y, std::vector<Double_t>& z)
+{
+  TRandom3 random(4357);
+  x.resize(n);
+  y.resize(n);
+  z.resize(n);
+  for (Int_t i = 0; i < n; i++) {
+    x[i] = random.Uniform(min, max);
+    y[i] = random.Uniform(min, max);
+    z[i] = random.Uniform(zmin, zmax);
+  }
+}
+
+}
+
+TEST(FairFieldMapTest, InterpolatesTheField)
+{
+  AnalyticField analytic;
+  FairFieldMap map("TestMap", 41, -50., 50., 41, -50., 50., 41, 0., 200., kFALSE);
+  map.Fill(&analytic);
+
+  // exact at the nodes, zero outside
+  EXPECT_DOUBLE_EQ(map.GetBy(-50., 50., 200.), analytic.GetBy(-50., 50., 200.));
+  EXPECT_DOUBLE_EQ(map.GetBx(2.5, -7.5, 5.), analytic.GetBx(2.5, -7.5, 5.));
+  EXPECT_EQ(map.GetBy(0., 0., -1.), 0.);
+  EXPECT_EQ(map.GetBy(50.1, 0., 100.), 0.);
+
+  std::vector<Double_t> x, y, z;
+  RandomPoints(1000, -50., 50., 0., 200., x, y, z);
+  Double_t b[3];
+  for (size_t i = 0; i < x.size(); i++) {
+    Double_t point[3] = {x[i], y[i], z[i]};
+    map.GetFieldValue(point, b);
+    EXPECT_NEAR(b[0], analytic.GetBx(x[i], y[i], z[i]), 0.01);
+    EXPECT_NEAR(b[1], analytic.GetBy(x[i], y[i], z[i]), 0.01);
+    EXPECT_NEAR(b[2], analytic.GetBz(x[i], y[i], z[i]), 0.01);
+  }
+}
+
+TEST(FairFieldMapTest, FoldedMap)
+{
+  AnalyticField analytic;
+  FairFieldMap full("FullMap", 41, -50., 50., 41, -50., 50., 41, 0., 200.);
+  full.Fill(&analytic);
+  FairFieldMap folded("FoldedMap", 21, 0., 50., 21, 0., 50., 41, 0., 200.);
+  folded.SetSymmetry(0, -1, 1, 1);
+  folded.SetSymmetry(1, -1, 1, -1);
+  folded.Fill(&analytic);
+
+  std::vector<Double_t> x, y, z;
+  RandomPoints(1000, -50., 50., 0., 200., x, y, z);
+  Double_t b[3], bFull[3];
+  for (size_t i = 0; i < x.size(); i++) {
+    Double_t point[3] = {x[i], y[i], z[i]};
+    folded.GetFieldValue(point, b);
+    full.GetFieldValue(point, bFull);
+    for (Int_t k = 0; k < 3; k++) {
+      EXPECT_NEAR(b[k], bFull[k], 1e-4);
+    }
+  }
+}
+
+TEST(FairFieldMapTest, BinaryFile)
+{
+  AnalyticField analytic;
+  FairFieldMap map("TestMap", 21, 0., 50., 21, 0., 50., 41, 0., 200.);
+  map.SetSymmetry(1, -1, 1, -1);
+  map.Fill(&analytic);
+  ASSERT_TRUE(map.WriteFile("test_fieldmap.bin"));
+
+  FairFieldMap mapped("test_fieldmap.bin");
+  ASSERT_TRUE(mapped.HasNodes());
+  std::vector<Double_t> x, y, z;
+  RandomPoints(100, -50., 50., 0., 200., x, y, z);
+  for (size_t i = 0; i < x.size(); i++) {
+    EXPECT_EQ(mapped.GetBx(x[i], y[i], z[i]), map.GetBx(x[i], y[i], z[i]));
+    EXPECT_EQ(mapped.GetBy(x[i], y[i], z[i]), map.GetBy(x[i], y[i], z[i]));
+    EXPECT_EQ(mapped.GetBz(x[i], y[i], z[i]), map.GetBz(x[i], y[i], z[i]));
+  }
+
+  // the creator registers as field factory
+  new FairFieldMapCreator("test_fieldmap.bin", 2.);
+  FairField* created = FairFieldFactory::Instance()->createFairField();
+  ASSERT_TRUE(created != 0);
+  EXPECT_DOUBLE_EQ(created->GetBy(10., -20., 30.), 2. * map.GetBy(10., -20., 30.));
+  delete created;
+
+  std::ofstream bad("test_fieldmap_bad.bin");
+  bad << "no field map";
+  bad.close();
+  FairFieldMap badMap("test_fieldmap_bad.bin");
+  EXPECT_FALSE(badMap.HasNodes());
+  EXPECT_EQ(badMap.GetBy(10., 10., 10.), 0.);
+
+  remove("test_fieldmap.bin");
+  remove("test_fieldmap_bad.bin");
+}
+
+TEST(FairFieldMapTest, RejectsInconsistentHeader)
+{
+  FairFieldMap map("TestMap", 3, 0., 1., 3, 0., 1., 3, 0., 1.);
+  ASSERT_TRUE(map.WriteFile("test_fieldmap.bin"));
+  std::ifstream in("test_fieldmap.bin", std::ios::binary);
+  std::string good((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+
+  // header: magic, format version, byte order, value size, symmetry, node
+  // numbers (at byte 24), reserved, min, max, signs, data offset (at byte 160)
+  const Int_t hugeN[3] = {0x7fffffff, 0x7fffffff, 8};
+  const ULong64_t smallOffset = 0;
+  std::string bad[2] = {good, good};
+  memcpy(&bad[0][24], hugeN, sizeof(hugeN));
+  memcpy(&bad[1][160], &smallOffset, sizeof(smallOffset));
+  for (Int_t i = 0; i < 2; i++) {
+    std::ofstream out("test_fieldmap_bad.bin", std::ios::binary | std::ios::trunc);
+    out.write(bad[i].data(), bad[i].size());
+    out.close();
+    FairFieldMap badMap;
+    EXPECT_FALSE(badMap.ReadFile("test_fieldmap_bad.bin"));
+    EXPECT_FALSE(badMap.HasNodes());
+  }
+
+  FairFieldMap mapped;
+  EXPECT_TRUE(mapped.ReadFile("test_fieldmap.bin"));
+  remove("test_fieldmap.bin");
+  remove("test_fieldmap_bad.bin");
+}
+
+// Benchmark, run with --gtest_also_run_disabled_tests
+TEST(FairFieldMapTest, DISABLED_Benchmark)
+{
+  AnalyticField analytic;
+  const Int_t nNodes = 101;
+  NaiveFieldMap naive(&analytic, nNodes, -100., 100., 0., 400.);
+  FairFieldMap map("TestMap", nNodes, -100., 100., nNodes, -100., 100., nNodes, 0., 400.);
+  map.Fill(&analytic);
+
+  const Int_t n = 1000000;
+  std::vector<Double_t> x, y, z;
+  RandomPoints(n, -100., 100., 0., 400., x, y, z);
+  std::vector<Double_t> bx(n), by(n), bz(n);
+  Double_t b[3];
+
+  TStopwatch timer;
+  timer.Start();
+  for (Int_t i = 0; i < n; i++) {
+    Double_t point[3] = {x[i], y[i], z[i]};
+    naive.GetFieldValue(point, b);
+    bx[i] = b[0];
+    by[i] = b[1];
+    bz[i] = b[2];
+  }
+  timer.Stop();
+  Double_t naiveTime = timer.RealTime();
+
+  timer.Start();
+  for (Int_t i = 0; i < n; i++) {
+    Double_t point[3] = {x[i], y[i], z[i]};
+    map.GetFieldValue(point, b);
+  }
+  timer.Stop();
+  Double_t singleTime = timer.RealTime();
+
+  std::vector<Double_t> mx(n), my(n), mz(n);
+  timer.Start();
+  map.GetFieldValues(n, &x[0], &y[0], &z[0], &mx[0], &my[0], &mz[0]);
+  timer.Stop();
+  Double_t batchTime = timer.RealTime();
+
+  Double_t maxDiff = 0.;
+  Double_t maxError = 0.;
+  for (Int_t i = 0; i < n; i += 100) {
+    maxDiff = TMath::Max(maxDiff, TMath::Abs(mx[i] - bx[i]) + TMath::Abs(my[i] - by[i]) + TMath::Abs(mz[i] - bz[i]));
+    maxError = TMath::Max(maxError, TMath::Abs(my[i] - analytic.GetBy(x[i], y[i], z[i])));
+  }
+  EXPECT_LT(maxDiff, 1e-4);
+  EXPECT_LT(maxError, 0.01);
+
+  std::cout << "FairFieldMap: max. difference to the naive map " << maxDiff << " kG, max. By error "
+            << maxError << " kG" << std::endl;
+  std::cout << "FairFieldMap: queries/s naive " << n / naiveTime << ", single " << n / singleTime
+            << ", batch " << n / batchTime << std::endl;
+}
@@ -0,0 +1,194 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairField.h"
+#include "FairRKPropagator.h"
+
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// solenoid like field with small gradients, with a batched query
+class TestField : public FairField
+{
+  public:
+    TestField() : FairField("TestField") {}
+    virtual Double_t GetBx(Double_t x, Double_t, Double_t z) { return 0.0005 * z + 0.001 * x; }
+    virtual Double_t GetBy(Double_t, Double_t y, Double_t) { return 0.2 + 0.002 * y; }
+    virtual Double_t GetBz(Double_t, Double_t, Double_t z) { return 10. + 0.01 * z; }
+    virtual void GetFieldValues(Int_t n, const Double_t* x, const Double_t* y, const Double_t* z,
+                                Double_t* bx, Double_t* by, Double_t* bz) {
+      for (Int_t i = 0; i < n; i++) {
+        bx[i] = 0.0005 * z[i] + 0.001 * x[i];
+        by[i] = 0.2 + 0.002 * y[i];
+        bz[i] = 10. + 0.01 * z[i];
+      }
+    }
+};
+
+// tracks starting around z=0 in the structure of arrays layout, with slopes
+// up to maxSlope
+void FillTracks(Int_t n, std::vector<Double_t>& vect, std::vector<Double_t>& charge, Double_t maxSlope = 0.15)
+{
+  TRandom3 random(4357);
+  vect.resize(7 * n);
+  charge.resize(n);
+  for (Int_t i = 0; i < n; i++) {
+    Double_t tx = random.Uniform(-maxSlope, maxSlope);
+    Double_t ty = random.Uniform(-maxSlope, maxSlope);
+    Double_t norm = TMath::Sqrt(tx * tx + ty * ty + 1.);
+    vect[i] = random.Uniform(-10., 10.);
+    vect[n + i] = random.Uniform(-10., 10.);
+    vect[2 * n + i] = 0.;
+    vect[3 * n + i] = tx / norm;
+    vect[4 * n + i] = ty / norm;
+    vect[5 * n + i] = 1. / norm;
+    vect[6 * n + i] = random.Uniform(0.1, 2.);
+    charge[i] = (i % 2) ? 1. : -1.;
+  }
+}
+
+}
+
+TEST(FairRKPropagatorTest, BatchStepMatchesSingleTrack)
+{
+  TestField field;
+  FairRKPropagator propagator(&field);
+  const Int_t n = 101;
+  std::vector<Double_t> vect, charge;
+  FillTracks(n, vect, charge);
+  std::vector<Double_t> step(n), vout(7 * n);
+  for (Int_t i = 0; i < n; i++) {
+    step[i] = 5. + i % 50;
+  }
+
+  propagator.OneStepRungeKuttaBatch(n, &charge[0], &step[0], &vect[0], &vout[0]);
+
+  Double_t in[7], out[7];
+  for (Int_t i = 0; i < n; i++) {
+    for (Int_t k = 0; k < 7; k++) {
+      in[k] = vect[k * n + i];
+    }
+    propagator.OneStepRungeKutta(charge[i], step[i], in, out);
+    for (Int_t k = 0; k < 7; k++) {
+      EXPECT_NEAR(vout[k * n + i], out[k], 1e-10);
+    }
+  }
+}
+
+TEST(FairRKPropagatorTest, BatchToPlaneMatchesSingleTrack)
+{
+  TestField field;
+  FairRKPropagator propagator(&field);
+  const Int_t n = 101;
+  std::vector<Double_t> vect, charge;
+  FillTracks(n, vect, charge);
+  Double_t vec1[3] = {1., 0., 0.};
+  Double_t vec2[3] = {0., 1., 0.};
+  Double_t vec3[3] = {0., 0., 100.};
+
+  std::vector<Double_t> vecRKIn(vect), vecOut(3 * n);
+  propagator.PropagatToPlaneBatch(n, &charge[0], &vecRKIn[0], vec1, vec2, vec3, &vecOut[0]);
+
+  Double_t in[7], out[7];
+  for (Int_t i = 0; i < n; i++) {
+    for (Int_t k = 0; k < 7; k++) {
+      in[k] = vect[k * n + i];
+    }
+    propagator.PropagatToPlane(charge[i], in, vec1, vec2, vec3, out);
+    for (Int_t k = 0; k < 3; k++) {
+      EXPECT_NEAR(vecOut[k * n + i], out[k], 1e-10);
+      EXPECT_NEAR(vecRKIn[k * n + i], in[k], 1e-10);
+    }
+    EXPECT_NEAR(vecOut[2 * n + i], 100., 0.5);
+  }
+}
+
+TEST(FairRKPropagatorTest, BatchToPointMatchesSingleTrack)
+{
+  TestField field;
+  FairRKPropagator propagator(&field);
+  const Int_t n = 101;
+  std::vector<Double_t> vect, charge;
+  // forward tracks, the steps of diff/25 reach the point within 1% of diff
+  FillTracks(n, vect, charge, 0.05);
+  std::vector<Double_t> pos(3 * n);
+  for (Int_t i = 0; i < n; i++) {
+    pos[i] = vect[i];
+    pos[n + i] = vect[n + i];
+    pos[2 * n + i] = 20. + i % 30;
+  }
+
+  std::vector<Double_t> vecRKIn(vect), vecOut(3 * n);
+  propagator.PropagatBatch(n, &charge[0], &vecRKIn[0], &pos[0], &vecOut[0]);
+
+  Double_t in[7], point[3];
+  for (Int_t i = 0; i < n; i++) {
+    for (Int_t k = 0; k < 7; k++) {
+      in[k] = vect[k * n + i];
+    }
+    for (Int_t k = 0; k < 3; k++) {
+      point[k] = pos[k * n + i];
+    }
+    propagator.Propagat(charge[i], in, point);
+    // the last accepted co-ords are the same
+    for (Int_t k = 0; k < 3; k++) {
+      EXPECT_NEAR(vecRKIn[k * n + i], in[k], 1e-10);
+    }
+    EXPECT_NEAR(vecOut[2 * n + i], point[2], 0.01 * point[2]);
+  }
+}
+
+// Benchmark, run with --gtest_also_run_disabled_tests
+TEST(FairRKPropagatorTest, DISABLED_Benchmark)
+{
+  TestField field;
+  FairRKPropagator propagator(&field);
+  const Int_t n = 10000;
+  const Int_t nSteps = 20;
+  std::vector<Double_t> vect, charge;
+  FillTracks(n, vect, charge);
+  std::vector<Double_t> step(n, 10.), vin(vect), vout(7 * n);
+
+  TStopwatch timer;
+  timer.Start();
+  for (Int_t s = 0; s < nSteps; s++) {
+    propagator.OneStepRungeKuttaBatch(n, &charge[0], &step[0], &vin[0], &vout[0]);
+    vin.swap(vout);
+  }
+  timer.Stop();
+  Double_t batchTime = timer.RealTime();
+
+  Double_t in[7], out[7];
+  timer.Start();
+  for (Int_t i = 0; i < n; i++) {
+    for (Int_t k = 0; k < 7; k++) {
+      in[k] = vect[k * n + i];
+    }
+    for (Int_t s = 0; s < nSteps; s++) {
+      propagator.OneStepRungeKutta(charge[i], step[i], in, out);
+      for (Int_t k = 0; k < 7; k++) {
+        in[k] = out[k];
+      }
+    }
+    for (Int_t k = 0; k < 3; k++) {
+      EXPECT_NEAR(vin[k * n + i], in[k], 1e-8);
+    }
+  }
+  timer.Stop();
+  Double_t singleTime = timer.RealTime();
+
+  std::cout << "FairRKPropagator: tracks*steps/s single track " << n * nSteps / singleTime
+            << ", batch " << n * nSteps / batchTime << std::endl;
+}
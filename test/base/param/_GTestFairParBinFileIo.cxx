@@ -0,0 +1,192 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairParAsciiFileIo.h"
+#include "FairParBinFileIo.h"
+#include "FairParGenericSet.h"
+#include "FairParamList.h"
+#include "FairRuntimeDb.h"
+
+#include "TArrayD.h"
+#include "TStopwatch.h"
+#include "TString.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+class TestPar : public FairParGenericSet
+{
+  public:
+    TestPar(const char* name, Int_t nValues = 10)
+      : FairParGenericSet(name, "test parameters", "TestDefaultContext"), fRunValue(0), fValues(nValues) {}
+    virtual void putParams(FairParamList* list) {
+      list->add("RunValue", fRunValue);
+      list->add("Values", fValues);
+    }
+    virtual Bool_t getParams(FairParamList* list) {
+      return list->fill("RunValue", &fRunValue) && list->fill("Values", &fValues);
+    }
+    Int_t fRunValue;
+    TArrayD fValues;
+};
+
+}
+
+TEST(FairParBinFileIoTest, RecordsAreValidUntilTheNextOne)
+{
+  FairRuntimeDb* rtdb = FairRuntimeDb::instance();
+  TestPar* par = new TestPar("TestBinPar");
+  rtdb->addContainer(par);
+
+  FairParBinFileIo* output = new FairParBinFileIo();
+  ASSERT_TRUE(output->open("test_params.bin", "out"));
+  rtdb->setOutput(output);
+  // the value changes with run 102, the container is written for every run
+  for (Int_t run = 100; run < 105; run++) {
+    rtdb->addRun(run);
+    par->fRunValue = run < 102 ? 1 : 2;
+    par->fValues[0] = 0.5 * par->fRunValue;
+    par->setChanged();
+    rtdb->saveOutput();
+  }
+  rtdb->closeOutput();
+  delete output;
+
+  FairParBinFileIo* input = new FairParBinFileIo();
+  ASSERT_TRUE(input->open("test_params.bin", "in"));
+  rtdb->setFirstInput(input);
+
+  EXPECT_FALSE(rtdb->initContainers(99));
+  EXPECT_TRUE(rtdb->initContainers(100));
+  EXPECT_EQ(par->fRunValue, 1);
+  EXPECT_EQ(par->getInputVersion(1), 1);
+  EXPECT_TRUE(rtdb->hasChanged("TestBinPar"));
+  EXPECT_TRUE(rtdb->initContainers(101));
+  EXPECT_FALSE(par->hasChanged());
+  EXPECT_FALSE(rtdb->hasChanged("TestBinPar"));
+  EXPECT_TRUE(rtdb->initContainers(103));
+  EXPECT_TRUE(rtdb->hasChanged("TestBinPar"));
+  EXPECT_EQ(par->fRunValue, 2);
+  EXPECT_DOUBLE_EQ(par->fValues[0], 1.);
+  EXPECT_EQ(par->getInputVersion(1), 2);
+  // the last record stays valid
+  EXPECT_TRUE(rtdb->initContainers(200));
+  EXPECT_EQ(par->fRunValue, 2);
+
+  rtdb->closeFirstInput();
+  delete input;
+  rtdb->removeAllContainers();
+  remove("test_params.bin");
+}
+
+TEST(FairParBinFileIoTest, RejectsIndexOutsideOfFile)
+{
+  FairRuntimeDb* rtdb = FairRuntimeDb::instance();
+  TestPar* par = new TestPar("TestBinPar");
+  rtdb->addContainer(par);
+
+  FairParBinFileIo* output = new FairParBinFileIo();
+  ASSERT_TRUE(output->open("test_params.bin", "out"));
+  rtdb->setOutput(output);
+  rtdb->addRun(300);
+  par->setChanged();
+  rtdb->saveOutput();
+  rtdb->closeOutput();
+  delete output;
+  rtdb->removeAllContainers();
+
+  // the name offset of the first index entry points behind the end of the file
+  // (file header: magic, version, byte order, index offset, ...;
+  // index entry: record offset, record length, name offset, ...)
+  FILE* file = fopen("test_params.bin", "r+b");
+  ASSERT_TRUE(file != NULL);
+  ULong64_t indexOffset = 0;
+  ASSERT_EQ(0, fseek(file, 16, SEEK_SET));
+  ASSERT_EQ(1u, fread(&indexOffset, sizeof(indexOffset), 1, file));
+  ULong64_t nameOffset = 1ULL << 40;
+  ASSERT_EQ(0, fseek(file, indexOffset + 16, SEEK_SET));
+  ASSERT_EQ(1u, fwrite(&nameOffset, sizeof(nameOffset), 1, file));
+  fclose(file);
+
+  FairParBinFileIo input;
+  EXPECT_FALSE(input.open("test_params.bin", "in"));
+  remove("test_params.bin");
+}
+
+// Benchmark, run with --gtest_also_run_disabled_tests
+TEST(FairParBinFileIoTest, DISABLED_StartupTime)
+{
+  // 200 containers with 1000 values each, read from ASCII and binary files
+  const Int_t nContainers = 200;
+  const Int_t nValues = 1000;
+  const Int_t run = 1;
+
+  FairRuntimeDb* rtdb = FairRuntimeDb::instance();
+  std::vector<TestPar*> pars;
+  for (Int_t i = 0; i < nContainers; i++) {
+    pars.push_back(new TestPar(Form("BenchPar%d", i), nValues));
+    rtdb->addContainer(pars.back());
+    pars.back()->fRunValue = i;
+    for (Int_t k = 0; k < nValues; k++) {
+      pars.back()->fValues[k] = 0.5 * k;
+    }
+  }
+
+  rtdb->addRun(run);
+  FairParAsciiFileIo* asciiOutput = new FairParAsciiFileIo();
+  asciiOutput->open("bench_params.par", "out");
+  FairParBinFileIo* binOutput = new FairParBinFileIo();
+  binOutput->open("bench_params.bin", "out");
+  FairParIo* outputs[2] = {asciiOutput, binOutput};
+  for (Int_t i = 0; i < 2; i++) {
+    rtdb->setOutput(outputs[i]);
+    for (Int_t k = 0; k < nContainers; k++) {
+      pars[k]->setChanged();
+    }
+    rtdb->saveOutput();
+    rtdb->closeOutput();
+  }
+
+  FairParAsciiFileIo* asciiInput = new FairParAsciiFileIo();
+  asciiInput->open("bench_params.par", "in");
+  FairParBinFileIo* binInput = new FairParBinFileIo();
+  binInput->open("bench_params.bin", "in");
+  FairParIo* inputs[2] = {asciiInput, binInput};
+  const char* names[2] = {"ASCII", "binary"};
+  for (Int_t i = 0; i < 2; i++) {
+    for (Int_t k = 0; k < nContainers; k++) {
+      pars[k]->fRunValue = -1;
+    }
+    rtdb->setFirstInput(inputs[i]);
+
+    TStopwatch timer;
+    timer.Start();
+    EXPECT_TRUE(rtdb->initContainers(run));
+    timer.Stop();
+    std::cout << "FairParBinFileIo: " << nContainers << " containers initialized from " << names[i]
+              << " file in " << timer.RealTime() << " s" << std::endl;
+
+    for (Int_t k = 0; k < nContainers; k++) {
+      EXPECT_EQ(pars[k]->fRunValue, k);
+      EXPECT_DOUBLE_EQ(pars[k]->fValues[nValues - 1], 0.5 * (nValues - 1));
+    }
+    rtdb->closeFirstInput();
+  }
+
+  delete asciiOutput;
+  delete binOutput;
+  delete asciiInput;
+  delete binInput;
+  rtdb->removeAllContainers();
+  remove("bench_params.par");
+  remove("bench_params.bin");
+}
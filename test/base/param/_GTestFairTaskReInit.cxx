@@ -0,0 +1,132 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairContFact.h"
+#include "FairParBinFileIo.h"
+#include "FairParGenericSet.h"
+#include "FairParamList.h"
+#include "FairRuntimeDb.h"
+#include "FairTask.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+
+namespace {
+
+class TestPar : public FairParGenericSet
+{
+  public:
+    TestPar(const char* name)
+      : FairParGenericSet(name, "test parameters", "TestDefaultContext"), fValue(0) {}
+    virtual void putParams(FairParamList* list) { list->add("Value", fValue); }
+    virtual Bool_t getParams(FairParamList* list) { return list->fill("Value", &fValue); }
+    Int_t fValue;
+};
+
+class TestContFact : public FairContFact
+{
+  public:
+    TestContFact() : FairContFact() {
+      fName = "TestContFact";
+      fTitle = "Factory for the test parameter containers";
+      containers->Add(new FairContainer("ReInitParA", "test parameters", "TestDefaultContext"));
+      containers->Add(new FairContainer("ReInitParB", "test parameters", "TestDefaultContext"));
+      FairRuntimeDb::instance()->addContFactory(this);
+    }
+    virtual FairParSet* createContainer(FairContainer* c) {
+      return new TestPar(c->getConcatName().Data());
+    }
+};
+
+// counts the ReInit calls which had to update anything
+class ParTask : public FairTask
+{
+  public:
+    ParTask(const char* name, const char* parName) : FairTask(name), fParName(parName), fPar(0), fNUpdates(0) {}
+    TestPar* GetPar() const { return fPar; }
+    Int_t GetNUpdates() const { return fNUpdates; }
+  protected:
+    virtual void SetParContainers() {
+      fPar = static_cast<TestPar*>(FairRuntimeDb::instance()->getContainer(fParName));
+    }
+    virtual InitStatus ReInit() {
+      if ( ! ParContainersChanged() ) { return kSUCCESS; }
+      fNUpdates++;
+      return kSUCCESS;
+    }
+  private:
+    const char* fParName;
+    TestPar* fPar;
+    Int_t fNUpdates;
+};
+
+}
+
+TEST(FairTaskReInitTest, ReInitOnlyForChangedContainers)
+{
+  new TestContFact();
+  FairRuntimeDb* rtdb = FairRuntimeDb::instance();
+  ParTask taskA("TaskA", "ReInitParA");
+  ParTask taskB("TaskB", "ReInitParB");
+  taskA.SetParTask();
+  taskB.SetParTask();
+  ASSERT_TRUE(taskA.GetPar() != 0);
+  ASSERT_TRUE(taskB.GetPar() != 0);
+
+  // ReInitParA changes with run 102, ReInitParB is the same for all runs
+  FairParBinFileIo* output = new FairParBinFileIo();
+  ASSERT_TRUE(output->open("test_reinit_params.bin", "out"));
+  rtdb->setOutput(output);
+  for (Int_t run = 100; run < 104; run++) {
+    rtdb->addRun(run);
+    taskA.GetPar()->fValue = run < 102 ? 1 : 2;
+    taskB.GetPar()->fValue = 5;
+    taskA.GetPar()->setChanged();
+    taskB.GetPar()->setChanged();
+    rtdb->saveOutput();
+  }
+  rtdb->closeOutput();
+  delete output;
+
+  FairParBinFileIo* input = new FairParBinFileIo();
+  ASSERT_TRUE(input->open("test_reinit_params.bin", "in"));
+  rtdb->setFirstInput(input);
+
+  // both containers are read for the first run
+  EXPECT_TRUE(rtdb->initContainers(100));
+  taskA.ReInitTask();
+  taskB.ReInitTask();
+  EXPECT_EQ(1, taskA.GetNUpdates());
+  EXPECT_EQ(1, taskB.GetNUpdates());
+
+  // nothing changed, both ReInit return early
+  EXPECT_TRUE(rtdb->initContainers(101));
+  taskA.ReInitTask();
+  taskB.ReInitTask();
+  EXPECT_EQ(1, taskA.GetNUpdates());
+  EXPECT_EQ(1, taskB.GetNUpdates());
+
+  // only the container of task A changed
+  EXPECT_TRUE(rtdb->initContainers(102));
+  taskA.ReInitTask();
+  taskB.ReInitTask();
+  EXPECT_EQ(2, taskA.GetNUpdates());
+  EXPECT_EQ(1, taskB.GetNUpdates());
+  EXPECT_EQ(2, taskA.GetPar()->fValue);
+
+  EXPECT_TRUE(rtdb->initContainers(103));
+  taskA.ReInitTask();
+  taskB.ReInitTask();
+  EXPECT_EQ(2, taskA.GetNUpdates());
+  EXPECT_EQ(1, taskB.GetNUpdates());
+
+  rtdb->closeFirstInput();
+  delete input;
+  rtdb->removeAllContainers();
+  remove("test_reinit_params.bin");
+}
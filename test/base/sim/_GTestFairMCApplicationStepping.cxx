@@ -0,0 +1,126 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             * 
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *  
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairDetector.h"
+#include "FairMCApplication.h"
+#include "FairVolume.h"
+
+#include "FairMockVirtualMC.h"
+
+#include "TGeoManager.h"
+#include "TGeoMaterial.h"
+#include "TGeoMatrix.h"
+#include "TGeoMedium.h"
+#include "TGeoNode.h"
+#include "TGeoVolume.h"
+#include "TStopwatch.h"
+
+#include "gtest/gtest.h"
+
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// Records the volume passed to ProcessHits for each step
+class RecordingDetector : public FairDetector
+{
+  public:
+    RecordingDetector() : FairDetector("Recording", kTRUE), fLastVolume(0), fNHits(0) {}
+
+    virtual Bool_t ProcessHits(FairVolume* v=0) {
+      fLastVolume = v;
+      fNHits++;
+      return kTRUE;
+    }
+    virtual void Register() {}
+    virtual TClonesArray* GetCollection(Int_t) const { return 0; }
+    virtual void Reset() {}
+
+    FairVolume* fLastVolume;
+    Long64_t fNHits;
+};
+
+}
+
+// Checks the sensitive volume dispatch of FairMCApplication::Stepping().
+// Half of the placed volumes are copies of a sensitive volume, the other
+// half is passive. FairMockVirtualMC returns the volume id and copy number
+// of the current node of the TGeoManager.
+TEST(FairMCApplicationStepping, SensitiveVolumeDispatch)
+{
+  const Int_t nCopies = 100;
+  const Int_t nSteps = 1000;
+
+  new TGeoManager("SteppingBench", "Stepping benchmark geometry");
+  TGeoMaterial* vacuum = new TGeoMaterial("vacuum", 0., 0., 0.);
+  TGeoMedium* medium = new TGeoMedium("vacuum", 1, vacuum);
+  TGeoVolume* top = gGeoManager->MakeBox("cave", medium, 1000., 1000., 1000.);
+  gGeoManager->SetTopVolume(top);
+  TGeoVolume* sensor = gGeoManager->MakeBox("sensor", medium, 1., 1., 1.);
+  TGeoVolume* support = gGeoManager->MakeBox("support", medium, 1., 1., 1.);
+  for (Int_t i = 0; i < nCopies; i++) {
+    top->AddNode(sensor, i, new TGeoTranslation(-500. + 5.*i, 0., 0.));
+    top->AddNode(support, i, new TGeoTranslation(-500. + 5.*i, 10., 0.));
+  }
+  gGeoManager->CloseGeometry();
+
+  FairMCApplication application;
+  FairMockVirtualMC mc("SteppingBench");
+  RecordingDetector detector;
+
+  // register the sensitive volume and let the application create the
+  // placed copies as InitGeometry does for a TGeo based MC
+  FairVolume* volume = new FairVolume("sensor", sensor->GetNumber());
+  volume->setMCid(sensor->GetNumber());
+  volume->setCopyNo(0);
+  volume->SetModule(&detector);
+  application.AddSensitiveVolume(volume);
+  application.AddSensitiveVolumeCopies();
+
+  std::vector<FairVolume*> copies(nCopies, static_cast<FairVolume*>(0));
+  TStopwatch timer;
+  timer.Start();
+  for (Int_t k = 0; k < top->GetNdaughters(); k++) {
+    gGeoManager->CdDown(k);
+    TGeoNode* node = gGeoManager->GetCurrentNode();
+    Bool_t isSensor = (node->GetVolume() == sensor);
+    Long64_t nHits = detector.fNHits;
+    for (Int_t i = 0; i < nSteps; i++) {
+      detector.fLastVolume = 0;
+      application.Stepping();
+      if (isSensor) {
+        ASSERT_TRUE(detector.fLastVolume != 0);
+        // every step in a copy goes to the FairVolume of this copy
+        if (copies[node->GetNumber()] == 0) {
+          copies[node->GetNumber()] = detector.fLastVolume;
+        }
+        ASSERT_EQ(copies[node->GetNumber()], detector.fLastVolume);
+        ASSERT_EQ(detector.fLastVolume->getCopyNo(), node->GetNumber());
+        ASSERT_EQ(detector.fLastVolume->getMCid(), sensor->GetNumber());
+      } else {
+        ASSERT_TRUE(detector.fLastVolume == 0);
+      }
+    }
+    EXPECT_EQ(detector.fNHits - nHits, isSensor ? nSteps : 0);
+    gGeoManager->CdUp();
+  }
+  timer.Stop();
+
+  std::cout << "FairMCApplication::Stepping: " << 2LL * nCopies * nSteps << " steps in "
+            << timer.RealTime() << " s" << std::endl;
+
+  // each copy has its own FairVolume
+  for (Int_t i = 0; i < nCopies; i++) {
+    ASSERT_TRUE(copies[i] != 0);
+    for (Int_t j = 0; j < i; j++) {
+      EXPECT_NE(copies[i], copies[j]);
+    }
+  }
+  EXPECT_EQ(copies[0], volume);
+  EXPECT_EQ(detector.fNHits, static_cast<Long64_t>(nCopies) * nSteps);
+}
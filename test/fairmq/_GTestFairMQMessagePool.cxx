@@ -0,0 +1,237 @@
+/********************************************************************************
+ *    Copyright (C) 2014 GSI Helmholtzzentrum fuer Schwerionenforschung GmbH    *
+ *                                                                              *
+ *              This software is distributed under the terms of the             *
+ *         GNU Lesser General Public Licence version 3 (LGPL) version 3,        *
+ *                  copied verbatim in the file "LICENSE"                       *
+ ********************************************************************************/
+#include "FairMQMessagePool.h"
+#include "FairMQTransportFactory.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// message owning a heap buffer like the zeromq message does, calls the free function on release
+class HeapMessage : public FairMQMessage
+{
+  public:
+    HeapMessage() : fData(NULL), fSize(0), fFfn(NULL), fHint(NULL) {}
+    virtual ~HeapMessage() { CloseMessage(); }
+
+    virtual void Rebuild() { CloseMessage(); }
+    virtual void Rebuild(size_t size)
+    {
+        CloseMessage();
+        fData = malloc(size);
+        fSize = size;
+        fFfn = &HeapMessage::Free;
+    }
+    virtual void Rebuild(void* data, size_t size, fairmq_free_fn* ffn = NULL, void* hint = NULL)
+    {
+        CloseMessage();
+        fData = data;
+        fSize = size;
+        fFfn = ffn;
+        fHint = hint;
+    }
+
+    virtual void* GetMessage() { return fData; }
+    virtual void* GetData() { return fData; }
+    virtual size_t GetSize() { return fSize; }
+    virtual void SetMessage(void* data, size_t size) { fData = data; fSize = size; }
+
+    virtual void CloseMessage()
+    {
+        if (fFfn)
+        {
+            fFfn(fData, fHint);
+        }
+        fData = NULL;
+        fSize = 0;
+        fFfn = NULL;
+        fHint = NULL;
+    }
+    virtual void Copy(FairMQMessage* msg) { Rebuild(msg->GetSize()); memcpy(fData, msg->GetData(), fSize); }
+    virtual void Copy(const std::unique_ptr<FairMQMessage>& msg) { Copy(msg.get()); }
+
+  private:
+    static void Free(void* data, void* /*hint*/) { free(data); }
+
+    void* fData;
+    size_t fSize;
+    fairmq_free_fn* fFfn;
+    void* fHint;
+};
+
+class HeapTransportFactory : public FairMQTransportFactory
+{
+  public:
+    virtual FairMQMessage* CreateMessage() { return new HeapMessage(); }
+    virtual FairMQMessage* CreateMessage(size_t size)
+    {
+        HeapMessage* msg = new HeapMessage();
+        msg->Rebuild(size);
+        return msg;
+    }
+    virtual FairMQMessage* CreateMessage(void* data, size_t size, fairmq_free_fn* ffn = NULL, void* hint = NULL)
+    {
+        HeapMessage* msg = new HeapMessage();
+        msg->Rebuild(data, size, ffn, hint);
+        return msg;
+    }
+
+    virtual FairMQSocket* CreateSocket(const std::string&, const std::string&, int) { return NULL; }
+    virtual FairMQPoller* CreatePoller(const std::vector<FairMQChannel>&) { return NULL; }
+    virtual FairMQPoller* CreatePoller(std::unordered_map<std::string, std::vector<FairMQChannel>>&, std::initializer_list<std::string>) { return NULL; }
+    virtual FairMQPoller* CreatePoller(FairMQSocket&, FairMQSocket&) { return NULL; }
+};
+
+// touch every page of the buffer, as a sampler filling the message would
+void Fill(FairMQMessage* msg)
+{
+    char* data = static_cast<char*>(msg->GetData());
+    for (size_t i = 0; i < msg->GetSize(); i += 4096)
+    {
+        data[i] = 1;
+    }
+}
+
+double CreateMessages(FairMQTransportFactory& factory, size_t size, int nMessages, bool pooled)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nMessages; ++i)
+    {
+        std::unique_ptr<FairMQMessage> msg(pooled ? factory.CreatePooledMessage(size) : factory.CreateMessage(size));
+        Fill(msg.get());
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double RebuildMessages(FairMQTransportFactory& factory, size_t size, int nMessages, bool pooled)
+{
+    std::unique_ptr<FairMQMessage> msg(factory.CreateMessage());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nMessages; ++i)
+    {
+        if (pooled)
+        {
+            msg->RebuildPooled(size);
+        }
+        else
+        {
+            msg->Rebuild(size);
+        }
+        Fill(msg.get());
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// messages are destroyed by a second thread, as the zeromq I/O thread releases sent buffers
+double CreateAndReleaseElsewhere(FairMQTransportFactory& factory, size_t size, int nMessages, bool pooled)
+{
+    std::mutex mtx;
+    std::condition_variable cond;
+    std::vector<FairMQMessage*> queue;
+    bool done = false;
+
+    std::thread releaser([&]()
+    {
+        std::vector<FairMQMessage*> batch;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cond.wait(lock, [&]() { return done || !queue.empty(); });
+                if (queue.empty())
+                {
+                    return;
+                }
+                batch.swap(queue);
+            }
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                delete batch[i];
+            }
+            batch.clear();
+        }
+    });
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nMessages; ++i)
+    {
+        FairMQMessage* msg = pooled ? factory.CreatePooledMessage(size) : factory.CreateMessage(size);
+        Fill(msg);
+        std::lock_guard<std::mutex> lock(mtx);
+        queue.push_back(msg);
+        cond.notify_one();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        done = true;
+        cond.notify_one();
+    }
+    releaser.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+TEST(FairMQMessagePoolTest, ReusesReleasedBuffers)
+{
+    HeapTransportFactory factory;
+    FairMQMessagePool& pool = FairMQMessagePool::Instance();
+
+    std::unique_ptr<FairMQMessage> first(factory.CreatePooledMessage(1000));
+    void* data = first->GetData();
+    EXPECT_EQ(first->GetSize(), 1000u);
+    first.reset();
+
+    size_t nReused = pool.GetNReused();
+    std::unique_ptr<FairMQMessage> second(factory.CreatePooledMessage(1024));
+    EXPECT_EQ(second->GetData(), data);
+    EXPECT_EQ(pool.GetNReused(), nReused + 1);
+
+    // the buffer of the previous content goes back to the pool on rebuild
+    second->RebuildPooled(700);
+    EXPECT_NE(second->GetData(), data);
+    EXPECT_EQ(second->GetSize(), 700u);
+    std::unique_ptr<FairMQMessage> third(factory.CreatePooledMessage(600));
+    EXPECT_EQ(third->GetData(), data);
+}
+
+// Benchmark, run with --gtest_also_run_disabled_tests
+TEST(FairMQMessagePoolTest, DISABLED_Benchmark)
+{
+    HeapTransportFactory factory;
+    const size_t sizes[] = { 1024, 64 * 1024, 1024 * 1024, 8 * 1024 * 1024 };
+    const int nMessages = 20000;
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        double create = CreateMessages(factory, sizes[i], nMessages, false);
+        double createPooled = CreateMessages(factory, sizes[i], nMessages, true);
+        double rebuild = RebuildMessages(factory, sizes[i], nMessages, false);
+        double rebuildPooled = RebuildMessages(factory, sizes[i], nMessages, true);
+        double released = CreateAndReleaseElsewhere(factory, sizes[i], nMessages, false);
+        double releasedPooled = CreateAndReleaseElsewhere(factory, sizes[i], nMessages, true);
+
+        std::cout << "FairMQMessagePool: " << nMessages << " messages of " << sizes[i] << " bytes, "
+                  << "CreateMessage " << create / nMessages * 1e9 << " ns, "
+                  << "CreatePooledMessage " << createPooled / nMessages * 1e9 << " ns, "
+                  << "Rebuild " << rebuild / nMessages * 1e9 << " ns, "
+                  << "RebuildPooled " << rebuildPooled / nMessages * 1e9 << " ns, "
+                  << "released by a second thread " << released / nMessages * 1e9 << " ns, "
+                  << "pooled " << releasedPooled / nMessages * 1e9 << " ns per message" << std::endl;
+    }
+}